@@ -1,22 +1,39 @@
 #include "Bullet.h"
 #include "../Manager/AssetManager.h"
+#include "../Manager/EntityManager.h"
+#include "../Library/TriangleBVH.h"
 
 namespace My3dApp
 {
-    Bullet::Bullet(ObjectTag tag, VECTOR pos)
+    Bullet::Bullet(ObjectTag tag, VECTOR pos, VECTOR speed)
         : GameObject(tag, pos)
+        , startSpeed(speed)
     {
         //modelHandle = AssetManager::GetMesh("../Asset/Model/Bullet/");
 
-        speed = VGet(0, 0, 0);
+        // 当たり判定種類を移動する球に設定（1フレームで大きく動いても、通った範囲で当たりを取る）
+        collisionType = CollisionType::SweptSphere;
+        collisionSweep = SweptSphere(VGet(0.0f, 0.0f, 0.0f), 5.0f);
+        collisionSweep.Move(pos);
+        collisionSweep.BeginSweep();
+
+        // 座標と速度はエンティティのシステムで更新する
+        CreateEntity(VelocityBit | ColliderBit);
     }
 
     Bullet::~Bullet()
     {
     }
 
+    void Bullet::OnEntityCreated()
+    {
+        EntityManager::Get<VelocityComponent>(entity).speed = startSpeed;
+    }
+
     void Bullet::Update(float deltaTime)
     {
+        // 前のフレームの判定位置から、このフレームの移動後の位置までを調べる
+        collisionSweep.BeginSweep();
     }
 
     void Bullet::Draw()
@@ -29,4 +46,15 @@ namespace My3dApp
     void Bullet::OnCollisionEnter(const GameObject* other)
     {
     }
+
+    void Bullet::OnSweepHit(const GameObject* other, const MeshRayHit& hit)
+    {
+        // 触れた位置まで戻して消す（相手の先へすり抜けた位置には描かない）
+        pos = hit.position;
+
+        // 当たり判定の更新
+        CollisionUpdate();
+
+        SetAlive(false);
+    }
 }// namespace My3dApp
\ No newline at end of file
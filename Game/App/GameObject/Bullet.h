@@ -4,39 +4,65 @@
 
 namespace My3dApp
 {
-    class Bullet : public GameObject
+    class Bullet final : public GameObject
     {
     private:
-        VECTOR speed;
+        // 生成時の1フレームあたりの移動量（エンティティの生成時に渡す）
+        VECTOR startSpeed;
+
+        /// <summary>
+        /// エンティティが生成されたときの速度の初期化
+        /// </summary>
+        void OnEntityCreated() override;
 
     public:
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
-        /// <param name="tag">IuWFNg̃^O</param>
-        /// <param name="pos">ʒu</param>
-        Bullet(ObjectTag tag, VECTOR pos);
+        /// <param name="tag">オブジェクトのタグ</param>
+        /// <param name="pos">初期位置</param>
+        /// <param name="speed">1フレームあたりの移動量</param>
+        Bullet(ObjectTag tag, VECTOR pos, VECTOR speed = VGet(0.0f, 0.0f, 0.0f));
 
         /// <summary>
-        /// fXgN^
+        /// デストラクタ
         /// </summary<
         ~Bullet();
 
         /// <summary>
-        /// e̍XV
+        /// 弾の更新
         /// </summary>
-        /// <param name="deltaTime">1t[̌oߎ</param>
+        /// <param name="deltaTime">1フレームの経過時間</param>
         void Update(float deltaTime) override;
 
         /// <summary>
-        /// e̕`
+        /// 弾の描画
         /// </summary>
         void Draw() override;
 
         /// <summary>
-        /// ̃IuWFNgƏՓ˂Ƃ̃ANV
+        /// 他のオブジェクトと衝突したときのリアクション
         /// </summary>
-        /// <param name="other">Ƃ͈قȂIuWFNg</param>
+        /// <param name="other">自分とは異なるオブジェクト</param>
         void OnCollisionEnter(const GameObject* other) override;
+
+        /// <summary>
+        /// 移動中に最初に触れた相手へのリアクション
+        /// </summary>
+        /// <param name="other">最初に触れたオブジェクト</param>
+        /// <param name="hit">触れた時刻と、そのときの弾の中心</param>
+        void OnSweepHit(const GameObject* other, const MeshRayHit& hit) override;
+    };
+
+    /// <summary>
+    /// 弾のタグ特性
+    /// </summary>
+    template<> struct ObjectTagTraits<Bullet>
+    {
+        static constexpr unsigned int tagMask = TagBit(ObjectTag::PlayerBullet) | TagBit(ObjectTag::EnemyBullet);
+        static constexpr bool isParallel = true;
+        static constexpr ObjectActivity activity = ObjectActivity::Sleepable;
+        static constexpr bool useLod = false;
+        static constexpr bool isLateUpdate = false;
     };
 }// namespace My3dApp
\ No newline at end of file
@@ -6,7 +6,7 @@
 
 namespace My3dApp
 {
-    // Ĵ΂˂̒萔
+    // カメラのばねの定数
     const float cameraSpringStrength = 2.0f;
 
     Camera::Camera(float height, float z)
@@ -15,6 +15,7 @@ namespace My3dApp
         , lookPos()
         , aimCameraPos()
         , aimLookPos()
+        , playerHandle(InvalidHandle)
         , speed(0.03f)
         , pitch(0.5f)
         , yaw(3.1f)
@@ -27,24 +28,31 @@ namespace My3dApp
 
     Camera::~Camera()
     {
-        // Ȃ
+        // 処理なし
     }
 
     void Camera::Update(float deltaTime)
     {
-        // J̒ڕW_ƁAJ̈ʒuڕW_vZ
-        GameObject* player = GameObjectManager::GetFirstGameObject(ObjectTag::Player);
+        // カメラの注視目標点と、カメラの位置目標点を計算
+        GameObject* player = GameObjectManager::Get(playerHandle);
+
+        // プレイヤーが入れ替わっていたらハンドルを取り直す
+        if (!player)
+        {
+            playerHandle = GameObjectManager::GetFirstHandle(ObjectTag::Player);
+            player = GameObjectManager::Get(playerHandle);
+        }
 
         if (player)
         {
             aimLookPos = player->GetPos();
             aimCameraPos = aimLookPos + cameraOffset;
 
-            // JʒuڕW_ɌxNgvZ
+            // カメラ位置から目標点に向かうベクトルを計算
             VECTOR lookMoveDir = aimLookPos - lookPos;
             VECTOR posMoveDir = aimCameraPos - pos;
 
-            // 
+            // 上
             if (0 < GamePad::GetRightStickY() || CheckHitKey(KEY_INPUT_UP))
             {
                 if (pitch < 1)
@@ -53,7 +61,7 @@ namespace My3dApp
                 }
             }
 
-            // 
+            // 下
             if (GamePad::GetRightStickY() < 0 || CheckHitKey(KEY_INPUT_DOWN))
             {
                 if (pitch > 0)
@@ -62,13 +70,13 @@ namespace My3dApp
                 }
             }
 
-            // 
+            // 左
             if (GamePad::GetRightStickX() < 0 || CheckHitKey(KEY_INPUT_LEFT))
             {
                 yaw += speed;
             }
 
-            // E
+            // 右
             if (0 < GamePad::GetRightStickX() || CheckHitKey(KEY_INPUT_RIGHT))
             {
                 yaw -= speed;
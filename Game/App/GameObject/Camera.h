@@ -5,26 +5,29 @@
 namespace My3dApp
 {
     /// <summary>
-    /// JihNXApFQ[IuWFNgj
+    /// カメラ（派生クラス、継承元：ゲームオブジェクト）
     /// </summary>
-    class Camera : public GameObject
+    class Camera final : public GameObject
     {
     private:
-        // J̍W
+        // カメラの座標
         //VECTOR pos;
 
-        // J̒ړ_
+        // カメラの注目点
         VECTOR lookPos;
 
-        // vC[̑Έʒu
+        // プレイヤーからの相対位置
         VECTOR cameraOffset;
 
-        // J̖ڕWʒu
+        // カメラの目標位置
         VECTOR aimCameraPos;
 
-        // J̒ړ_ڕW
+        // カメラの注目点目標
         VECTOR aimLookPos;
 
+        // 追従するプレイヤーのハンドル
+        GameObjectHandle playerHandle;
+
         float speed;
 
         float yaw;
@@ -33,22 +36,34 @@ namespace My3dApp
 
     public:
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
-        /// <param name="height">J̍</param>
+        /// <param name="height">カメラの高さ</param>
         /// <param name="z"></param>
         Camera(float height, float z);
 
         /// <summary>
-        /// fXgN^
+        /// デストラクタ
         /// </summary>
         ~Camera();
 
         /// <summary>
-        /// J̍XV
+        /// カメラの更新
         /// </summary>
-        /// <param name="deltaTime">1t[̌oߎ</param>
+        /// <param name="deltaTime">1フレームの経過時間</param>
         void Update(float deltaTime) override;
 
     };
+
+    /// <summary>
+    /// カメラのタグ特性
+    /// </summary>
+    template<> struct ObjectTagTraits<Camera>
+    {
+        static constexpr unsigned int tagMask = TagBit(ObjectTag::Camera);
+        static constexpr bool isParallel = false;
+        static constexpr ObjectActivity activity = ObjectActivity::Always;
+        static constexpr bool useLod = false;
+        static constexpr bool isLateUpdate = true;
+    };
 }// namespace My3dApp
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "ObjectTag.h"
+
+namespace My3dApp
+{
+    /// <summary>
+    /// タグごとに当たりを取りたい相手のタグのビットを並べた表（シーンごとに作ってマネージャに設定する）
+    /// どちらかが相手を対象にしている組み合わせだけをブロードフェーズが返し、衝突時の処理は相手を対象にしている側だけ呼ぶ
+    /// </summary>
+    class CollisionMatrix final
+    {
+    private:
+        // タグごとの当たりを取りたい相手のタグのビット
+        unsigned int masks[ObjectTagNum];
+
+    public:
+        /// <summary>
+        /// コンストラクタ（どの組み合わせも当たりを取らない）
+        /// </summary>
+        CollisionMatrix()
+            : masks()
+        {
+        }
+
+        /// <summary>
+        /// 自身が相手との衝突時の処理を受け取るようにする
+        /// </summary>
+        /// <param name="self">処理を受け取るタグ</param>
+        /// <param name="other">相手のタグ</param>
+        /// <returns>続けて設定できるように自身を返す</returns>
+        CollisionMatrix& Enable(ObjectTag self, ObjectTag other)
+        {
+            masks[TagIndex(self)] |= TagBit(other);
+            return *this;
+        }
+
+        /// <summary>
+        /// 両方が互いの衝突時の処理を受け取るようにする
+        /// </summary>
+        /// <param name="a">タグA</param>
+        /// <param name="b">タグB</param>
+        /// <returns>続けて設定できるように自身を返す</returns>
+        CollisionMatrix& EnableBoth(ObjectTag a, ObjectTag b)
+        {
+            return Enable(a, b).Enable(b, a);
+        }
+
+        /// <summary>
+        /// 自身が相手との衝突時の処理を受け取らないようにする
+        /// </summary>
+        /// <param name="self">処理を受け取らなくするタグ</param>
+        /// <param name="other">相手のタグ</param>
+        /// <returns>続けて設定できるように自身を返す</returns>
+        CollisionMatrix& Disable(ObjectTag self, ObjectTag other)
+        {
+            masks[TagIndex(self)] &= ~TagBit(other);
+            return *this;
+        }
+
+        /// <summary>
+        /// 当たりを取りたい相手のタグのビットの取得
+        /// </summary>
+        /// <param name="tagIndex">タグの添字</param>
+        /// <returns>相手のタグのビット</returns>
+        unsigned int GetMask(int tagIndex) const { return masks[tagIndex]; }
+
+        /// <summary>
+        /// 自身が相手との衝突時の処理を受け取るか
+        /// </summary>
+        /// <param name="selfIndex">処理を受け取るタグの添字</param>
+        /// <param name="otherIndex">相手のタグの添字</param>
+        /// <returns>受け取る場合はtrueを返す</returns>
+        bool IsEnabled(int selfIndex, int otherIndex) const { return (masks[selfIndex] & (1u << otherIndex)) != 0; }
+
+        /// <summary>
+        /// 当たり判定に関わるタグのビットの取得（相手として求められているだけのタグも含む）
+        /// </summary>
+        /// <returns>ブロードフェーズに登録するタグのビット</returns>
+        unsigned int GetInvolvedTags() const
+        {
+            unsigned int involvedTags = 0;
+            for (int tagIndex = 0; tagIndex < ObjectTagNum; ++tagIndex)
+            {
+                if (masks[tagIndex])
+                {
+                    involvedTags |= (1u << tagIndex) | masks[tagIndex];
+                }
+            }
+            return involvedTags;
+        }
+    };
+}// namespace My3dApp
\ No newline at end of file
@@ -1,8 +1,10 @@
 #include "Enemy.h"
 #include "../Manager/AssetManager.h"
 #include "../Manager/GameObjectManager.h"
+#include "../Manager/EntityManager.h"
 #include "../Library/AnimationController.h"
 #include "../Library/Calc3D.h"
+#include "../Library/TriangleBVH.h"
 #include "../Library/GamePad.h"
 #include "ObjectTag.h"
 
@@ -17,7 +19,6 @@ namespace My3dApp
         : GameObject(ObjectTag::Enemy, pos)
         , animCtrl(nullptr)
         , animTypeID(0)
-        , isRotate(false)
         , moveCount(10.0f)
         , isMove(false)
         , moveTmp(0)
@@ -26,208 +27,77 @@ namespace My3dApp
 
         MV1SetScale(modelHandle, VGet(0.5f, 0.5f, 0.5f));
 
-        dir = VGet(1, 0, 0);
+        collisionType = CollisionType::Capsule;
 
-        aimDir = dir;
+        collisionCapsule = Capsule(VGet(0.0f, 40.0f, 0.0f), VGet(0.0f, 60.0f, 0.0f), 20.0f);
 
-        speed = VGet(0, 0, 0);
-
-        collisionType = CollisionType::Sphere;
+        collisionLine = LineSegment(VGet(0.0f, 20.0f, 0.0f), VGet(0.0f, -30.0f, 0.0f));
 
-        collisionSphere.localCenter = VGet(0, 50.0f, 0);
+        // 足元の線分で地面に合わせる
+        isGroundSnap = true;
 
-        collisionSphere.radius = 30.0f;
+        // 重なったマップから押し戻す
+        isMeshPushBack = true;
 
-        collisionLine = LineSegment(VGet(0.0f, 20.0f, 0.0f), VGet(0.0f, -30.0f, 0.0f));
+        // 移動と回転はエンティティのシステムでまとめて行う（遠いときは間引いて更新する）
+        CreateEntity(VelocityBit | RotationBit | ColliderBit | ChaseBit | LodBit);
     }
 
     Enemy::~Enemy()
     {
-        // f̃A[h
+        // モデルのアンロード
         AssetManager::ReleaseMesh(modelHandle);
 
-        // Aj[VRg[̍폜
+        // アニメーションコントローラの削除
         delete animCtrl;
     }
 
+    void Enemy::OnEntityCreated()
+    {
+        RotationComponent& rotation = EntityManager::Get<RotationComponent>(entity);
+        rotation.dir = Yaw();
+        rotation.aimDir = rotation.dir;
+
+        ChaseComponent& chase = EntityManager::Get<ChaseComponent>(entity);
+        chase.accel = 100.0f;
+        chase.searchRange = 200.0f;
+    }
+
     void Enemy::Update(float deltaTime)
     {
-        Move(deltaTime);
+        // 追跡中なら走りモーション、そうでなければ歩きモーションへ
+        int nextAnimTypeID = VSquareSize(EntityManager::Get<VelocityComponent>(entity).speed) > 1.0f ? 1 : 0;
 
-        RotateCheck();
+        if (animTypeID != nextAnimTypeID)
+        {
+            animTypeID = nextAnimTypeID;
+            //animCtrl->StartAnimation(animTypeID);
+        }
     }
 
     void Enemy::Draw()
     {
-        // f̕`
+        // モデルの描画
         MV1DrawModel(modelHandle);
 
         DrawCollider();
     }
 
-    void Enemy::OnCollisionEnter(const GameObject* other)
+    void Enemy::OnGroundHit(const MeshRayHit& hit)
     {
-        // ׂIuWFNg̃^O擾
-        ObjectTag tag = other->GetTag();
-
-        // }bvƂ̏Փ
-        if (tag == ObjectTag::Map)
-        {
-            int collModel = other->GetCollisionModel();
-
-            // }bvƎg̋Es̓蔻
-            MV1_COLL_RESULT_POLY_DIM collInfo;
+        // 足元を衝突点に合わせる
+        pos = hit.position;
 
-            // Ăꍇ
-            if (CollisionPair(collisionSphere, collModel, collInfo))
-            {
-                // ߂
-                VECTOR pushBackVec = CalcSpherePushBackVecFromMesh(collisionSphere, collInfo);
-
-                // ߂
-                pos += pushBackVec;
-
-                // 蔻̉
-                MV1CollResultPolyDimTerminate(collInfo);
-
-                // 蔻̍XV
-                CollisionUpdate();
-            }
-
-            // wiƑ蔻
-            MV1_COLL_RESULT_POLY collInfoLine;
-
-            // Ăꍇ
-            if (CollisionPair(collisionLine, collModel, collInfoLine))
-            {
-                // Փ˓_ɍ킹
-                pos = collInfoLine.HitPosition;
-
-                // 蔻̍XV
-                CollisionUpdate();
-            }
-        }
+        // 当たり判定の更新
+        CollisionUpdate();
     }
 
-    void Enemy::Move(float deltaTime)
+    void Enemy::OnPushBack(const VECTOR& pushBackVec)
     {
-        // vC[̎擾
-        GameObject* player = GameObjectManager::GetFirstGameObject(ObjectTag::Player);
-
-        // vC[̍W玩g̍WČxNgvZ
-        VECTOR tmp = player->GetPos() - pos;
-
-        // xNg̖
-        tmp.y = 0;
-
-        // ړpxNg
-        VECTOR inputVec = VGet(0, 0, 0);
+        // 押し戻し
+        pos += pushBackVec;
 
-        // ͂ǂ
-        bool input = false;
-
-        if (abs(tmp.x) < 200.0f)
-        {
-            input = true;
-        }
-
-        if (abs(tmp.z) < 200.0f)
-        {
-            input = true;
-        }
-
-        inputVec += tmp;
-
-        // ͂
-        if (input)
-        {
-            // E㉺Ȃǂœ̓xNg0̂Ƃ
-            if (VSquareSize(inputVec) < 0.5f)
-            {
-                return;
-            }
-
-            // 𐳋K
-            inputVec = VNorm(inputVec);
-
-            // ͕͌݌ĂƈقȂ邩
-            if (IsNearAngle(inputVec, dir))
-            {
-                dir = inputVec;
-            }
-            else
-            {
-                isRotate = true;
-                aimDir = inputVec;
-            }
-
-            speed = inputVec + (inputVec * deltaTime * 100.0f);
-
-            // ̃[V瑖胂[V
-            if (animTypeID != 1)
-            {
-                animTypeID = 1;
-                //animCtrl->StartAnimation(animTypeID);
-            }
-        }
-        else
-        {
-            speed *= 0.9f;
-
-            // ق̃[V[V
-            if (animTypeID != 0)
-            {
-                animTypeID = 0;
-                //animCtrl->StartAnimation(animTypeID);
-            }
-        }
-
-        pos += speed;
-
-        // 3Df̃|WVݒ
-        MV1SetPosition(modelHandle, pos);
-
-        // ɍ킹ăf]
-        MATRIX rotYMat = MGetRotY(180.0f * (float)(DX_PI / 180.0f));
-
-        VECTOR negativeVec = VTransform(dir, rotYMat);
-
-        // fɉ]Zbg
-        MV1SetRotationZYAxis(modelHandle, negativeVec, VGet(0.0f, 1.0f, 0.0f), 0.0f);
-
-        // 蔻胂f̈ʒuXV
+        // 当たり判定の更新
         CollisionUpdate();
     }
-
-    void Enemy::RotateCheck()
-    {
-        if (isRotate)
-        {
-            // ]ڕWpxɏ\߂Ή]I
-            if (IsNearAngle(aimDir, dir))
-            {
-                dir = aimDir;
-                isRotate = false;
-            }
-            else
-            {
-                // ]
-                VECTOR interPolateDir = RotateForAimVecYAxis(dir, aimDir, 10.0f);
-
-                // ]ڕWpx𒴂ĂȂ
-                VECTOR cross1 = VCross(dir, aimDir);
-                VECTOR cross2 = VCross(interPolateDir, aimDir);
-
-                // ڕWpx𒴂I
-                if (cross1.y * cross2.y < 0.0f)
-                {
-                    interPolateDir = aimDir;
-                    isRotate = false;
-                }
-
-                // ڕWxNg10x߂Âpx
-                dir = interPolateDir;
-            }
-        }
-    }
 }// namespace My3dApp
\ No newline at end of file
@@ -5,71 +5,78 @@
 namespace My3dApp
 {
     /// <summary>
-    /// Gl~[ihNXApFQ[IuWFNgj
+    /// エネミー（派生クラス、継承元：ゲームオブジェクト）
     /// </summary>
-    class Enemy : public GameObject
+    class Enemy final : public GameObject
     {
     private:
-        // 
-        VECTOR dir;
-
-        // ڕW
-        VECTOR aimDir;
-
-        // x
-        VECTOR speed;
-
-        // Aj[VǗp
+        // アニメーション管理用
         class AnimationController* animCtrl;
 
-        // Aj[VނID
+        // アニメーション種類のID
         int animTypeID;
 
-        // ]
-        bool isRotate;
-
         float moveCount;
 
         float isMove;
 
         int moveTmp;
 
-        void Move(float deltaTime);
-
-        void RotateCheck();
+        /// <summary>
+        /// エンティティが生成されたときの向きと追跡の初期化
+        /// </summary>
+        void OnEntityCreated() override;
 
     public:
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
         Enemy();
 
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
-        /// <param name="pos">ʒu</param>
+        /// <param name="pos">初期位置</param>
         Enemy(VECTOR pos);
 
         /// <summary>
-        /// fXgN^
+        /// デストラクタ
         /// </summary>
         ~Enemy();
 
         /// <summary>
-        /// Gl~[̍XV
+        /// エネミーの更新
         /// </summary>
-        /// <param name="deltaTime">1t[̌oߎ</param>
+        /// <param name="deltaTime">1フレームの経過時間</param>
         void Update(float deltaTime) override;
 
         /// <summary>
-        /// Gl~[̕`
+        /// エネミーの描画
         /// </summary>
         void Draw() override;
 
         /// <summary>
-        /// ̃IuWFNgƏՓ˂Ƃ̃ANV
+        /// 足元の線分がマップの地面に当たったときのリアクション
         /// </summary>
-        /// <param name="other">Ƃ͈قȂIuWFNg</param>
-        void OnCollisionEnter(const GameObject* other) override;
+        /// <param name="hit">ワールド座標の交点の情報</param>
+        void OnGroundHit(const MeshRayHit& hit) override;
+
+        /// <summary>
+        /// 重なったマップから押し戻されるときのリアクション
+        /// </summary>
+        /// <param name="pushBackVec">押し戻し量</param>
+        void OnPushBack(const VECTOR& pushBackVec) override;
+    };
+
+    /// <summary>
+    /// エネミーのタグ特性
+    /// </summary>
+    template<> struct ObjectTagTraits<Enemy>
+    {
+        static constexpr unsigned int tagMask = TagBit(ObjectTag::Enemy);
+        static constexpr bool isParallel = true;
+        static constexpr ObjectActivity activity = ObjectActivity::Sleepable;
+        static constexpr bool useLod = true;
+        static constexpr bool isLateUpdate = false;
     };
 }// namespace My3dApp
\ No newline at end of file
@@ -1,4 +1,7 @@
 #include "GameObject.h"
+#include "../Manager/EntityManager.h"
+#include "../Manager/GameObjectManager.h"
+#include "../Library/ModelCommandBuffer.h"
 
 namespace My3dApp
 {
@@ -8,7 +11,9 @@ namespace My3dApp
     }
 
     GameObject::GameObject(ObjectTag tag, VECTOR pos)
-        : tag(tag)
+        : pool(nullptr)
+        , handle(InvalidHandle)
+        , tag(tag)
         , modelHandle(-1)
         , isVisible(true)
         , isAlive(true)
@@ -16,40 +21,70 @@ namespace My3dApp
         , collisionLine()
         , collisionSphere()
         , collisionCapsule()
-        , collisionModel()
+        , collisionSweep()
+        , collisionModel(-1)
+        , collisionMesh()
+        , collisionPos()
+        , isCollisionDirty(true)
+        , collisionVersion(0)
+        , isGroundSnap(false)
+        , isMeshPushBack(false)
+        , entity(InvalidEntity)
+        , entityMask(0)
     {
         this->pos = pos;
     }
 
     GameObject::~GameObject()
     {
-        // f̌n
+        // エンティティの削除
+        EntityManager::Destroy(entity);
+
+        // モデルの後始末
         if (modelHandle != -1)
         {
             modelHandle = -1;
         }
     }
 
+    void GameObject::SetAlive(bool set)
+    {
+        // 登録済みのオブジェクトは削除コマンドとして積み、同期点でまとめて消す
+        if (!set && handle.IsValid())
+        {
+            GameObjectManager::Release(this);
+            return;
+        }
+
+        isAlive = set;
+    }
+
     void GameObject::Draw()
     {
-        // Ȃ
+        // 処理なし
     }
 
     void GameObject::DrawCollider()
     {
-        // 蔻̕`
+        // 線分当たり判定の描画
         DrawLine3D(collisionLine.worldStart, collisionLine.worldEnd, GetColor(255, 255, 0));
 
-        // ̓蔻̕`
+        // 球体当たり判定の描画
         DrawSphere3D(collisionSphere.worldCenter, collisionSphere.radius, 10, GetColor(0, 255, 255), GetColor(0, 0, 0), FALSE);
 
-        // JvZ蔻̕`
+        // カプセル当たり判定の描画
         DrawCapsule3D(collisionCapsule.worldStart, collisionCapsule.worldEnd, collisionCapsule.radius, 8, GetColor(255, 0, 255), GetColor(0, 0, 0), FALSE);
 
-        // 蔻胂fꍇ
+        // 移動する球の当たり判定の描画（今の位置だけ）
+        if (collisionType == CollisionType::SweptSphere)
+        {
+            DrawSphere3D(collisionSweep.worldEnd, collisionSweep.radius, 6, GetColor(255, 128, 0), GetColor(0, 0, 0), FALSE);
+        }
+
+        // 当たり判定モデルがある場合
         if (collisionModel != -1)
         {
-            // ɂĕ`悷
+            // 半透明にして描画する
             SetDrawBlendMode(DX_BLENDMODE_ALPHA, 128);
             MV1DrawModel(collisionModel);
             SetDrawBlendMode(DX_BLENDMODE_NOBLEND, 255);
@@ -58,18 +93,141 @@ namespace My3dApp
 
     void GameObject::CollisionUpdate()
     {
+        // 前回合わせた座標から動いていなければ何もしない
+        if (!isCollisionDirty && pos.x == collisionPos.x && pos.y == collisionPos.y && pos.z == collisionPos.z)
+        {
+            return;
+        }
+        collisionPos = pos;
+        isCollisionDirty = false;
+        ++collisionVersion;
+
+        // 押し戻しなどで変わった座標をエンティティに書き戻す
+        if (entity.IsValid())
+        {
+            EntityManager::Get<TransformComponent>(entity).pos = pos;
+        }
+
         collisionSphere.Move(pos);
 
         collisionLine.Move(pos);
 
         collisionCapsule.Move(pos);
 
-        // f̓蔻č\z
+        collisionSweep.Move(pos);
+
+        // メッシュは平行移動だけで、三角形は作り直さない
+        collisionMesh.Move(pos);
+
+        // 当たり判定モデルは描画位置だけ合わせる
         if (collisionModel != -1)
         {
-            MV1SetPosition(collisionModel, pos);
+            ModelCommandBuffer::SetPosition(collisionModel, collisionMesh.worldOrigin);
+        }
+    }
+
+    AABB GameObject::GetCollisionBounds() const
+    {
+        switch (collisionType)
+        {
+        case CollisionType::Line:
+            return CalcAABB(collisionLine);
+
+        case CollisionType::Model:
+            return CalcAABB(collisionMesh);
+
+        case CollisionType::SweptSphere:
+            // 移動の始点から今の位置までに通った範囲を囲む
+            return CalcAABB(collisionSweep);
+
+        default:
+            break;
+        }
+
+        // 足元の線分もメッシュとの判定に使うので一緒に囲む
+        AABB box = collisionType == CollisionType::Capsule ? CalcAABB(collisionCapsule) : CalcAABB(collisionSphere);
+        box.Merge(CalcAABB(collisionLine));
+        return box;
+    }
+
+    void GameObject::CreateEntity(unsigned int mask)
+    {
+        entityMask = TransformBit | mask;
+    }
+
+    void GameObject::BuildEntity()
+    {
+        const unsigned int mask = entityMask;
+        entity = EntityManager::Create(mask);
+
+        EntityManager::Get<TransformComponent>(entity).pos = pos;
+
+        if (mask & ColliderBit)
+        {
+            ColliderComponent& collider = EntityManager::Get<ColliderComponent>(entity);
+            collider.sphere = collisionSphere;
+            collider.line = collisionLine;
+        }
+
+        if (mask & LodBit)
+        {
+            // 最初は毎フレーム更新、更新するフレームはエンティティごとにずらす
+            LodComponent& lod = EntityManager::Get<LodComponent>(entity);
+            lod.interval = 1;
+            lod.phase = static_cast<int>(entity.index & 7);
+            lod.prevPos = pos;
+            lod.renderPos = pos;
+        }
+
+        OnEntityCreated();
+    }
+
+    void GameObject::SyncFromEntity()
+    {
+        pos = EntityManager::Get<TransformComponent>(entity).pos;
+
+        if (EntityManager::HasComponent(entity, ColliderBit))
+        {
+            const ColliderComponent& collider = EntityManager::Get<ColliderComponent>(entity);
+            collisionSphere = collider.sphere;
+            collisionLine = collider.line;
+        }
+
+        collisionCapsule.Move(pos);
+
+        collisionSweep.Move(pos);
+
+        collisionMesh.Move(pos);
+
+        // 当たり判定はエンティティ側で合わせ済み
+        if (pos.x != collisionPos.x || pos.y != collisionPos.y || pos.z != collisionPos.z)
+        {
+            ++collisionVersion;
+        }
+        collisionPos = pos;
+
+        if (modelHandle == -1)
+        {
+            return;
+        }
+
+        // 間引き更新するものは補間した表示位置に置く
+        VECTOR renderPos = pos;
+        if (EntityManager::HasComponent(entity, LodBit))
+        {
+            renderPos = EntityManager::Get<LodComponent>(entity).renderPos;
+        }
+
+        // 3Dモデルのポジション設定（並列更新中はバッファに積まれ、合流後に反映される）
+        ModelCommandBuffer::SetPosition(modelHandle, renderPos);
+
+        if (EntityManager::HasComponent(entity, RotationBit))
+        {
+            // 向きに合わせてモデルを回転（モデルは後ろを向いているので反対の向きを渡す）
+            const VECTOR negativeVec = EntityManager::Get<RotationComponent>(entity).dir.Reversed().ToDirection();
 
-            MV1SetupCollInfo(collisionModel);
+            // モデルに回転をセットする
+            ModelCommandBuffer::SetRotationZYAxis(modelHandle, negativeVec, VGet(0.0f, 1.0f, 0.0f), 0.0f);
         }
     }
 }// namespace My3dApp
\ No newline at end of file
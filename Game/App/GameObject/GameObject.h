@@ -2,169 +2,304 @@
 
 #include "DxLib.h"
 #include "ObjectTag.h"
+#include "GameObjectHandle.h"
 #include "../Library/CollisionType.h"
 #include "../Library/Collision.h"
+#include "../Manager/EntityComponent.h"
 
 namespace My3dApp
 {
     /// <summary>
-    /// Q[IuWFNgiNXj
+    /// ゲームオブジェクト（基底クラス）
     /// </summary>
     class GameObject
     {
+        // プールからの生成・返却はゲームオブジェクトマネージャが行う
+        friend class GameObjectManager;
+
+    private:
+        // 生成元のオブジェクトプール（newで生成された場合はnullptr）
+        class ObjectPool* pool;
+
+        // 自身を指すハンドル（登録時にマネージャが設定する）
+        GameObjectHandle handle;
+
     protected:
-        // ^OiIuWFNg̎ށj
+        // タグ（オブジェクトの種類）
         ObjectTag tag;
 
-        // f
+        // モデル
         int modelHandle;
 
-        // IuWFNg̍W
+        // オブジェクトの座標
         VECTOR pos;
 
-        // W̏ʒu
+        // 座標の初期位置
         VECTOR initPos = VGet(0, 0, 0);
 
-        // 
+        // 可視状態
         bool isVisible;
 
-        // 
+        // 生死状態
         bool isAlive;
 
-        // 蔻̎
+        // 当たり判定の種類
         CollisionType collisionType;
 
-        // 蔻
+        // 線分当たり判定
         LineSegment collisionLine;
 
-        // ̓蔻
+        // 球体当たり判定
         Sphere collisionSphere;
 
-        // JvZ蔻
+        // カプセル当たり判定
         Capsule collisionCapsule;
 
-        // f蔻
+        // 移動する球の当たり判定
+        SweptSphere collisionSweep;
+
+        // モデル当たり判定（当たり判定の描画に使うモデル）
         int collisionModel;
 
-        // 蔻̕`
+        // メッシュ当たり判定
+        MeshCollider collisionMesh;
+
+        // 当たり判定を最後に合わせた座標
+        VECTOR collisionPos;
+
+        // 座標に関係なく次の当たり判定位置の更新で合わせ直すか
+        bool isCollisionDirty;
+
+        // 当たり判定位置を動かした回数（どちらも動いていない組み合わせの判定を省くのに使う）
+        unsigned int collisionVersion;
+
+        // 足元の線分でマップの地面に合わせるか（マネージャーがマップごとにまとめて判定する）
+        bool isGroundSnap;
+
+        // 重なったメッシュから押し戻すか（マネージャーが押し戻し量をワーカースレッドでまとめて求める）
+        bool isMeshPushBack;
+
+        // 座標・速度・向きなどを持つエンティティ（持たない場合は無効）
+        Entity entity;
+
+        // 生成を予約したエンティティのコンポーネントのビット（0なら持たない）
+        unsigned int entityMask;
+
+        // 当たり判定の描画
         void DrawCollider();
 
-        // 蔻ʒu̍XV
+        // 当たり判定位置の更新（前回から動いていなければ何もしない）
         void CollisionUpdate();
 
+        /// <summary>
+        /// エンティティの生成の予約（ワーカースレッドから登録されることもあるので、
+        /// 実際の生成は登録の同期点でメインスレッドが行い、そのときの座標と当たり判定で初期化する）
+        /// </summary>
+        /// <param name="mask">持たせるコンポーネントのビット</param>
+        void CreateEntity(unsigned int mask);
+
+        /// <summary>
+        /// エンティティが生成されたときのコンポーネントの初期化（登録の同期点でメインスレッドから呼ばれる）
+        /// </summary>
+        virtual void OnEntityCreated() {};
+
+    private:
+        /// <summary>
+        /// 予約したエンティティの生成（ゲームオブジェクトマネージャが同期点で呼ぶ）
+        /// </summary>
+        void BuildEntity();
+
     public:
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
-        /// <param name="tag">IuWFNg̃^O</param>
+        /// <param name="tag">オブジェクトのタグ</param>
         GameObject(ObjectTag tag);
 
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
-        /// <param name="tag">IuWFNg̃^O</param>
-        /// <param name="pos">ʒu</param>
+        /// <param name="tag">オブジェクトのタグ</param>
+        /// <param name="pos">初期位置</param>
         GameObject(ObjectTag tag, VECTOR pos);
 
         /// <summary>
-        /// zfXgN^
+        /// 仮想デストラクタ
         /// </summary>
         virtual ~GameObject();
 
         /// <summary>
-        /// Q[IuWFNg̍XViz֐j
+        /// ゲームオブジェクトの更新（純粋仮想関数）
         /// </summary>
-        /// <param name="deltaTime">1t[̌oߎ</param>
+        /// <param name="deltaTime">1フレームの経過時間</param>
         virtual void Update(float deltaTime) = 0;
 
         /// <summary>
-        /// Q[IuWFNg̕`iz֐j
+        /// ゲームオブジェクトの描画（仮想関数）
         /// </summary>
         virtual void Draw();
 
         /// <summary>
-        /// IuWFNg̃^O̎擾
+        /// オブジェクトのタグの取得
         /// </summary>
-        /// <returns>IuWFNgĂ^O</returns>
+        /// <returns>オブジェクトが持っているタグ</returns>
         ObjectTag GetTag() const { return tag; }
 
         /// <summary>
-        /// ʒu̎擾
+        /// ハンドルの取得
         /// </summary>
-        /// <returns>IuWFNǧ݈ʒu</returns>
+        /// <returns>自身を指すハンドル</returns>
+        GameObjectHandle GetHandle() const { return handle; }
+
+        /// <summary>
+        /// 位置の取得
+        /// </summary>
+        /// <returns>オブジェクトの現在位置</returns>
         const VECTOR& GetPos() const { return pos; }
 
         /// <summary>
-        /// ʒu̕ύX
+        /// 位置の変更
         /// </summary>
-        /// <param name="set">ύXʒu</param>
+        /// <param name="set">変更したい位置</param>
         void SetPos(const VECTOR set) { pos = set; }
 
         /// <summary>
-        /// Ԃ̎擾
+        /// 可視状態の取得
         /// </summary>
-        /// <returns>Ȃtrue sȂfalse</returns>
+        /// <returns>可視ならtrue 不可視ならfalse</returns>
         bool GetVisible() const { return isVisible; }
 
         /// <summary>
-        /// Ԃ̕ύX
+        /// 可視状態の変更
         /// </summary>
-        /// <param name="set">ύX</param>
+        /// <param name="set">変更したい状態</param>
         void SetVisible(bool set) { isVisible = set; }
 
         /// <summary>
-        /// Ԃ̎擾
+        /// 生死状態の取得
         /// </summary>
-        /// <returns>Ătrue łfalse</returns>
+        /// <returns>生きていたらtrue 死んでいたらfalse</returns>
         bool GetAlive() const { return isAlive; }
 
         /// <summary>
-        /// Ԃ̕ύX
+        /// 生死状態の変更（falseにすると削除コマンドが積まれる）
+        /// </summary>
+        /// <param name="set">変更したい状態</param>
+        void SetAlive(bool set);
+
+        /// <summary>
+        /// エンティティの取得
+        /// </summary>
+        /// <returns>オブジェクトが持っているエンティティ</returns>
+        Entity GetEntity() const { return entity; }
+
+        /// <summary>
+        /// システムで更新したエンティティの状態をオブジェクトとモデルに反映する
         /// </summary>
-        /// <param name="set">ύX</param>
-        void SetAlive(bool set) { isAlive = set; }
+        void SyncFromEntity();
 
         /// <summary>
-        /// ̃IuWFNgƏՓ˂Ƃ̃ANV
+        /// 他のオブジェクトと触れ始めたときのリアクション（触れている間は最初のフレームだけ呼ばれる）
         /// </summary>
-        /// <param name="other">Ƃ͈قȂIuWFNg</param>
+        /// <param name="other">自分とは異なるオブジェクト</param>
         virtual void OnCollisionEnter(const GameObject* other) {};
 
         /// <summary>
-        /// ̃IuWFNgƂ̓蔻
+        /// 前のフレームから触れ続けている他のオブジェクトへのリアクション（2フレーム目から毎フレーム呼ばれる）
         /// </summary>
-        /// <param name="other">蔻𒲂ׂIuWFNg</param>
+        /// <param name="other">自分とは異なるオブジェクト</param>
+        virtual void OnCollisionStay(const GameObject* other) {};
+
+        /// <summary>
+        /// 触れていた他のオブジェクトと離れたときのリアクション（相手が削除されるときも呼ばれる）
+        /// </summary>
+        /// <param name="other">自分とは異なるオブジェクト（削除される途中の場合もある）</param>
+        virtual void OnCollisionExit(const GameObject* other) {};
+
+        /// <summary>
+        /// 足元の線分がマップの地面に当たったときのリアクション
+        /// </summary>
+        /// <param name="hit">ワールド座標の交点の情報</param>
+        virtual void OnGroundHit(const MeshRayHit& hit) {};
+
+        /// <summary>
+        /// 重なったメッシュから押し戻されるときのリアクション（重なったメッシュごとに呼ばれる）
+        /// </summary>
+        /// <param name="pushBackVec">押し戻し量</param>
+        virtual void OnPushBack(const VECTOR& pushBackVec) {};
+
+        /// <summary>
+        /// 移動する球が移動中に最初に触れた相手へのリアクション（触れた相手のうち最も早いものだけ呼ばれる）
+        /// </summary>
+        /// <param name="other">最初に触れたオブジェクト</param>
+        /// <param name="hit">触れた時刻と、そのときの球の中心のワールド座標・押し返す向き</param>
+        virtual void OnSweepHit(const GameObject* other, const MeshRayHit& hit) {};
+
+        /// <summary>
+        /// このオブジェクトとの当たり判定
+        /// </summary>
+        /// <param name="other">当たり判定を調べたいオブジェクト</param>
         virtual void Collision(GameObject* other) {};
 
         /// <summary>
-        /// 蔻ނ̎擾
+        /// 当たり判定種類の取得
         /// </summary>
-        /// <returns>IuWFNgĂ铖蔻</returns>
+        /// <returns>オブジェクトが持っている当たり判定種類</returns>
         CollisionType GetCollisionType() const { return collisionType; }
 
         /// <summary>
-        /// 蔻̎擾
+        /// 線分当たり判定の取得
         /// </summary>
-        /// <returns>̓蔻</returns>
+        /// <returns>線分の当たり判定</returns>
         LineSegment GetCollisionLine() const { return collisionLine; }
 
         /// <summary>
-        /// ̓蔻̎擾
+        /// 足元の線分でマップの地面に合わせるかの取得
         /// </summary>
-        /// <returns>̂̓蔻</returns>
+        /// <returns>地面に合わせる場合はtrue</returns>
+        bool IsGroundSnap() const { return isGroundSnap; }
+
+        /// <summary>
+        /// 重なったメッシュから押し戻すかの取得
+        /// </summary>
+        /// <returns>押し戻す場合はtrue</returns>
+        bool IsMeshPushBack() const { return isMeshPushBack; }
+
+        /// <summary>
+        /// 球体当たり判定の取得
+        /// </summary>
+        /// <returns>球体の当たり判定</returns>
         Sphere GetCollisionSphere() const { return collisionSphere; }
 
         /// <summary>
-        /// JvZ蔻̎擾
+        /// カプセル当たり判定の取得
         /// </summary>
-        /// <returns>JvZ̓蔻</returns>
+        /// <returns>カプセルの当たり判定</returns>
         Capsule GetCollisionCapsule() const { return collisionCapsule; }
 
         /// <summary>
-        /// f蔻̎擾
+        /// 移動する球の当たり判定の取得
         /// </summary>
-        /// <returns>f̓蔻</returns>
+        /// <returns>移動する球の当たり判定</returns>
+        const SweptSphere& GetCollisionSweep() const { return collisionSweep; }
+
+        /// <summary>
+        /// モデル当たり判定の取得
+        /// </summary>
+        /// <returns>モデルの当たり判定</returns>
         int GetCollisionModel() const { return collisionModel; }
 
+        /// <summary>
+        /// メッシュ当たり判定の取得
+        /// </summary>
+        /// <returns>メッシュ当たり判定（三角形BVHを持たない場合はbvhがnullptr）</returns>
+        const MeshCollider& GetCollisionMesh() const { return collisionMesh; }
+
+        /// <summary>
+        /// ブロードフェーズに登録する境界箱の取得
+        /// </summary>
+        /// <returns>当たり判定の種類に応じた現在の形状を囲むワールド座標の境界箱</returns>
+        AABB GetCollisionBounds() const;
+
     };
 }// namespace My3dApp
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+namespace My3dApp
+{
+    /// <summary>
+    /// ゲームオブジェクトハンドル（管理表の添字と世代）
+    /// </summary>
+    struct GameObjectHandle
+    {
+        // 管理表の添字
+        unsigned int index;
+
+        // 世代（0は無効）
+        unsigned int generation;
+
+        /// <summary>
+        /// 有効な値を持っているかどうか（指す先が生きているかはマネージャで確認する）
+        /// </summary>
+        /// <returns>有効な値ならtrue そうでなければfalse</returns>
+        bool IsValid() const { return generation != 0; }
+
+        bool operator==(const GameObjectHandle& rhs) const { return index == rhs.index && generation == rhs.generation; }
+
+        bool operator!=(const GameObjectHandle& rhs) const { return !(*this == rhs); }
+    };
+
+    // 無効なハンドル
+    constexpr GameObjectHandle InvalidHandle = { 0, 0 };
+}// namespace My3dApp
\ No newline at end of file
@@ -24,33 +24,48 @@ namespace My3dApp
 
     void Map::ModelLoad()
     {
-        // \pf̓ǂݍ
+        // 表示用モデルの読み込み
         modelHandle = AssetManager::GetMesh("../Assets/Model/Map/map.mv1");
 
-        // \f̃XP[O
+        // 表示モデルのスケーリング
         MV1SetScale(modelHandle, VGet(1.0f, 1.0f, 1.0f));
 
-        // \f̈ʒuZbg
+        // 表示モデルの位置セット
         MV1SetPosition(modelHandle, pos);
 
-        // 蔻pf̓ǂݍ
+        // 当たり判定用モデルの読み込み
         collisionModel = AssetManager::GetMesh("../Assets/Model/Map/map.mv1");
 
         MV1SetScale(collisionModel, VGet(1.0f, 1.0f, 1.0f));
 
-        // 蔻胂fɕsxݒ
+        // 当たり判定モデルに不透明度を設定
         MV1SetOpacityRate(collisionModel, 0.3f);
 
-        // \fƓ蔻胂f̈ʒu
-        MV1SetPosition(collisionModel, pos + VGet(-45, 200, -35));
+        // 調理済みの当たり判定ファイルがあれば、割り当てた領域を読み直さずにそのまま使う
+        if (!collisionFile.Open("../Assets/Model/Map/map.mcol", collisionBVH, collisionHeightField))
+        {
+            // 無い場合は当たり判定モデルの三角形から、原点に置いたローカル座標のBVHを1回だけ作る
+            MV1SetPosition(collisionModel, VGet(0.0f, 0.0f, 0.0f));
+            collisionBVH.BuildFromModel(collisionModel);
 
-        // f̓蔻̍č\z
-        MV1SetupCollInfo(collisionModel);
+            // 地面合わせを格子の補間で済ませるため、BVHから高さの格子を1回だけ作る
+            collisionHeightField.Build(collisionBVH, 25.0f);
+        }
+
+        // 表示モデルと当たり判定モデルの位置を微調整
+        collisionMesh = MeshCollider(&collisionBVH, VGet(-45, 200, -35));
+        collisionMesh.heightField = &collisionHeightField;
+
+        // 当たり判定を現在の座標に合わせる（当たり判定モデルの描画位置もここで決まる）
+        CollisionUpdate();
+
+        // 当たり判定はメッシュで行う
+        collisionType = CollisionType::Model;
     }
 
     void Map::Update(float deltaTime)
     {
-        // Ȃ
+        // 処理なし
     }
 
     void Map::Draw()
@@ -1,46 +1,71 @@
 #pragma once
 
 #include "GameObject.h"
+#include "../Library/TriangleBVH.h"
+#include "../Library/HeightField.h"
+#include "../Library/CollisionMeshFile.h"
 
 namespace My3dApp
 {
     /// <summary>
-    /// }bvihNXApFQ[IuWFNgj
+    /// マップ（派生クラス、継承元：ゲームオブジェクト）
     /// </summary>
-    class Map : public GameObject
+    class Map final : public GameObject
     {
+    private:
+        // 調理済みの当たり判定ファイル（割り当てた領域をBVHと高さの格子が指すので、それらより先に宣言する）
+        CollisionMeshFile collisionFile;
+
+        // 当たり判定モデルの三角形から作ったBVH
+        TriangleBVH collisionBVH;
+
+        // 当たり判定モデルの歩ける面から作った地面の高さの格子
+        HeightField collisionHeightField;
+
     public:
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
         Map();
 
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
-        /// <param name="pos">ʒu</param>
+        /// <param name="pos">初期位置</param>
         Map(VECTOR pos);
 
         /// <summary>
-        /// fXgN^
+        /// デストラクタ
         /// </summary>
         ~Map();
 
         /// <summary>
-        /// f̓ǂݍ
+        /// モデルの読み込み
         /// </summary>
         void ModelLoad();
 
         /// <summary>
-        /// }bv̍XV
+        /// マップの更新
         /// </summary>
-        /// <param name="deltaTime">1t[̌oߎ</param>
+        /// <param name="deltaTime">1フレームの経過時間</param>
         void Update(float deltaTime) override;
 
         /// <summary>
-        /// }bv̕`
+        /// マップの描画
         /// </summary>
         void Draw() override;
 
     };
+
+    /// <summary>
+    /// マップのタグ特性
+    /// </summary>
+    template<> struct ObjectTagTraits<Map>
+    {
+        static constexpr unsigned int tagMask = TagBit(ObjectTag::Map);
+        static constexpr bool isParallel = false;
+        static constexpr ObjectActivity activity = ObjectActivity::Static;
+        static constexpr bool useLod = false;
+        static constexpr bool isLateUpdate = false;
+    };
 }// namespace My3dApp
\ No newline at end of file
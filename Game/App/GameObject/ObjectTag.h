@@ -4,7 +4,7 @@
 
 namespace My3dApp
 {
-    // Q[̃AN^[E蔻̎ޕʃ^O
+    // ゲーム内のアクター・当たり判定の種類別タグ
     enum class ObjectTag : unsigned char
     {
         Player,
@@ -24,4 +24,46 @@ namespace My3dApp
         ObjectTag::Map,
         ObjectTag::Camera,
     };
+
+    // タグの総数
+    constexpr static int ObjectTagNum = sizeof(ObjectTagAll) / sizeof(ObjectTagAll[0]);
+
+    /// <summary>
+    /// タグを配列の添字に変換する
+    /// </summary>
+    /// <param name="tag">オブジェクトのタグ</param>
+    /// <returns>タグに対応する添字</returns>
+    constexpr int TagIndex(ObjectTag tag) { return static_cast<int>(tag); }
+
+    /// <summary>
+    /// タグをビットに変換する
+    /// </summary>
+    /// <param name="tag">オブジェクトのタグ</param>
+    /// <returns>タグに対応するビット</returns>
+    constexpr unsigned int TagBit(ObjectTag tag) { return 1u << TagIndex(tag); }
+
+    // オブジェクトの休眠の扱い
+    enum class ObjectActivity : unsigned char
+    {
+        Always,     // 常に活動（休眠しない）
+        Sleepable,  // プレイヤーから遠く止まっていれば休眠する
+        Static,     // 更新不要（常に休眠、描画と当たり判定の相手にはなる）
+    };
+
+    /// <summary>
+    /// 型からタグを引くための特性（各オブジェクトのヘッダで特殊化する）
+    /// tagMask    : その型のオブジェクトが登録されるタグのビット
+    /// isParallel : 並列に更新してよいか（互いに依存しないオブジェクトのみ）
+    /// activity   : 休眠の扱い
+    /// useLod     : プレイヤーからの距離に応じて更新頻度を間引くか（エンティティにLodBitを持たせること）
+    /// isLateUpdate : エンティティのシステムの後に更新するか（システムで動いた後の位置を使うもの）
+    /// tagMaskのタグに登録するオブジェクトは必ずその型であること（違う型は登録時に弾かれる）
+    /// 特殊化した型はゲームオブジェクトマネージャの型の一覧に加える
+    /// </summary>
+    template<class T> struct ObjectTagTraits;
+
+    /// <summary>
+    /// オブジェクトの型の一覧（型ごとの登録・更新・描画を一覧から展開する）
+    /// </summary>
+    template<class... Types> struct ObjectTypeList {};
 }// namespace My3dApp
\ No newline at end of file
@@ -2,7 +2,9 @@
 #include "../Manager/AssetManager.h"
 #include "../Library/AnimationController.h"
 #include "../Manager/GameObjectManager.h"
+#include "../Manager/EntityManager.h"
 #include "../Library/Calc3D.h"
+#include "../Library/TriangleBVH.h"
 #include "../Library/GamePad.h"
 
 namespace My3dApp
@@ -11,169 +13,151 @@ namespace My3dApp
         : GameObject(ObjectTag::Player)
         , animCtrl(nullptr)
         , animTypeID(0)
-        , isRotate(false)
+        , cameraHandle(InvalidHandle)
     {
 
-        // 3Df̓ǂݍ
+        // 3Dモデルの読み込み
         modelHandle = AssetManager::GetMesh("../Assets/Model/test/player.mv1");
 
-        // f̑傫ݒ
+        // モデルの大きさ設定
         MV1SetScale(modelHandle, VGet(0.5f, 0.5f, 0.5f));
 
-        //// Aj[VRg[̐
+        //// アニメーションコントローラの生成
         //animCtrl = new AnimationController(modelHandle);
 
-        //// ҋ@Aj[V̓ǂݍ
+        //// 待機アニメーションの読み込み
         //animCtrl->AddAnimation("../Assets/Model/Player/unityChanAnimIdle.mv1");
 
-        //// sAj[V̓ǂݍ
+        //// 走行アニメーションの読み込み
         //animCtrl->AddAnimation("../Assets/Model/Player/unityChanAnimRun.mv1");
 
-        //// UAj[V̓ǂݍ
+        //// 攻撃アニメーションの読み込み
         //animCtrl->AddAnimation("../Assets/Model/Player/unityChanAnimPunch.mv1");
 
-        //// ĐAj[V̏
+        //// 初期再生アニメーションの初期化
         //animCtrl->StartAnimation(animTypeID);
 
-        // W̏
+        // 座標の初期化
         pos = VGet(0, 0, 0);
 
-        // ̏
-        dir = VGet(1, 0, 0);
+        // 当たり判定種類をカプセルに設定（以前の境界球と同じ高さに収め、横幅は体に合わせて細くする）
+        collisionType = CollisionType::Capsule;
 
-        aimDir = dir;
+        // 芯の始点と終点、半径
+        collisionCapsule = Capsule(VGet(0.0f, 45.0f, 0.0f), VGet(0.0f, 105.0f, 0.0f), 35.0f);
 
-        // x̏
-        speed = VGet(0, 0, 0);
-
-        // 蔻ނ̂ɐݒ
-        collisionType = CollisionType::Sphere;
+        // 線分当たり判定を設定
+        collisionLine = LineSegment(VGet(0.0f, 20.0f, 0.0f), VGet(0.0f, -30.0f, 0.0f));
 
-        // [JZ^[50
-        collisionSphere.localCenter = VGet(0, 75.0f, 0);
+        // 足元の線分で地面に合わせる
+        isGroundSnap = true;
 
-        // a30
-        collisionSphere.radius = 65.0f;
+        // 重なったマップから押し戻す
+        isMeshPushBack = true;
 
-        // 蔻ݒ
-        collisionLine = LineSegment(VGet(0.0f, 20.0f, 0.0f), VGet(0.0f, -30.0f, 0.0f));
+        // 座標・速度・向き・当たり判定をエンティティに持たせる
+        CreateEntity(VelocityBit | RotationBit | ColliderBit);
     }
 
     Player::~Player()
     {
-        // f̃A[h
+        // モデルのアンロード
         AssetManager::ReleaseMesh(modelHandle);
 
-        // Aj[VRg[̍폜
+        // アニメーションコントローラの削除
         delete animCtrl;
     }
 
+    void Player::OnEntityCreated()
+    {
+        // 向きの初期化
+        RotationComponent& rotation = EntityManager::Get<RotationComponent>(entity);
+        rotation.dir = Yaw();
+        rotation.aimDir = rotation.dir;
+    }
+
     void Player::Update(float deltaTime)
     {
         //animCtrl->AddAnimationTime(deltaTime);
 
-        RotateCheck();
-
         Move(deltaTime);
-
-        CollisionUpdate();
     }
 
     void Player::Draw()
     {
-        // 3Df̕`
+        // 3Dモデルの描画
         MV1DrawModel(modelHandle);
 
         DrawCollider();
     }
 
-    void Player::OnCollisionEnter(const GameObject* other)
+    void Player::OnGroundHit(const MeshRayHit& hit)
     {
-        // ׂIuWFNg̃^O擾
-        ObjectTag tag = other->GetTag();
-
-        // }bvƂ̏Փ
-        if (tag == ObjectTag::Map)
-        {
-            int collModel = other->GetCollisionModel();
-
-            // }bvƎg̋EƂ̓蔻
-            MV1_COLL_RESULT_POLY_DIM collInfo;
-
-            // Ăꍇ
-            if (CollisionPair(collisionSphere, collModel, collInfo))
-            {
-                // ߂
-                VECTOR pushBackVec = CalcSpherePushBackVecFromMesh(collisionSphere, collInfo);
-
-                // ߂
-                pos += pushBackVec;
+        // 足元を衝突点に合わせる
+        pos = hit.position;
 
-                // 蔻̉
-                MV1CollResultPolyDimTerminate(collInfo);
-
-                // 蔻̍XV
-                CollisionUpdate();
-            }
+        // 当たり判定の更新
+        CollisionUpdate();
+    }
 
-            // wiƑ蔻
-            MV1_COLL_RESULT_POLY collInfoLine;
+    void Player::OnPushBack(const VECTOR& pushBackVec)
+    {
+        // 押し戻し
+        pos += pushBackVec;
 
-            // Ăꍇ
-            if (CollisionPair(collisionLine, collModel, collInfoLine))
-            {
-                // Փ˓_ɍ킹
-                pos = collInfoLine.HitPosition;
+        // 当たり判定の更新
+        CollisionUpdate();
+    }
 
-                // 蔻̍XV
-                CollisionUpdate();
-            }
-        }
+    void Player::Move(float deltaTime)
+    {
+        // カメラを持ってくる（入れ替わっていたらハンドルを取り直す）
+        GameObject* camera = GameObjectManager::Get(cameraHandle);
 
-        // GƂ̏Փ
-        if (tag == ObjectTag::Enemy)
+        if (!camera)
         {
-            if (CollisionPair(collisionSphere, other->GetCollisionSphere()))
+            cameraHandle = GameObjectManager::GetFirstHandle(ObjectTag::Camera);
+            camera = GameObjectManager::Get(cameraHandle);
+
+            if (!camera)
             {
-                printfDx("Hit!");
+                return;
             }
         }
-    }
-
-    void Player::Move(float deltaTime)
-    {
-        // JĂ
-        GameObject* camera = GameObjectManager::GetFirstGameObject(ObjectTag::Camera);
 
-        // J̐ʕ̈ʒuxNgvZ
+        // カメラの正面方向の位置ベクトルを計算
         VECTOR front = pos - camera->GetPos();
 
         front.y = 0.0f;
 
-        // xNg̐K
+        // ベクトルの正規化
         front = VNorm(front);
 
-        // YxNg
+        // Y軸ベクトル
         VECTOR YAxis = { 0,1,0 };
 
-        // 
+        // 上方向
         VECTOR UP = front;
 
-        // 
+        // 下方向
         VECTOR DOWN = VScale(front, -1.0f);
 
-        // E
+        // 右方向
         VECTOR RIGHT = VCross(YAxis, front);
 
-        // 
+        // 左方向
         VECTOR LEFT = VScale(RIGHT, -1.0f);
 
-        // ړpxNg
+        // 移動用ベクトル
         VECTOR inputVec = VGet(0, 0, 0);
 
-        // ͂ǂ
+        // 入力があったかどうか
         bool input = false;
 
+        // 速度と向き
+        VelocityComponent& velocity = EntityManager::Get<VelocityComponent>(entity);
+        RotationComponent& rotation = EntityManager::Get<RotationComponent>(entity);
+
         if (GamePad::GetInput(Button::UP) || 0 < GamePad::GetLeftStickY() || CheckHitKey(KEY_INPUT_W))
         {
             inputVec += UP;
@@ -198,32 +182,33 @@ namespace My3dApp
             input = true;
         }
 
-        // ͂
+        // 入力があったら
         if (input)
         {
-            // E㉺Ȃǂœ̓xNg0̂Ƃ
+            // 左右上下同時押しなどで入力ベクトルが0のとき
             if (VSquareSize(inputVec) < 0.5f)
             {
+                velocity.speed = VGet(0, 0, 0);
                 return;
             }
 
-            // 𐳋K
+            // 方向を正規化
             inputVec = VNorm(inputVec);
 
-            // ͕͌݌ĂƈقȂ邩
-            if (IsNearAngle(inputVec, dir))
+            // 入力方向は現在向いている方向と異なるか
+            if (IsNearAngle(inputVec, rotation.dir.ToDirection()))
             {
-                dir = inputVec;
+                rotation.dir = Yaw::FromDirection(inputVec);
             }
             else
             {
-                isRotate = true;
-                aimDir = inputVec;
+                rotation.isRotate = true;
+                rotation.aimDir = Yaw::FromDirection(inputVec);
             }
 
-            speed = inputVec + (inputVec * deltaTime * 200.0f);
+            velocity.speed = inputVec + (inputVec * deltaTime * 200.0f);
 
-            // ̃[V瑖胂[V
+            // もし他のモーション中だったら走りモーションへ
             if (animTypeID != 1)
             {
                 animTypeID = 1;
@@ -232,62 +217,14 @@ namespace My3dApp
         }
         else
         {
-            speed *= 0.9f;
+            velocity.speed *= 0.9f;
 
-            // ق̃[V[V
+            // もしほかのモーション中だったら歩きモーションへ
             if (animTypeID != 0)
             {
                 animTypeID = 0;
                 //animCtrl->StartAnimation(animTypeID);
             }
         }
-
-        pos += speed;
-
-        // 3Df̃|WVݒ
-        MV1SetPosition(modelHandle, pos);
-
-        // ɍ킹ăf]
-        MATRIX rotYMat = MGetRotY(180.0f * (float)(DX_PI / 180.0f));
-
-        VECTOR negativeVec = VTransform(dir, rotYMat);
-
-        // fɉ]Zbg
-        MV1SetRotationZYAxis(modelHandle, negativeVec, VGet(0.0f, 1.0f, 0.0f), 0.0f);
-
-        // 蔻胂f̈ʒuXV
-        CollisionUpdate();
-    }
-
-    void Player::RotateCheck()
-    {
-        if (isRotate)
-        {
-            // ]ڕWpxɏ\߂Ή]I
-            if (IsNearAngle(aimDir, dir))
-            {
-                dir = aimDir;
-                isRotate = false;
-            }
-            else
-            {
-                // ]
-                VECTOR interPolateDir = RotateForAimVecYAxis(dir, aimDir, 10.0f);
-
-                // ]ڕWpx𒴂ĂȂ
-                VECTOR cross1 = VCross(dir, aimDir);
-                VECTOR cross2 = VCross(interPolateDir, aimDir);
-
-                // ڕWpx𒴂I
-                if (cross1.y * cross2.y < 0.0f)
-                {
-                    interPolateDir = aimDir;
-                    isRotate = false;
-                }
-
-                // ڕWxNg10x߂Âpx
-                dir = interPolateDir;
-            }
-        }
     }
 }// namespace My3dApp
\ No newline at end of file
@@ -5,67 +5,76 @@
 namespace My3dApp
 {
     /// <summary>
-    /// vC[ihNXApFQ[IuWFNgj
+    /// プレイヤー（派生クラス、継承元：ゲームオブジェクト）
     /// </summary>
-    class Player : public GameObject
+    class Player final : public GameObject
     {
     private:
-        // 
-        VECTOR dir;
-
-        // ڕW
-        VECTOR aimDir;
-
-        // x
-        VECTOR speed;
-
-        // Aj[VǗp
+        // アニメーション管理用
         class AnimationController* animCtrl;
 
-        // Aj[VނID
+        // アニメーション種類のID
         int animTypeID;
 
-        // ]
-        bool isRotate;
+        // 移動の基準にするカメラのハンドル
+        GameObjectHandle cameraHandle;
 
         /// <summary>
-        /// vC[̈ړ
+        /// プレイヤーの移動入力（移動と回転はエンティティのシステムで行う）
         /// </summary>
-        /// <param name="deltaTime">1t[̌oߎ</param>
+        /// <param name="deltaTime">1フレームの経過時間</param>
         void Move(float deltaTime);
 
         /// <summary>
-        /// vC[̉]
+        /// エンティティが生成されたときの向きの初期化
         /// </summary>
-        void RotateCheck();
+        void OnEntityCreated() override;
 
     public:
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
         Player();
 
         /// <summary>
-        /// fXgN^
+        /// デストラクタ
         /// </summary>
         ~Player();
 
         /// <summary>
-        /// vC[̍XV
+        /// プレイヤーの更新
         /// </summary>
-        /// <param name="deltaTime">1t[̌oߎ</param>
+        /// <param name="deltaTime">1フレームの経過時間</param>
         void Update(float deltaTime) override;
 
         /// <summary>
-        /// vC[̕`
+        /// プレイヤーの描画
         /// </summary>
         void Draw() override;
 
         /// <summary>
-        /// ̃IuWFNgƏՓ˂Ƃ̃ANV
+        /// 足元の線分がマップの地面に当たったときのリアクション
+        /// </summary>
+        /// <param name="hit">ワールド座標の交点の情報</param>
+        void OnGroundHit(const MeshRayHit& hit) override;
+
+        /// <summary>
+        /// 重なったマップから押し戻されるときのリアクション
         /// </summary>
-        /// <param name="other">Ƃ͈قȂIuWFNg</param>
-        void OnCollisionEnter(const GameObject* other) override;
+        /// <param name="pushBackVec">押し戻し量</param>
+        void OnPushBack(const VECTOR& pushBackVec) override;
 
     };
+
+    /// <summary>
+    /// プレイヤーのタグ特性
+    /// </summary>
+    template<> struct ObjectTagTraits<Player>
+    {
+        static constexpr unsigned int tagMask = TagBit(ObjectTag::Player);
+        static constexpr bool isParallel = false;
+        static constexpr ObjectActivity activity = ObjectActivity::Always;
+        static constexpr bool useLod = false;
+        static constexpr bool isLateUpdate = false;
+    };
 }// namespace My3dApp
\ No newline at end of file
@@ -0,0 +1,545 @@
+#include "AABBTree.h"
+#include "Calc3D.h"
+#include <algorithm>
+
+namespace My3dApp
+{
+    // 葉の箱を移動方向に広げる倍率（次のフレームも同じ向きに動くと見込む）
+    const float displacementMultiplier = 2.0f;
+
+    // 余裕の箱がこの倍率の余裕を超えて大きくなったら詰め直す
+    const float shrinkMarginRate = 4.0f;
+
+    AABBTree::AABBTree(float fatMargin)
+        : nodes()
+        , root(-1)
+        , freeList(-1)
+        , leafNum(0)
+        , fatMargin(fatMargin)
+        , frame(0)
+        , idToNode()
+        , stack()
+        , pairStack()
+        , rayHits()
+    {
+        // 処理なし
+    }
+
+    int AABBTree::AllocateNode()
+    {
+        int index;
+
+        if (freeList == -1)
+        {
+            index = static_cast<int>(nodes.size());
+            nodes.emplace_back();
+        }
+        else
+        {
+            index = freeList;
+            freeList = nodes[index].parent;
+        }
+
+        Node& node = nodes[index];
+        node.parent = -1;
+        node.child1 = -1;
+        node.child2 = -1;
+        node.height = 0;
+        node.id = -1;
+        node.group = 0;
+        node.mask = 0;
+        node.isStatic = false;
+        node.frame = 0;
+
+        return index;
+    }
+
+    void AABBTree::FreeNode(int index)
+    {
+        nodes[index].parent = freeList;
+        nodes[index].height = -1;
+        freeList = index;
+    }
+
+    AABB AABBTree::CalcFatBox(const AABB& box, const VECTOR& displacement) const
+    {
+        const VECTOR margin = VGet(fatMargin, fatMargin, fatMargin);
+        AABB fatBox(box.minPos - margin, box.maxPos + margin);
+
+        // 動いた向きには先読みして広げる
+        const VECTOR extend = VScale(displacement, displacementMultiplier);
+        (extend.x < 0.0f ? fatBox.minPos.x : fatBox.maxPos.x) += extend.x;
+        (extend.y < 0.0f ? fatBox.minPos.y : fatBox.maxPos.y) += extend.y;
+        (extend.z < 0.0f ? fatBox.minPos.z : fatBox.maxPos.z) += extend.z;
+
+        return fatBox;
+    }
+
+    void AABBTree::UpdateNode(int index)
+    {
+        Node& node = nodes[index];
+        const Node& child1 = nodes[node.child1];
+        const Node& child2 = nodes[node.child2];
+
+        node.box = child1.box;
+        node.box.Merge(child2.box);
+        node.height = 1 + max(child1.height, child2.height);
+        node.group = child1.group | child2.group;
+        node.mask = child1.mask | child2.mask;
+        node.isStatic = child1.isStatic && child2.isStatic;
+    }
+
+    void AABBTree::InsertLeaf(int leaf)
+    {
+        ++leafNum;
+
+        if (root == -1)
+        {
+            root = leaf;
+            nodes[root].parent = -1;
+            return;
+        }
+
+        // 表面積の増加が最も少ない兄弟を探す
+        const AABB leafBox = nodes[leaf].box;
+        int index = root;
+
+        while (!nodes[index].IsLeaf())
+        {
+            const Node& node = nodes[index];
+
+            AABB combined = node.box;
+            combined.Merge(leafBox);
+            const float combinedArea = combined.GetSurfaceArea();
+
+            // ここに新しい親を作る場合と、子に降りる場合に祖先が広がる分
+            const float cost = 2.0f * combinedArea;
+            const float inheritanceCost = 2.0f * (combinedArea - node.box.GetSurfaceArea());
+
+            float childCost[2];
+            const int children[2] = { node.child1, node.child2 };
+
+            for (int i = 0; i < 2; ++i)
+            {
+                const Node& child = nodes[children[i]];
+                AABB childCombined = child.box;
+                childCombined.Merge(leafBox);
+
+                childCost[i] = childCombined.GetSurfaceArea() + inheritanceCost;
+                if (!child.IsLeaf())
+                {
+                    childCost[i] -= child.box.GetSurfaceArea();
+                }
+            }
+
+            if (cost < childCost[0] && cost < childCost[1])
+            {
+                break;
+            }
+
+            index = childCost[0] < childCost[1] ? children[0] : children[1];
+        }
+
+        // 兄弟と葉をまとめる親を作る（確保で配列が伸びるので参照は持たない）
+        const int sibling = index;
+        const int oldParent = nodes[sibling].parent;
+        const int newParent = AllocateNode();
+
+        nodes[newParent].parent = oldParent;
+        nodes[newParent].child1 = sibling;
+        nodes[newParent].child2 = leaf;
+        nodes[sibling].parent = newParent;
+        nodes[leaf].parent = newParent;
+
+        if (oldParent == -1)
+        {
+            root = newParent;
+        }
+        else if (nodes[oldParent].child1 == sibling)
+        {
+            nodes[oldParent].child1 = newParent;
+        }
+        else
+        {
+            nodes[oldParent].child2 = newParent;
+        }
+
+        RefitAncestors(newParent);
+    }
+
+    void AABBTree::RemoveLeaf(int leaf)
+    {
+        --leafNum;
+
+        if (leaf == root)
+        {
+            root = -1;
+            return;
+        }
+
+        // 親を外して兄弟を祖父につなぐ
+        const int parent = nodes[leaf].parent;
+        const int grandParent = nodes[parent].parent;
+        const int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+        nodes[sibling].parent = grandParent;
+        FreeNode(parent);
+
+        if (grandParent == -1)
+        {
+            root = sibling;
+            return;
+        }
+
+        if (nodes[grandParent].child1 == parent)
+        {
+            nodes[grandParent].child1 = sibling;
+        }
+        else
+        {
+            nodes[grandParent].child2 = sibling;
+        }
+
+        RefitAncestors(grandParent);
+    }
+
+    void AABBTree::RefitAncestors(int index)
+    {
+        while (index != -1)
+        {
+            index = Balance(index);
+            UpdateNode(index);
+            index = nodes[index].parent;
+        }
+    }
+
+    int AABBTree::Balance(int indexA)
+    {
+        Node& a = nodes[indexA];
+
+        if (a.IsLeaf() || a.height < 2)
+        {
+            return indexA;
+        }
+
+        const int indexB = a.child1;
+        const int indexC = a.child2;
+        const int balance = nodes[indexC].height - nodes[indexB].height;
+
+        if (-1 <= balance && balance <= 1)
+        {
+            return indexA;
+        }
+
+        // 高いほうの子を持ち上げ、その低いほうの孫をAに渡す
+        const int up = balance > 0 ? indexC : indexB;
+        const int stay = balance > 0 ? indexB : indexC;
+        Node& upNode = nodes[up];
+
+        const int grandChild1 = upNode.child1;
+        const int grandChild2 = upNode.child2;
+        const bool keepFirst = nodes[grandChild2].height < nodes[grandChild1].height;
+        const int keep = keepFirst ? grandChild1 : grandChild2;
+        const int move = keepFirst ? grandChild2 : grandChild1;
+
+        // 持ち上げた子をAの位置につなぐ
+        upNode.parent = a.parent;
+        if (upNode.parent == -1)
+        {
+            root = up;
+        }
+        else if (nodes[upNode.parent].child1 == indexA)
+        {
+            nodes[upNode.parent].child1 = up;
+        }
+        else
+        {
+            nodes[upNode.parent].child2 = up;
+        }
+
+        upNode.child1 = indexA;
+        upNode.child2 = keep;
+        a.parent = up;
+
+        a.child1 = stay;
+        a.child2 = move;
+        nodes[move].parent = indexA;
+
+        UpdateNode(indexA);
+        UpdateNode(up);
+
+        return up;
+    }
+
+    void AABBTree::Clear()
+    {
+        nodes.clear();
+        root = -1;
+        freeList = -1;
+        leafNum = 0;
+        idToNode.clear();
+    }
+
+    void AABBTree::SetArena(MemoryArena* arena)
+    {
+        RebindArena(nodes, arena);
+        RebindArena(idToNode, arena);
+        RebindArena(stack, arena);
+        RebindArena(pairStack, arena);
+        RebindArena(rayHits, arena);
+    }
+
+    void AABBTree::BeginFrame()
+    {
+        ++frame;
+    }
+
+    void AABBTree::SetProxy(int id, const AABB& box, unsigned int group, unsigned int mask, bool isStatic)
+    {
+        if (static_cast<int>(idToNode.size()) <= id)
+        {
+            idToNode.resize(id + 1, -1);
+        }
+
+        int leaf = idToNode[id];
+
+        if (leaf == -1)
+        {
+            // 初めての番号は新しい葉として挿入する
+            leaf = AllocateNode();
+            nodes[leaf].box = CalcFatBox(box, VGet(0, 0, 0));
+            nodes[leaf].tightBox = box;
+            nodes[leaf].id = id;
+            nodes[leaf].group = group;
+            nodes[leaf].mask = mask;
+            nodes[leaf].isStatic = isStatic;
+            nodes[leaf].frame = frame;
+            InsertLeaf(leaf);
+            idToNode[id] = leaf;
+            return;
+        }
+
+        Node& node = nodes[leaf];
+        node.frame = frame;
+
+        // 余裕の箱からはみ出したか、余裕が大きく残りすぎたときだけ付け直す
+        const float shrinkMargin = fatMargin * shrinkMarginRate;
+        const AABB shrinkBox(box.minPos - VGet(shrinkMargin, shrinkMargin, shrinkMargin), box.maxPos + VGet(shrinkMargin, shrinkMargin, shrinkMargin));
+
+        if (!node.box.Contains(box) || !shrinkBox.Contains(node.box))
+        {
+            const VECTOR displacement = VScale((box.minPos + box.maxPos) - (node.tightBox.minPos + node.tightBox.maxPos), 0.5f);
+
+            RemoveLeaf(leaf);
+            nodes[leaf].box = CalcFatBox(box, displacement);
+            nodes[leaf].tightBox = box;
+            nodes[leaf].group = group;
+            nodes[leaf].mask = mask;
+            nodes[leaf].isStatic = isStatic;
+            InsertLeaf(leaf);
+            return;
+        }
+
+        node.tightBox = box;
+
+        // 番号の使い回しや休眠の切り替えで祖先にまとめた情報が変わる場合は詰め直す
+        if (node.group != group || node.mask != mask || node.isStatic != isStatic)
+        {
+            node.group = group;
+            node.mask = mask;
+            node.isStatic = isStatic;
+
+            if (node.parent != -1)
+            {
+                RefitAncestors(node.parent);
+            }
+        }
+    }
+
+    void AABBTree::EndFrame()
+    {
+        // 今回登録されなかった番号の葉を外す
+        for (auto& leaf : idToNode)
+        {
+            if (leaf != -1 && nodes[leaf].frame != frame)
+            {
+                RemoveLeaf(leaf);
+                FreeNode(leaf);
+                leaf = -1;
+            }
+        }
+    }
+
+    bool AABBTree::IsPairCandidate(int indexA, int indexB) const
+    {
+        const Node& a = nodes[indexA];
+        const Node& b = nodes[indexB];
+
+        // 動かないもの同士、どちらも相手を対象にしていないもの、重ならないものはまとめて飛ばす
+        if (a.isStatic && b.isStatic)
+        {
+            return false;
+        }
+
+        if (!(a.group & b.mask) && !(b.group & a.mask))
+        {
+            return false;
+        }
+
+        return CollisionPair(a.box, b.box);
+    }
+
+    void AABBTree::FindPairs(ArenaVector<pair<int, int>>& pairs)
+    {
+        if (root == -1)
+        {
+            return;
+        }
+
+        // 同じ節の組は子の中同士と子同士に分け、異なる節の組は大きいほうを子に分けていく
+        // 候補にならない組は積む前に落とす
+        pairStack.clear();
+        pairStack.emplace_back(root, root);
+
+        while (!pairStack.empty())
+        {
+            const int indexA = pairStack.back().first;
+            const int indexB = pairStack.back().second;
+            pairStack.pop_back();
+
+            const Node& a = nodes[indexA];
+
+            if (indexA == indexB)
+            {
+                if (!a.IsLeaf() && !a.isStatic)
+                {
+                    pairStack.emplace_back(a.child1, a.child1);
+                    pairStack.emplace_back(a.child2, a.child2);
+
+                    if (IsPairCandidate(a.child1, a.child2))
+                    {
+                        pairStack.emplace_back(a.child1, a.child2);
+                    }
+                }
+                continue;
+            }
+
+            const Node& b = nodes[indexB];
+
+            if (a.IsLeaf() && b.IsLeaf())
+            {
+                if (CollisionPair(a.tightBox, b.tightBox))
+                {
+                    pairs.emplace_back(a.id, b.id);
+                }
+                continue;
+            }
+
+            // 葉でないほうか、葉でなければ高いほうを子に分ける
+            if (b.IsLeaf() || (!a.IsLeaf() && b.height <= a.height))
+            {
+                const int child1 = a.child1;
+                const int child2 = a.child2;
+
+                if (IsPairCandidate(child1, indexB))
+                {
+                    pairStack.emplace_back(child1, indexB);
+                }
+                if (IsPairCandidate(child2, indexB))
+                {
+                    pairStack.emplace_back(child2, indexB);
+                }
+            }
+            else
+            {
+                const int child1 = b.child1;
+                const int child2 = b.child2;
+
+                if (IsPairCandidate(indexA, child1))
+                {
+                    pairStack.emplace_back(indexA, child1);
+                }
+                if (IsPairCandidate(indexA, child2))
+                {
+                    pairStack.emplace_back(indexA, child2);
+                }
+            }
+        }
+    }
+
+    void AABBTree::QueryOverlap(const AABB& box, unsigned int groupMask, ArenaVector<int>& ids)
+    {
+        if (root == -1)
+        {
+            return;
+        }
+
+        stack.clear();
+        stack.push_back(root);
+
+        while (!stack.empty())
+        {
+            const Node& node = nodes[stack.back()];
+            stack.pop_back();
+
+            if (!(node.group & groupMask) || !CollisionPair(node.box, box))
+            {
+                continue;
+            }
+
+            if (!node.IsLeaf())
+            {
+                stack.push_back(node.child1);
+                stack.push_back(node.child2);
+            }
+            else if (CollisionPair(node.tightBox, box))
+            {
+                ids.push_back(node.id);
+            }
+        }
+    }
+
+    void AABBTree::QueryRay(const VECTOR& start, const VECTOR& end, unsigned int groupMask, ArenaVector<int>& ids)
+    {
+        if (root == -1)
+        {
+            return;
+        }
+
+        const VECTOR invDir = CalcInvDir(start, end);
+        rayHits.clear();
+
+        stack.clear();
+        stack.push_back(root);
+
+        while (!stack.empty())
+        {
+            const Node& node = nodes[stack.back()];
+            stack.pop_back();
+
+            float hitRate;
+
+            if (!(node.group & groupMask) || !RaycastBox(start, invDir, node.box, hitRate))
+            {
+                continue;
+            }
+
+            if (!node.IsLeaf())
+            {
+                stack.push_back(node.child1);
+                stack.push_back(node.child2);
+            }
+            else if (RaycastBox(start, invDir, node.tightBox, hitRate))
+            {
+                rayHits.emplace_back(hitRate, node.id);
+            }
+        }
+
+        sort(rayHits.begin(), rayHits.end());
+
+        for (auto& hit : rayHits)
+        {
+            ids.push_back(hit.second);
+        }
+    }
+}// namespace My3dApp
\ No newline at end of file
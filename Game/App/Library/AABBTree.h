@@ -0,0 +1,227 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include "DxLib.h"
+#include "Broadphase.h"
+
+using namespace std;
+
+namespace My3dApp
+{
+    /// <summary>
+    /// 動的な境界箱の木によるブロードフェーズ
+    /// 葉は実際の境界箱より余裕を持たせた箱で登録し、はみ出したときだけ付け直す
+    /// 付け直しのたびに祖先の箱を詰め直し、左右の高さが偏った節は回転して釣り合わせる
+    /// </summary>
+    class AABBTree final : public Broadphase
+    {
+    private:
+        /// <summary>
+        /// 木の節（子を持たない節が葉で、1つの境界箱に対応する）
+        /// </summary>
+        struct Node
+        {
+            // 葉は余裕を持たせた箱、それ以外は子を囲む箱
+            AABB box;
+
+            // 子の節（葉は-1）
+            int child1;
+            int child2;
+
+            // 属するグループのビット（葉以外は子孫をまとめたもの）
+            unsigned int group;
+
+            // 当たりを取りたい相手のグループのビット（葉以外は子孫をまとめたもの）
+            unsigned int mask;
+
+            // 動かないか（葉以外は子孫がすべて動かないか）
+            bool isStatic;
+
+            // 葉からの高さ（葉は0、未使用の節は-1）
+            int height;
+
+            // ここまでが木をたどるときに読む部分（1つのキャッシュラインに収める）
+
+            // 葉の実際の境界箱
+            AABB tightBox;
+
+            // 親の節（未使用の節では次の未使用の節）
+            int parent;
+
+            // 呼び出し側の番号（葉のみ）
+            int id;
+
+            // 最後に登録されたフレーム（葉のみ）
+            unsigned int frame;
+
+            /// <summary>
+            /// 葉かどうか
+            /// </summary>
+            /// <returns>葉ならtrue</returns>
+            bool IsLeaf() const { return child1 == -1; }
+        };
+
+        // 節の配列（添字で参照し合う）
+        ArenaVector<Node> nodes;
+
+        // 根の節（空なら-1）
+        int root;
+
+        // 未使用の節の先頭（未使用の節はparentでつなぐ）
+        int freeList;
+
+        // 葉の数
+        int leafNum;
+
+        // 葉の箱に持たせる余裕
+        float fatMargin;
+
+        // 登録のフレーム番号
+        unsigned int frame;
+
+        // 呼び出し側の番号から葉を引く表（登録のない番号は-1）
+        ArenaVector<int> idToNode;
+
+        // 木をたどるときの作業領域
+        ArenaVector<int> stack;
+
+        // 組み合わせを探すときの節の組の作業領域
+        ArenaVector<pair<int, int>> pairStack;
+
+        // 線分検索の作業領域（入る位置の割合と番号）
+        ArenaVector<pair<float, int>> rayHits;
+
+        /// <summary>
+        /// 節の確保
+        /// </summary>
+        /// <returns>確保した節の添字</returns>
+        int AllocateNode();
+
+        /// <summary>
+        /// 節を未使用に戻す
+        /// </summary>
+        /// <param name="index">節の添字</param>
+        void FreeNode(int index);
+
+        /// <summary>
+        /// 葉を表面積が最も増えない位置に挿入する
+        /// </summary>
+        /// <param name="leaf">葉の添字</param>
+        void InsertLeaf(int leaf);
+
+        /// <summary>
+        /// 葉を木から外す（葉自体は残す）
+        /// </summary>
+        /// <param name="leaf">葉の添字</param>
+        void RemoveLeaf(int leaf);
+
+        /// <summary>
+        /// 子から箱、高さ、グループ、動かないかをまとめ直す
+        /// </summary>
+        /// <param name="index">節の添字</param>
+        void UpdateNode(int index);
+
+        /// <summary>
+        /// 節から根までまとめ直し、偏った節を回転させる
+        /// </summary>
+        /// <param name="index">開始する節の添字</param>
+        void RefitAncestors(int index);
+
+        /// <summary>
+        /// 左右の高さが2以上違う節を回転させる
+        /// </summary>
+        /// <param name="index">節の添字</param>
+        /// <returns>回転後にその位置に来た節の添字</returns>
+        int Balance(int index);
+
+        /// <summary>
+        /// 節の組が組み合わせの候補になりうるか（動かないもの同士、対象外のグループ同士、重ならないものを除く）
+        /// </summary>
+        /// <param name="indexA">節Aの添字</param>
+        /// <param name="indexB">節Bの添字</param>
+        /// <returns>候補になりうる場合はtrue</returns>
+        bool IsPairCandidate(int indexA, int indexB) const;
+
+        /// <summary>
+        /// 実際の境界箱に余裕と移動量の先読みを加えた箱の計算
+        /// </summary>
+        /// <param name="box">実際の境界箱</param>
+        /// <param name="displacement">前回からの移動量</param>
+        /// <returns>葉に登録する箱</returns>
+        AABB CalcFatBox(const AABB& box, const VECTOR& displacement) const;
+
+    public:
+        /// <summary>
+        /// コンストラクタ
+        /// </summary>
+        /// <param name="fatMargin">葉の箱に持たせる余裕（数フレーム分の移動量程度）</param>
+        AABBTree(float fatMargin);
+
+        /// <summary>
+        /// 登録されたすべての境界箱の削除
+        /// </summary>
+        void Clear() override;
+
+        /// <summary>
+        /// 登録と作業領域の確保元の変更
+        /// </summary>
+        /// <param name="arena">確保元のアリーナ（nullptrならヒープ）</param>
+        void SetArena(MemoryArena* arena) override;
+
+        /// <summary>
+        /// 1フレーム分の登録の開始
+        /// </summary>
+        void BeginFrame() override;
+
+        /// <summary>
+        /// 境界箱の登録（登録済みの番号は移動として扱い、余裕の箱からはみ出したときだけ付け直す）
+        /// </summary>
+        /// <param name="id">呼び出し側の番号</param>
+        /// <param name="box">ワールド座標の境界箱</param>
+        /// <param name="group">自身の属するグループのビット</param>
+        /// <param name="mask">当たりを取りたい相手のグループのビット</param>
+        /// <param name="isStatic">動かないか</param>
+        void SetProxy(int id, const AABB& box, unsigned int group, unsigned int mask, bool isStatic) override;
+
+        /// <summary>
+        /// 1フレーム分の登録の終了（今回登録されなかった葉を外す）
+        /// </summary>
+        void EndFrame() override;
+
+        /// <summary>
+        /// 境界箱が重なっている組み合わせの列挙（木同士を同時にたどり、重ならない部分木の組をまとめて飛ばす）
+        /// </summary>
+        /// <param name="pairs">見つかった組み合わせの番号（呼び出し側の配列に追加する）</param>
+        void FindPairs(ArenaVector<pair<int, int>>& pairs) override;
+
+        /// <summary>
+        /// 範囲と重なる境界箱の検索
+        /// </summary>
+        /// <param name="box">調べる範囲</param>
+        /// <param name="groupMask">対象にするグループのビット</param>
+        /// <param name="ids">見つかった番号（呼び出し側の配列に追加する）</param>
+        void QueryOverlap(const AABB& box, unsigned int groupMask, ArenaVector<int>& ids) override;
+
+        /// <summary>
+        /// 線分と交差する境界箱の検索
+        /// </summary>
+        /// <param name="start">線分の始点</param>
+        /// <param name="end">線分の終点</param>
+        /// <param name="groupMask">対象にするグループのビット</param>
+        /// <param name="ids">見つかった番号（始点に近い順に、呼び出し側の配列に追加する）</param>
+        void QueryRay(const VECTOR& start, const VECTOR& end, unsigned int groupMask, ArenaVector<int>& ids) override;
+
+        /// <summary>
+        /// 登録された境界箱の数の取得
+        /// </summary>
+        /// <returns>登録された境界箱の数</returns>
+        int GetProxyNum() const override { return leafNum; }
+
+        /// <summary>
+        /// 木の高さの取得
+        /// </summary>
+        /// <returns>根の高さ（空なら0）</returns>
+        int GetHeight() const { return root == -1 ? 0 : nodes[root].height; }
+    };
+}// namespace My3dApp
\ No newline at end of file
@@ -22,7 +22,7 @@ namespace My3dApp
         anim.animationPlayFps = fps;
         anim.isLoopAnimation = isLoop;
 
-        // Aj[Vf[^ǂݍ
+        // アニメーションデータ読み込み
         anim.animationHandle = AssetManager::GetAnimation(fileName.c_str());
         if (anim.animationHandle == -1)
         {
@@ -33,14 +33,14 @@ namespace My3dApp
         attachedIndex = MV1AttachAnim(modelHandle, anim.animationIndex, anim.animationHandle, TRUE);
         anim.animationTotalTime = MV1GetAnimTotalTime(anim.animationHandle, anim.animationIndex);
 
-        // Aj[V
+        // アニメーション解除
         int test;
         test = MV1DetachAnim(modelHandle, attachedIndex);
 
-        // ɃAj[Vf[^ǉ
+        // 末尾にアニメーションデータ追加
         animDatas.push_back(anim);
 
-        // vectorɓYԍԂ
+        // vectorに入る添え字番号を返す
         return static_cast<int>(animDatas.size() - 1);
     }
 
@@ -48,7 +48,7 @@ namespace My3dApp
     {
         nowAnimTime += deltaTime * animDatas[nowAnimTypeNum].animationPlayFps;
 
-        // [vĐ
+        // ループ再生
         if (animDatas[nowAnimTypeNum].isLoopAnimation && nowAnimTime > animDatas[nowAnimTypeNum].animationTotalTime)
         {
             nowAnimTime = 0.0f;
@@ -60,7 +60,7 @@ namespace My3dApp
 
     void AnimationController::StartAnimation(int id)
     {
-        // ȑOƈႤAj[Vxf^b`
+        // 以前と違うアニメーションが来たら一度デタッチ
         if (id != nowAnimTypeNum)
         {
             if (nowAnimTypeNum != -1)
@@ -68,7 +68,7 @@ namespace My3dApp
                 MV1DetachAnim(modelHandle, attachedIndex);
             }
 
-            // VKAj[VZbg
+            // 新規アニメーションをセット
             nowAnimTypeNum = id;
             attachedIndex = MV1AttachAnim(modelHandle, animDatas[id].animationIndex, 
                 animDatas[nowAnimTypeNum].animationHandle, TRUE);
@@ -8,89 +8,89 @@ namespace My3dApp
     class AnimationController final
     {
     public:
-        // Aj[Vpf[^\ Aj[V1
+        // アニメーション用データ構造体 アニメーション1個分
         struct AnimData
         {
         public:
             /// <summary>
-            /// RXgN^
+            /// コンストラクタ
             /// </summary>
             AnimData();
 
-            // Aj[Vnh
+            // アニメーションハンドル
             int animationHandle;
 
-            // A^b`Aj[Vԍ
+            // アタッチするアニメーション番号
             int animationIndex;
 
-            // Aj[V̑Đ
+            // アニメーションの総再生時間
             float animationTotalTime;
 
-            // Aj[VĐx
+            // アニメーション再生速度
             float animationPlayFps;
 
-            // [vĐ邩ǂ
+            // ループ再生を許可するかどうか
             bool isLoopAnimation;
         };
 
     private:
-        // Ƃ̃fnh
+        // おおもとのモデルハンドル
         int modelHandle;
 
-        // ۑpxN^[
+        // 保存用ベクター
         std::vector<AnimData> animDatas;
 
-        // Đ̃Aj[VID
+        // 再生中のアニメーションID
         int nowAnimTypeNum;
 
-        // t̃CfbNX
+        // 取付後のインデックス
         int attachedIndex;
 
-        // Đ̃Aj[V
+        // 再生中のアニメーション時刻
         float nowAnimTime;
 
     public:
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
-        /// <param name="handle">Aj[VKp郂fnh</param>
+        /// <param name="handle">アニメーションを適用するモデルハンドル</param>
         AnimationController(int handle);
 
         /// <summary>
-        /// fXgN^
+        /// デストラクタ
         /// </summary>
         ~AnimationController();
 
         /// <summary>
-        /// Aj[V̒ǉ
+        /// アニメーションの追加
         /// </summary>
-        /// <param name="fileName">t@C܂ł̃pX</param>
+        /// <param name="fileName">ファイルまでのパス</param>
         /// <param name="fps"></param>
-        /// <param name="isLoop">[v邩ǂ</param>
+        /// <param name="isLoop">ループするかどうか</param>
         /// <returns></returns>
         int AddAnimation(std::string fileName, float fps = 30.0f, bool isLoop = true);
 
         /// <summary>
-        /// Aj[V̎Ԃ̃Zbg
+        /// アニメーションの時間のセット
         /// </summary>
-        /// <param name="deltaTime">1t[̌oߎ</param>
+        /// <param name="deltaTime">1フレームの経過時間</param>
         void AddAnimationTime(float deltaTime);
 
         /// <summary>
-        /// Aj[V̍Đ
+        /// アニメーションの再生
         /// </summary>
-        /// <param name="id">ĐAj[Vid</param>
+        /// <param name="id">再生したいアニメーションid</param>
         void StartAnimation(int id);
 
         /// <summary>
-        /// Aj[V̒~
+        /// アニメーションの停止
         /// </summary>
         void StopAnimation();
 
         /// <summary>
-        /// Đǂ
+        /// 再生中かどうか
         /// </summary>
-        /// <returns>ĐȂtrue ~Ȃfalse</returns>
+        /// <returns>再生中ならtrue 停止中ならfalse</returns>
         bool IsPlaying();
 
     };
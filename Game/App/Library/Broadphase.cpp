@@ -0,0 +1,67 @@
+#include "Broadphase.h"
+#include <cmath>
+
+namespace My3dApp
+{
+    // 成分が0の向きの逆数の代わりに使う値
+    const float infiniteInvDir = 1.0e30f;
+
+    VECTOR Broadphase::CalcInvDir(const VECTOR& start, const VECTOR& end)
+    {
+        const float dir[3] = { end.x - start.x, end.y - start.y, end.z - start.z };
+        float inv[3];
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            inv[axis] = fabsf(dir[axis]) < 1.0e-12f ? infiniteInvDir : 1.0f / dir[axis];
+        }
+
+        return VGet(inv[0], inv[1], inv[2]);
+    }
+
+    bool Broadphase::RaycastBox(const VECTOR& start, const VECTOR& invDir, const AABB& box, float& hitRate)
+    {
+        // 各軸のスラブに入る位置と出る位置の割合を絞り込む
+        const float starts[3] = { start.x, start.y, start.z };
+        const float invs[3] = { invDir.x, invDir.y, invDir.z };
+        const float mins[3] = { box.minPos.x, box.minPos.y, box.minPos.z };
+        const float maxs[3] = { box.maxPos.x, box.maxPos.y, box.maxPos.z };
+
+        float enter = 0.0f;
+        float leave = 1.0f;
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            // 向きの成分が0の軸は始点がスラブの中にあるかだけを見る
+            if (invs[axis] == infiniteInvDir)
+            {
+                if (starts[axis] < mins[axis] || maxs[axis] < starts[axis])
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            float slabEnter = (mins[axis] - starts[axis]) * invs[axis];
+            float slabLeave = (maxs[axis] - starts[axis]) * invs[axis];
+
+            if (slabLeave < slabEnter)
+            {
+                const float temp = slabEnter;
+                slabEnter = slabLeave;
+                slabLeave = temp;
+            }
+
+            enter = slabEnter > enter ? slabEnter : enter;
+            leave = slabLeave < leave ? slabLeave : leave;
+
+            if (leave < enter)
+            {
+                return false;
+            }
+        }
+
+        hitRate = enter;
+        return true;
+    }
+}// namespace My3dApp
\ No newline at end of file
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include "DxLib.h"
+#include "Collision.h"
+#include "MemoryArena.h"
+
+using namespace std;
+
+namespace My3dApp
+{
+    // ブロードフェーズの実装の種類
+    enum class BroadphaseType
+    {
+        SpatialHash,  // 一様グリッドの空間ハッシュ（大きさのそろった小さなものが多い場面向け）
+        AABBTree,     // 動的な境界箱の木（大きさの差が大きい場面向け）
+    };
+
+    /// <summary>
+    /// ブロードフェーズ（境界箱が重なる組み合わせの列挙と、範囲・線分での検索）
+    /// 毎フレームBeginFrameからEndFrameまでの間にすべての境界箱を登録し直してから検索する
+    /// </summary>
+    class Broadphase
+    {
+    protected:
+        /// <summary>
+        /// 線分と境界箱の交差判定
+        /// </summary>
+        /// <param name="start">線分の始点</param>
+        /// <param name="invDir">線分の始点から終点へのベクトルの各成分の逆数</param>
+        /// <param name="box">境界箱</param>
+        /// <param name="hitRate">交差する場合、始点からの入る位置の割合（0～1）</param>
+        /// <returns>交差する場合はtrueを返す</returns>
+        static bool RaycastBox(const VECTOR& start, const VECTOR& invDir, const AABB& box, float& hitRate);
+
+        /// <summary>
+        /// 線分の向きの各成分の逆数の計算（0の成分は十分大きな値にする）
+        /// </summary>
+        /// <param name="start">線分の始点</param>
+        /// <param name="end">線分の終点</param>
+        /// <returns>各成分の逆数</returns>
+        static VECTOR CalcInvDir(const VECTOR& start, const VECTOR& end);
+
+    public:
+        /// <summary>
+        /// 仮想デストラクタ
+        /// </summary>
+        virtual ~Broadphase() {}
+
+        /// <summary>
+        /// 登録されたすべての境界箱の削除
+        /// </summary>
+        virtual void Clear() = 0;
+
+        /// <summary>
+        /// 登録と作業領域の確保元の変更（登録は新しい確保元に移す）
+        /// </summary>
+        /// <param name="arena">確保元のアリーナ（nullptrならヒープ）</param>
+        virtual void SetArena(MemoryArena* arena) = 0;
+
+        /// <summary>
+        /// 1フレーム分の登録の開始
+        /// </summary>
+        virtual void BeginFrame() = 0;
+
+        /// <summary>
+        /// 境界箱の登録（前のフレームと同じ番号なら移動として扱う）
+        /// </summary>
+        /// <param name="id">呼び出し側の番号（フレームをまたいで同じものには同じ番号を使う）</param>
+        /// <param name="box">ワールド座標の境界箱</param>
+        /// <param name="group">自身の属するグループのビット</param>
+        /// <param name="mask">当たりを取りたい相手のグループのビット</param>
+        /// <param name="isStatic">動かないか（動かないもの同士は組み合わせにしない）</param>
+        virtual void SetProxy(int id, const AABB& box, unsigned int group, unsigned int mask, bool isStatic) = 0;
+
+        /// <summary>
+        /// 1フレーム分の登録の終了（今回登録されなかった番号は削除する）
+        /// </summary>
+        virtual void EndFrame() = 0;
+
+        /// <summary>
+        /// 境界箱が重なっている組み合わせの列挙
+        /// どちらかが相手のグループを当たりの対象にしている組み合わせだけを、重複なく返す
+        /// </summary>
+        /// <param name="pairs">見つかった組み合わせの番号（呼び出し側の配列に追加する）</param>
+        virtual void FindPairs(ArenaVector<pair<int, int>>& pairs) = 0;
+
+        /// <summary>
+        /// 範囲と重なる境界箱の検索
+        /// </summary>
+        /// <param name="box">調べる範囲</param>
+        /// <param name="groupMask">対象にするグループのビット</param>
+        /// <param name="ids">見つかった番号（呼び出し側の配列に追加する）</param>
+        virtual void QueryOverlap(const AABB& box, unsigned int groupMask, ArenaVector<int>& ids) = 0;
+
+        /// <summary>
+        /// 線分と交差する境界箱の検索
+        /// </summary>
+        /// <param name="start">線分の始点</param>
+        /// <param name="end">線分の終点</param>
+        /// <param name="groupMask">対象にするグループのビット</param>
+        /// <param name="ids">見つかった番号（始点に近い順に、呼び出し側の配列に追加する）</param>
+        virtual void QueryRay(const VECTOR& start, const VECTOR& end, unsigned int groupMask, ArenaVector<int>& ids) = 0;
+
+        /// <summary>
+        /// 登録された境界箱の数の取得
+        /// </summary>
+        /// <returns>登録された境界箱の数</returns>
+        virtual int GetProxyNum() const = 0;
+    };
+}// namespace My3dApp
\ No newline at end of file
@@ -4,85 +4,99 @@
 
 namespace My3dApp
 {
-    /// <summary>
-    /// xNgm̉Z
-    /// </summary>
-    /// <param name="lhs">1ڂ̃xNg</param>
-    /// <param name="rhs">2ڂ̃xNg</param>
-    /// <returns>Z̃xNg</returns>
-    VECTOR operator+(const VECTOR& lhs, const VECTOR& rhs);
-
-    /// <summary>
-    /// xNgm̌Z
-    /// </summary>
-    /// <param name="lhs">1ڂ̃xNg</param>
-    /// <param name="rhs">2ڂ̃xNg</param>
-    /// <returns>Z̃xNg</returns>
-    VECTOR operator-(const VECTOR& lhs, const VECTOR& rhs);
+    // ベクトルの演算子は毎フレームの移動・当たり判定の計算で呼ばれるので、呼び出し側で展開できるようにヘッダに置く
 
     /// <summary>
-    /// xNg̃XJ{i萔j
+    /// ベクトル同士の加算
     /// </summary>
-    /// <param name="s">萔</param>
-    /// <param name="rhs">xNg</param>
-    /// <returns>Z̃xNg</returns>
-    VECTOR operator*(const float s, const VECTOR& rhs);
+    /// <param name="lhs">1つ目のベクトル</param>
+    /// <param name="rhs">2つ目のベクトル</param>
+    /// <returns>加算後のベクトル</returns>
+    inline VECTOR operator+(const VECTOR& lhs, const VECTOR& rhs)
+    {
+        return VGet(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z);
+    }
 
     /// <summary>
-    /// xNg̃XJ{iE萔j
+    /// ベクトル同士の減算
     /// </summary>
-    /// <param name="lhs">xNg</param>
-    /// <param name="s">萔</param>
-    /// <returns>Z̃xNg</returns>
-    VECTOR operator*(const VECTOR& lhs, const float s);
+    /// <param name="lhs">1つ目のベクトル</param>
+    /// <param name="rhs">2つ目のベクトル</param>
+    /// <returns>減算後のベクトル</returns>
+    inline VECTOR operator-(const VECTOR& lhs, const VECTOR& rhs)
+    {
+        return VGet(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z);
+    }
 
     /// <summary>
-    /// xNg̉Z
+    /// ベクトルのスカラ倍（左定数）
     /// </summary>
-    /// <param name="lhs">̃xNg</param>
-    /// <param name="rhs">xNg</param>
-    /// <returns>Z̃xNg</returns>
-    VECTOR operator+=(VECTOR& lhs, const VECTOR& rhs);
+    /// <param name="s">定数</param>
+    /// <param name="rhs">ベクトル</param>
+    /// <returns>乗算後のベクトル</returns>
+    inline VECTOR operator*(const float s, const VECTOR& rhs)
+    {
+        return VGet(s * rhs.x, s * rhs.y, s * rhs.z);
+    }
 
     /// <summary>
-    /// xNǧZ
+    /// ベクトルのスカラ倍（右定数）
     /// </summary>
-    /// <param name="lhs">xNg</param>
-    /// <param name="rhs">xNg</param>
-    /// <returns>Z̃xNg</returns>
-    VECTOR operator-=(VECTOR& lhs, const VECTOR& rhs);
+    /// <param name="lhs">ベクトル</param>
+    /// <param name="s">定数</param>
+    /// <returns>乗算後のベクトル</returns>
+    inline VECTOR operator*(const VECTOR& lhs, const float s)
+    {
+        return VGet(lhs.x * s, lhs.y * s, lhs.z * s);
+    }
 
     /// <summary>
-    /// xNg̃XJ{iZj
+    /// ベクトルの加算代入
     /// </summary>
-    /// <param name="lhs">xNg</param>
-    /// <param name="s">萔</param>
-    /// <returns>Z̃xNg</returns>
-    VECTOR operator*=(VECTOR& lhs, const float s);
+    /// <param name="lhs">代入されるのベクトル</param>
+    /// <param name="rhs">代入するベクトル</param>
+    /// <returns>加算後のベクトル</returns>
+    inline VECTOR operator+=(VECTOR& lhs, const VECTOR& rhs)
+    {
+        lhs.x += rhs.x;
+        lhs.y += rhs.y;
+        lhs.z += rhs.z;
+        return lhs;
+    }
 
     /// <summary>
-    /// 2̃xNg̊pxقړǂ
+    /// ベクトルの減算代入
     /// </summary>
-    /// <param name="vec1">1ڂ̃xNg</param>
-    /// <param name="vec2">2ڂ̃xNg</param>
-    /// <returns>Ȃtrue Ȃfalse</returns>
-    bool IsNearAngle(const VECTOR& vec1, const VECTOR& vec2);
+    /// <param name="lhs">代入されるベクトル</param>
+    /// <param name="rhs">代入するベクトル</param>
+    /// <returns>減算後のベクトル</returns>
+    inline VECTOR operator-=(VECTOR& lhs, const VECTOR& rhs)
+    {
+        lhs.x -= rhs.x;
+        lhs.y -= rhs.y;
+        lhs.z -= rhs.z;
+        return lhs;
+    }
 
     /// <summary>
-    /// nowVecdirVec̍ŒZ̉]vZiY]zj
+    /// ベクトルのスカラ倍（乗算代入）
     /// </summary>
-    /// <param name="nowVec">݂̌xNg</param>
-    /// <param name="dirVec">xNg</param>
-    /// <returns>vȂ1.0f vȂ-1.0f</returns>
-    float CalcRotationDirectionYAXis(const VECTOR& nowVec, const VECTOR& dirVec);
+    /// <param name="lhs">ベクトル</param>
+    /// <param name="s">定数</param>
+    /// <returns>乗算後のベクトル</returns>
+    inline VECTOR operator*=(VECTOR& lhs, const float s)
+    {
+        lhs.x *= s;
+        lhs.y *= s;
+        lhs.z *= s;
+        return lhs;
+    }
 
     /// <summary>
-    /// nowVecaimVecɌdegreeSpeed̑xY]
+    /// 2つのベクトルの角度がほぼ同じかどうか
     /// </summary>
-    /// <param name="nowVec">݂̕xNg</param>
-    /// <param name="aimVec">ڕWxNg</param>
-    /// <param name="degreeSpeed">x</param>
-    /// <returns></returns>
-    VECTOR RotateForAimVecYAxis(const VECTOR& nowVec, const VECTOR& aimVec, float degreeSpeed);
-
+    /// <param name="vec1">1つ目のベクトル</param>
+    /// <param name="vec2">2つ目のベクトル</param>
+    /// <returns>同じならtrue そうじゃなければfalse</returns>
+    bool IsNearAngle(const VECTOR& vec1, const VECTOR& vec2);
 }// namespace My3dApp
\ No newline at end of file
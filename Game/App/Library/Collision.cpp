@@ -1,8 +1,20 @@
 #include "Collision.h"
 #include "Calc3D.h"
+#include "TriangleBVH.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using namespace std;
 
 namespace My3dApp
 {
+    // メッシュからの押し戻しで当たった三角形の4つ組を巡回する最大回数
+    const int pushBackIterationNum = 8;
+
+    // これ以下のめり込みは押し戻さない
+    const float pushBackSlop = 1.0e-3f;
+
     LineSegment::LineSegment()
         : localStart()
         , localEnd()
@@ -68,6 +80,129 @@ namespace My3dApp
         worldEnd = localEnd + pos;
     }
 
+    SweptSphere::SweptSphere()
+        : localCenter()
+        , worldStart()
+        , worldEnd()
+        , radius(0.0f)
+    {
+    }
+
+    SweptSphere::SweptSphere(const VECTOR& center, float r)
+        : localCenter(center)
+        , worldStart(center)
+        , worldEnd(center)
+        , radius(r)
+    {
+    }
+
+    void SweptSphere::Move(const VECTOR& pos)
+    {
+        worldEnd = localCenter + pos;
+    }
+
+    void SweptSphere::BeginSweep()
+    {
+        worldStart = worldEnd;
+    }
+
+    MeshCollider::MeshCollider()
+        : bvh(nullptr)
+        , localOrigin()
+        , worldOrigin()
+        , heightField(nullptr)
+    {
+    }
+
+    MeshCollider::MeshCollider(const TriangleBVH* bvh, const VECTOR& origin)
+        : bvh(bvh)
+        , localOrigin(origin)
+        , worldOrigin(origin)
+        , heightField(nullptr)
+    {
+    }
+
+    void MeshCollider::Move(const VECTOR& pos)
+    {
+        worldOrigin = localOrigin + pos;
+    }
+
+    AABB::AABB()
+        : minPos()
+        , maxPos()
+    {
+    }
+
+    AABB::AABB(const VECTOR& minPos, const VECTOR& maxPos)
+        : minPos(minPos)
+        , maxPos(maxPos)
+    {
+    }
+
+    void AABB::Merge(const AABB& other)
+    {
+        minPos = VGet(min(minPos.x, other.minPos.x), min(minPos.y, other.minPos.y), min(minPos.z, other.minPos.z));
+        maxPos = VGet(max(maxPos.x, other.maxPos.x), max(maxPos.y, other.maxPos.y), max(maxPos.z, other.maxPos.z));
+    }
+
+    bool AABB::Contains(const AABB& other) const
+    {
+        return minPos.x <= other.minPos.x && minPos.y <= other.minPos.y && minPos.z <= other.minPos.z
+            && other.maxPos.x <= maxPos.x && other.maxPos.y <= maxPos.y && other.maxPos.z <= maxPos.z;
+    }
+
+    float AABB::GetSurfaceArea() const
+    {
+        const float dx = maxPos.x - minPos.x;
+        const float dy = maxPos.y - minPos.y;
+        const float dz = maxPos.z - minPos.z;
+        return 2.0f * (dx * dy + dy * dz + dz * dx);
+    }
+
+    AABB CalcAABB(const LineSegment& line)
+    {
+        return AABB(VGet(min(line.worldStart.x, line.worldEnd.x), min(line.worldStart.y, line.worldEnd.y), min(line.worldStart.z, line.worldEnd.z)),
+            VGet(max(line.worldStart.x, line.worldEnd.x), max(line.worldStart.y, line.worldEnd.y), max(line.worldStart.z, line.worldEnd.z)));
+    }
+
+    AABB CalcAABB(const Sphere& sphere)
+    {
+        const VECTOR extent = VGet(sphere.radius, sphere.radius, sphere.radius);
+        return AABB(sphere.worldCenter - extent, sphere.worldCenter + extent);
+    }
+
+    AABB CalcAABB(const Capsule& capsule)
+    {
+        const VECTOR extent = VGet(capsule.radius, capsule.radius, capsule.radius);
+        AABB box = CalcAABB(LineSegment(capsule.worldStart, capsule.worldEnd));
+        box.minPos = box.minPos - extent;
+        box.maxPos = box.maxPos + extent;
+        return box;
+    }
+
+    AABB CalcAABB(const SweptSphere& sweep)
+    {
+        return CalcAABB(Capsule(sweep.worldStart, sweep.worldEnd, sweep.radius));
+    }
+
+    AABB CalcAABB(const MeshCollider& mesh)
+    {
+        if (!mesh.bvh)
+        {
+            return AABB(mesh.worldOrigin, mesh.worldOrigin);
+        }
+
+        const AABB localBox = mesh.bvh->GetBounds();
+        return AABB(localBox.minPos + mesh.worldOrigin, localBox.maxPos + mesh.worldOrigin);
+    }
+
+    bool CollisionPair(const AABB& boxA, const AABB& boxB)
+    {
+        return boxA.minPos.x <= boxB.maxPos.x && boxB.minPos.x <= boxA.maxPos.x
+            && boxA.minPos.y <= boxB.maxPos.y && boxB.minPos.y <= boxA.maxPos.y
+            && boxA.minPos.z <= boxB.maxPos.z && boxB.minPos.z <= boxA.maxPos.z;
+    }
+
     bool CollisionPair(const Sphere& sphereA, const Sphere& sphereB)
     {
         return HitCheck_Sphere_Sphere(sphereA.worldCenter, sphereA.radius, sphereB.worldCenter, sphereB.radius);
@@ -83,6 +218,57 @@ namespace My3dApp
         return CollisionPair(line, sphere);
     }
 
+    bool CollisionPair(const Capsule& capsuleA, const Capsule& capsuleB)
+    {
+        // 芯の線分同士の最短距離が半径の和以下なら当たっている
+        const float radius = capsuleA.radius + capsuleB.radius;
+        return CalcSegmentSegmentDistanceSquare(capsuleA.worldStart, capsuleA.worldEnd, capsuleB.worldStart, capsuleB.worldEnd) <= radius * radius;
+    }
+
+    bool CollisionPair(const Capsule& capsule, const Sphere& sphere)
+    {
+        const VECTOR toCenter = sphere.worldCenter - CalcClosestPointOnSegment(sphere.worldCenter, capsule.worldStart, capsule.worldEnd);
+        const float radius = capsule.radius + sphere.radius;
+        return VDot(toCenter, toCenter) <= radius * radius;
+    }
+
+    bool CollisionPair(const Sphere& sphere, const Capsule& capsule)
+    {
+        return CollisionPair(capsule, sphere);
+    }
+
+    bool CollisionPair(const Capsule& capsule, const LineSegment& line)
+    {
+        return CalcSegmentSegmentDistanceSquare(capsule.worldStart, capsule.worldEnd, line.worldStart, line.worldEnd) <= capsule.radius * capsule.radius;
+    }
+
+    bool CollisionPair(const LineSegment& line, const Capsule& capsule)
+    {
+        return CollisionPair(capsule, line);
+    }
+
+    bool CollisionPair(const SweptSphere& sweep, const Sphere& sphere, float& hitTime)
+    {
+        // 半径を相手に足し、中心の通る線分との交差に置き換える
+        return IntersectSegmentSphere(sweep.worldStart, sweep.worldEnd, sphere.worldCenter, sweep.radius + sphere.radius, hitTime);
+    }
+
+    bool CollisionPair(const SweptSphere& sweep, const Capsule& capsule, float& hitTime)
+    {
+        return IntersectSegmentCapsule(sweep.worldStart, sweep.worldEnd, capsule.worldStart, capsule.worldEnd, sweep.radius + capsule.radius, hitTime);
+    }
+
+    bool CollisionPair(const SweptSphere& sweep, const MeshCollider& mesh, MeshRayHit& hit)
+    {
+        if (!mesh.bvh->SweepSphere(sweep.worldStart - mesh.worldOrigin, sweep.worldEnd - mesh.worldOrigin, sweep.radius, hit))
+        {
+            return false;
+        }
+
+        hit.position += mesh.worldOrigin;
+        return true;
+    }
+
     bool CollisionPair(const Sphere& sphere, const int modelHandle, MV1_COLL_RESULT_POLY_DIM& collisionInfo)
     {
         collisionInfo = MV1CollCheck_Sphere(modelHandle, -1, sphere.worldCenter, sphere.radius);
@@ -106,66 +292,602 @@ namespace My3dApp
 
     VECTOR CalcSpherePushBackVecFromMesh(const Sphere& sphere, const MV1_COLL_RESULT_POLY_DIM& collisionInfo)
     {
-        // Փˋ
-        // S
+        // 衝突球
+        // 球中心候補
         VECTOR moveCandidate = sphere.worldCenter;
 
-        // a
+        // 球半径
         float radius = sphere.radius;
 
-        // |Sʖ@
+        // ポリゴン平面法線
         VECTOR planeNormal;
 
-        // ړxNg
+        // 移動ベクトル
         VECTOR moveVec = VGet(0, 0, 0);
 
-        // ړ
+        // 移動量
         float moveLen = 0.0f;
 
-        // ړ
+        // 移動候補
         VECTOR newCenter = sphere.worldCenter;
 
-        // Փ˃|SׂĉāÂ߂荞݂
+        // 衝突ポリゴンをすべて回って、球のめり込みを解消する
         for (int i = 0; i < collisionInfo.HitNum; ++i)
         {
-            // Փ˃|S̕1
+            // 衝突ポリゴンの辺1
             VECTOR edge1 = collisionInfo.Dim[i].Position[1] - collisionInfo.Dim[i].Position[0];
 
-            // Փ˃|S̕2
+            // 衝突ポリゴンの辺2
             VECTOR edge2 = collisionInfo.Dim[i].Position[2] - collisionInfo.Dim[i].Position[0];
 
-            // Փ˃|S̕ӂA|Sʂ̖@xNg߂
+            // 衝突ポリゴンの辺より、ポリゴン面の法線ベクトルを求める
             planeNormal = VCross(edge1, edge2);
             planeNormal = VNorm(planeNormal);
 
-            // Sɍł߂|Sʂ̓_߂
+            // 球中心に最も近いポリゴン平面の点を求める
             VECTOR tmp = moveCandidate - collisionInfo.Dim[i].Position[0];
             float dot = VDot(planeNormal, tmp);
 
-            // Փ˓_
+            // 衝突点
             VECTOR hitPos = moveCandidate - planeNormal * dot;
 
-            // ǂꂭ炢߂荞ł邩Zo
+            // 球がどれくらいめり込んでいるかを算出
             VECTOR tmp2 = moveCandidate - hitPos;
             float len = VSize(tmp2);
 
-            // ߂荞łꍇ͋̒S߂
+            // めり込んでいる場合は球の中心を押し戻し
             if (HitCheck_Sphere_Triangle(moveCandidate, radius,
                 collisionInfo.Dim[i].Position[0],
                 collisionInfo.Dim[i].Position[1],
                 collisionInfo.Dim[i].Position[2]) == TRUE)
             {
-                // ߂荞݉ʒu܂ňړ
+                // めり込み解消する位置まで移動
                 len = radius - len;
                 moveVec = planeNormal * len;
                 moveCandidate += moveVec;
             }
         }
 
-        // ړړʒuɂ
+        // 移動候補を移動位置にする
         newCenter = moveCandidate;
 
-        // ߂ʂԋp
+        // 押し戻し量を返却
         return newCenter - sphere.worldCenter;
     }
+
+    bool CollisionPair(const Sphere& sphere, const MeshCollider& mesh, MeshHitList& hitList)
+    {
+        // 三角形は作り直さず、球の方をメッシュのローカル座標に移して調べる
+        return 0 < mesh.bvh->QuerySphere(sphere.worldCenter - mesh.worldOrigin, sphere.radius, hitList);
+    }
+
+    bool CollisionPair(const Capsule& capsule, const MeshCollider& mesh, MeshHitList& hitList)
+    {
+        return 0 < mesh.bvh->QueryCapsule(capsule.worldStart - mesh.worldOrigin, capsule.worldEnd - mesh.worldOrigin, capsule.radius, hitList);
+    }
+
+    bool CollisionPair(const LineSegment& line, const MeshCollider& mesh, MeshRayHit& hit)
+    {
+        if (!mesh.bvh->Raycast(line.worldStart - mesh.worldOrigin, line.worldEnd - mesh.worldOrigin, hit))
+        {
+            return false;
+        }
+
+        // 交点をワールド座標に戻す（平行移動だけなので法線はそのまま）
+        hit.position += mesh.worldOrigin;
+        return true;
+    }
+
+    VECTOR CalcSpherePushBackVecFromMesh(const Sphere& sphere, const MeshCollider& mesh, const MeshHitList& hitList)
+    {
+        // 球中心候補（メッシュのローカル座標）
+        const VECTOR localCenter = sphere.worldCenter - mesh.worldOrigin;
+        VECTOR moveCandidate = localCenter;
+
+        // 当たった三角形を4つずつ順に調べ、その中で最も深くめり込んでいるものから押し戻す
+        // すべての4つ組で押し戻しがなくなるまで巡回する（同じ面の三角形で二重に押し戻したり、角で押し戻しが振動したりしない）
+        int quietNum = 0;
+
+        for (int step = 0; step < pushBackIterationNum * hitList.packetNum && quietNum < hitList.packetNum; ++step)
+        {
+            const int i = step % hitList.packetNum;
+            const TrianglePacket& packet = mesh.bvh->GetPacket(hitList.packets[i]);
+            TrianglePacketClosest closest;
+            const unsigned int contactMask = CalcSphereContacts(packet, moveCandidate, sphere.radius, closest) & hitList.laneMasks[i];
+
+            ++quietNum;
+
+            if (!contactMask)
+            {
+                continue;
+            }
+
+            int deepestLane = -1;
+            float nearestSq = sphere.radius * sphere.radius;
+
+            for (int lane = 0; lane < TrianglePacket::laneNum; ++lane)
+            {
+                if ((contactMask & (1u << lane)) && closest.distanceSq[lane] < nearestSq)
+                {
+                    deepestLane = lane;
+                    nearestSq = closest.distanceSq[lane];
+                }
+            }
+
+            const float distance = sqrtf(nearestSq);
+            if (deepestLane == -1 || sphere.radius - distance <= pushBackSlop)
+            {
+                continue;
+            }
+
+            // 最近点から球の中心へ押し出す（中心が面上にある場合は法線方向）
+            const VECTOR pushDir = 1.0e-6f < distance
+                ? VScale(moveCandidate - VGet(closest.position[0][deepestLane], closest.position[1][deepestLane], closest.position[2][deepestLane]), 1.0f / distance)
+                : VGet(packet.normal[0][deepestLane], packet.normal[1][deepestLane], packet.normal[2][deepestLane]);
+
+            moveCandidate += pushDir * (sphere.radius - distance);
+            quietNum = 0;
+        }
+
+        // 押し戻し量を返却
+        return moveCandidate - localCenter;
+    }
+
+    VECTOR CalcCapsulePushBackVecFromMesh(const Capsule& capsule, const MeshCollider& mesh, const MeshHitList& hitList)
+    {
+        // 芯の線分の始点候補（メッシュのローカル座標、芯の向きと長さは変えない）
+        const VECTOR localStart = capsule.worldStart - mesh.worldOrigin;
+        const VECTOR axis = capsule.worldEnd - capsule.worldStart;
+        VECTOR moveCandidate = localStart;
+
+        // 最も深くめり込んでいる三角形を含む4つ組から巡回を始める
+        // （床に沈んだ場合、隣の三角形の辺から斜めに押し出して横にずれないように、先に真下の面から押し戻す）
+        int firstPacket = 0;
+        float firstDistanceSq = FLT_MAX;
+
+        for (int i = 0; i < hitList.packetNum; ++i)
+        {
+            TrianglePacketCapsuleClosest closest;
+            const unsigned int contactMask = CalcCapsuleContacts(mesh.bvh->GetPacket(hitList.packets[i]), localStart, localStart + axis, capsule.radius, closest) & hitList.laneMasks[i];
+
+            for (int lane = 0; lane < TrianglePacket::laneNum; ++lane)
+            {
+                if ((contactMask & (1u << lane)) && closest.distanceSq[lane] < firstDistanceSq)
+                {
+                    firstPacket = i;
+                    firstDistanceSq = closest.distanceSq[lane];
+                }
+            }
+        }
+
+        // 球と同じく、4つ組ごとに最も深くめり込んでいる三角形から押し戻して巡回する
+        int quietNum = 0;
+
+        for (int step = 0; step < pushBackIterationNum * hitList.packetNum && quietNum < hitList.packetNum; ++step)
+        {
+            const int i = (firstPacket + step) % hitList.packetNum;
+            const TrianglePacket& packet = mesh.bvh->GetPacket(hitList.packets[i]);
+            TrianglePacketCapsuleClosest closest;
+            const unsigned int contactMask = CalcCapsuleContacts(packet, moveCandidate, moveCandidate + axis, capsule.radius, closest) & hitList.laneMasks[i];
+
+            ++quietNum;
+
+            if (!contactMask)
+            {
+                continue;
+            }
+
+            int deepestLane = -1;
+            float nearestSq = capsule.radius * capsule.radius;
+
+            for (int lane = 0; lane < TrianglePacket::laneNum; ++lane)
+            {
+                if ((contactMask & (1u << lane)) && closest.distanceSq[lane] < nearestSq)
+                {
+                    deepestLane = lane;
+                    nearestSq = closest.distanceSq[lane];
+                }
+            }
+
+            if (deepestLane == -1)
+            {
+                continue;
+            }
+
+            const float distance = sqrtf(nearestSq);
+            VECTOR pushDir;
+            float depth;
+
+            if (1.0e-6f < distance)
+            {
+                // 三角形上の最近点から芯の上の最近点へ押し出す
+                const VECTOR onTriangle = VGet(closest.position[0][deepestLane], closest.position[1][deepestLane], closest.position[2][deepestLane]);
+                const VECTOR onSegment = VGet(closest.segmentPosition[0][deepestLane], closest.segmentPosition[1][deepestLane], closest.segmentPosition[2][deepestLane]);
+                pushDir = VScale(onSegment - onTriangle, 1.0f / distance);
+                depth = capsule.radius - distance;
+            }
+            else
+            {
+                // 芯が三角形を貫いている場合は、面から遠い方の端点の側へ、近い方の端点が抜けるまで押し出す
+                const VECTOR normal = VGet(packet.normal[0][deepestLane], packet.normal[1][deepestLane], packet.normal[2][deepestLane]);
+                const float startDistance = VDot(normal, moveCandidate) - packet.planeDistance[deepestLane];
+                const float endDistance = VDot(normal, moveCandidate + axis) - packet.planeDistance[deepestLane];
+
+                pushDir = startDistance + endDistance < 0.0f ? VScale(normal, -1.0f) : normal;
+                depth = capsule.radius + min(fabsf(startDistance), fabsf(endDistance));
+            }
+
+            if (depth <= pushBackSlop)
+            {
+                continue;
+            }
+
+            moveCandidate += pushDir * depth;
+            quietNum = 0;
+        }
+
+        // 押し戻し量を返却
+        return moveCandidate - localStart;
+    }
+
+    VECTOR CalcClosestPointOnSegment(const VECTOR& point, const VECTOR& start, const VECTOR& end)
+    {
+        const VECTOR dir = end - start;
+        const float lengthSq = VDot(dir, dir);
+
+        // 長さのない線分は始点
+        if (lengthSq <= 1.0e-8f)
+        {
+            return start;
+        }
+
+        const float rate = min(max(VDot(point - start, dir) / lengthSq, 0.0f), 1.0f);
+        return start + dir * rate;
+    }
+
+    VECTOR CalcClosestPointOnTriangle(const VECTOR& point, const VECTOR& a, const VECTOR& b, const VECTOR& c)
+    {
+        // 頂点、辺、面のどの領域に点が射影されるかで場合分けする
+        const VECTOR ab = b - a;
+        const VECTOR ac = c - a;
+        const VECTOR ap = point - a;
+
+        const float d1 = VDot(ab, ap);
+        const float d2 = VDot(ac, ap);
+        if (d1 <= 0.0f && d2 <= 0.0f)
+        {
+            return a;
+        }
+
+        const VECTOR bp = point - b;
+        const float d3 = VDot(ab, bp);
+        const float d4 = VDot(ac, bp);
+        if (0.0f <= d3 && d4 <= d3)
+        {
+            return b;
+        }
+
+        const float vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0f && 0.0f <= d1 && d3 <= 0.0f)
+        {
+            return a + ab * (d1 / (d1 - d3));
+        }
+
+        const VECTOR cp = point - c;
+        const float d5 = VDot(ab, cp);
+        const float d6 = VDot(ac, cp);
+        if (0.0f <= d6 && d5 <= d6)
+        {
+            return c;
+        }
+
+        const float vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && 0.0f <= d2 && d6 <= 0.0f)
+        {
+            return a + ac * (d2 / (d2 - d6));
+        }
+
+        const float va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && 0.0f <= d4 - d3 && 0.0f <= d5 - d6)
+        {
+            return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+        }
+
+        // 面の内側
+        const float denom = 1.0f / (va + vb + vc);
+        return a + ab * (vb * denom) + ac * (vc * denom);
+    }
+
+    bool IntersectSegmentTriangle(const VECTOR& start, const VECTOR& end, const VECTOR& a, const VECTOR& b, const VECTOR& c, float& hitRate)
+    {
+        // Moller-Trumboreの方法（重心座標と線分上の位置を同時に解く）
+        const VECTOR dir = end - start;
+        const VECTOR edge1 = b - a;
+        const VECTOR edge2 = c - a;
+
+        const VECTOR pvec = VCross(dir, edge2);
+        const float det = VDot(edge1, pvec);
+
+        // 三角形の面と平行
+        if (fabsf(det) < 1.0e-8f)
+        {
+            return false;
+        }
+
+        const float invDet = 1.0f / det;
+        const VECTOR tvec = start - a;
+
+        const float u = VDot(tvec, pvec) * invDet;
+        if (u < 0.0f || 1.0f < u)
+        {
+            return false;
+        }
+
+        const VECTOR qvec = VCross(tvec, edge1);
+        const float v = VDot(dir, qvec) * invDet;
+        if (v < 0.0f || 1.0f < u + v)
+        {
+            return false;
+        }
+
+        const float t = VDot(edge2, qvec) * invDet;
+        if (t < 0.0f || 1.0f < t)
+        {
+            return false;
+        }
+
+        hitRate = t;
+        return true;
+    }
+
+    bool IntersectSegmentSphere(const VECTOR& start, const VECTOR& end, const VECTOR& center, float radius, float& hitRate)
+    {
+        const VECTOR dir = end - start;
+        const VECTOR toStart = start - center;
+        const float c = VDot(toStart, toStart) - radius * radius;
+
+        // 始点で重なっている
+        if (c <= 0.0f)
+        {
+            hitRate = 0.0f;
+            return true;
+        }
+
+        // 離れていく、または動いていない
+        const float b = VDot(toStart, dir);
+        const float a = VDot(dir, dir);
+        if (0.0f <= b || a <= 1.0e-12f)
+        {
+            return false;
+        }
+
+        const float discriminant = b * b - a * c;
+        if (discriminant < 0.0f)
+        {
+            return false;
+        }
+
+        const float t = (-b - sqrtf(discriminant)) / a;
+        if (1.0f < t)
+        {
+            return false;
+        }
+
+        hitRate = t;
+        return true;
+    }
+
+    bool IntersectSegmentCapsule(const VECTOR& start, const VECTOR& end, const VECTOR& capsuleStart, const VECTOR& capsuleEnd, float radius, float& hitRate)
+    {
+        // 始点で重なっている
+        const VECTOR toAxis = start - CalcClosestPointOnSegment(start, capsuleStart, capsuleEnd);
+        if (VDot(toAxis, toAxis) <= radius * radius)
+        {
+            hitRate = 0.0f;
+            return true;
+        }
+
+        // 両端の球
+        float nearestRate = 2.0f;
+        float rate;
+
+        if (IntersectSegmentSphere(start, end, capsuleStart, radius, rate))
+        {
+            nearestRate = rate;
+        }
+        if (IntersectSegmentSphere(start, end, capsuleEnd, radius, rate))
+        {
+            nearestRate = min(nearestRate, rate);
+        }
+
+        // 側面の円柱（芯の範囲に入る交点だけ）
+        const VECTOR axis = capsuleEnd - capsuleStart;
+        const VECTOR dir = end - start;
+        const VECTOR m = start - capsuleStart;
+
+        const float dd = VDot(axis, axis);
+        const float md = VDot(m, axis);
+        const float nd = VDot(dir, axis);
+        const float a = dd * VDot(dir, dir) - nd * nd;
+        const float b = dd * VDot(m, dir) - nd * md;
+        const float c = dd * (VDot(m, m) - radius * radius) - md * md;
+
+        // 芯と平行に動く場合は両端の球だけで決まる
+        if (1.0e-8f * dd < a && 1.0e-8f < dd)
+        {
+            const float discriminant = b * b - a * c;
+
+            if (0.0f <= discriminant)
+            {
+                const float t = (-b - sqrtf(discriminant)) / a;
+                const float axial = md + t * nd;
+
+                if (0.0f <= t && t <= 1.0f && 0.0f <= axial && axial <= dd)
+                {
+                    nearestRate = min(nearestRate, t);
+                }
+            }
+        }
+
+        if (1.0f < nearestRate)
+        {
+            return false;
+        }
+
+        hitRate = nearestRate;
+        return true;
+    }
+
+    bool IntersectSweptSphereTriangle(const VECTOR& start, const VECTOR& end, float radius, const VECTOR& a, const VECTOR& b, const VECTOR& c, float& hitTime)
+    {
+        // 始点で重なっている
+        const VECTOR toStart = start - CalcClosestPointOnTriangle(start, a, b, c);
+        if (VDot(toStart, toStart) <= radius * radius)
+        {
+            hitTime = 0.0f;
+            return true;
+        }
+
+        const VECTOR dir = end - start;
+        float nearestTime = 2.0f;
+
+        // 面：始点の側に半径だけずらした面に中心が届く時刻で、そのとき触れる点が三角形の内側にあるか
+        const VECTOR cross = VCross(b - a, c - a);
+        const float crossLength = VSize(cross);
+
+        if (0.0f < crossLength)
+        {
+            const VECTOR normal = VScale(cross, 1.0f / crossLength);
+            const float startDistance = VDot(normal, start - a);
+            const float side = startDistance < 0.0f ? -1.0f : 1.0f;
+            const float approach = -side * VDot(normal, dir);
+
+            if (1.0e-12f < approach)
+            {
+                const float t = (fabsf(startDistance) - radius) / approach;
+
+                if (0.0f <= t && t <= 1.0f)
+                {
+                    const VECTOR contact = start + dir * t - normal * (side * radius);
+                    const VECTOR onTriangle = CalcClosestPointOnTriangle(contact, a, b, c);
+
+                    if (VDot(contact - onTriangle, contact - onTriangle) <= 1.0e-4f * radius * radius)
+                    {
+                        nearestTime = t;
+                    }
+                }
+            }
+        }
+
+        // 辺と頂点：辺を芯にした半径のカプセルに中心が入る時刻
+        const VECTOR vertex[3] = { a, b, c };
+        for (int edge = 0; edge < 3; ++edge)
+        {
+            float t;
+            if (IntersectSegmentCapsule(start, end, vertex[edge], vertex[edge == 2 ? 0 : edge + 1], radius, t))
+            {
+                nearestTime = min(nearestTime, t);
+            }
+        }
+
+        if (1.0f < nearestTime)
+        {
+            return false;
+        }
+
+        hitTime = nearestTime;
+        return true;
+    }
+
+    float CalcSegmentSegmentDistanceSquare(const VECTOR& start1, const VECTOR& end1, const VECTOR& start2, const VECTOR& end2)
+    {
+        VECTOR closest1;
+        VECTOR closest2;
+        return CalcClosestPointsSegmentSegment(start1, end1, start2, end2, closest1, closest2);
+    }
+
+    float CalcClosestPointsSegmentSegment(const VECTOR& start1, const VECTOR& end1, const VECTOR& start2, const VECTOR& end2, VECTOR& closest1, VECTOR& closest2)
+    {
+        const VECTOR d1 = end1 - start1;
+        const VECTOR d2 = end2 - start2;
+        const VECTOR r = start1 - start2;
+
+        const float a = VDot(d1, d1);
+        const float e = VDot(d2, d2);
+        const float f = VDot(d2, r);
+
+        float s = 0.0f;
+        float t = 0.0f;
+
+        if (a <= 1.0e-8f && e <= 1.0e-8f)
+        {
+            // どちらも点
+            closest1 = start1;
+            closest2 = start2;
+            return VDot(r, r);
+        }
+
+        if (a <= 1.0e-8f)
+        {
+            // 線分1が点
+            t = min(max(f / e, 0.0f), 1.0f);
+        }
+        else
+        {
+            const float c = VDot(d1, r);
+
+            if (e <= 1.0e-8f)
+            {
+                // 線分2が点
+                s = min(max(-c / a, 0.0f), 1.0f);
+            }
+            else
+            {
+                // 無限直線同士の最近点を求めてから線分の範囲に収める
+                const float b = VDot(d1, d2);
+                const float denom = a * e - b * b;
+
+                s = denom != 0.0f ? min(max((b * f - c * e) / denom, 0.0f), 1.0f) : 0.0f;
+                t = (b * s + f) / e;
+
+                if (t < 0.0f)
+                {
+                    t = 0.0f;
+                    s = min(max(-c / a, 0.0f), 1.0f);
+                }
+                else if (1.0f < t)
+                {
+                    t = 1.0f;
+                    s = min(max((b - c) / a, 0.0f), 1.0f);
+                }
+            }
+        }
+
+        closest1 = start1 + d1 * s;
+        closest2 = start2 + d2 * t;
+
+        const VECTOR diff = closest1 - closest2;
+        return VDot(diff, diff);
+    }
+
+    float CalcSegmentTriangleDistanceSquare(const VECTOR& start, const VECTOR& end, const VECTOR& a, const VECTOR& b, const VECTOR& c)
+    {
+        // 交差していれば0
+        float hitRate;
+        if (IntersectSegmentTriangle(start, end, a, b, c, hitRate))
+        {
+            return 0.0f;
+        }
+
+        // 交差しなければ、線分の端点と三角形、線分と三角形の各辺の最短距離のうち最小のもの
+        const VECTOR toStart = start - CalcClosestPointOnTriangle(start, a, b, c);
+        const VECTOR toEnd = end - CalcClosestPointOnTriangle(end, a, b, c);
+
+        float distance = min(VDot(toStart, toStart), VDot(toEnd, toEnd));
+        distance = min(distance, CalcSegmentSegmentDistanceSquare(start, end, a, b));
+        distance = min(distance, CalcSegmentSegmentDistanceSquare(start, end, b, c));
+        distance = min(distance, CalcSegmentSegmentDistanceSquare(start, end, c, a));
+
+        return distance;
+    }
 }// namespace My3dApp
\ No newline at end of file
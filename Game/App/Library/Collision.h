@@ -4,175 +4,558 @@
 
 namespace My3dApp
 {
+    class TriangleBVH;
+    class HeightField;
+    struct MeshHitList;
+    struct MeshRayHit;
+
     /// <summary>
-    /// 蔻
+    /// 線分当たり判定
     /// </summary>
     struct LineSegment
     {
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
         LineSegment();
 
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
-        /// <param name="startPos">n_W</param>
-        /// <param name="endPos">I_W</param>
+        /// <param name="startPos">初期始点座標</param>
+        /// <param name="endPos">初期終点座標</param>
         LineSegment(const VECTOR& startPos, const VECTOR& endPos);
 
         /// <summary>
-        /// 蔻̈ړ
+        /// 線分当たり判定の移動
         /// </summary>
-        /// <param name="pos">ړW</param>
+        /// <param name="pos">移動座標</param>
         void Move(const VECTOR& pos);
 
-        // ̃[Jn_W
+        // 線分のローカル始点座標
         VECTOR localStart;
 
-        // ̃[JI_W
+        // 線分のローカル終点座標
         VECTOR localEnd;
 
-        // ̃[hn_W
+        // 線分のワールド始点座標
         VECTOR worldStart;
 
-        // ̃[hI_W
+        // 線分のワールド終点座標
         VECTOR worldEnd;
 
     };
 
     /// <summary>
-    /// ̓蔻
+    /// 球体当たり判定
     /// </summary>
     struct Sphere
     {
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
         Sphere();
 
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
-        /// <param name="center">SW</param>
-        /// <param name="r">a</param>
+        /// <param name="center">中心座標</param>
+        /// <param name="r">半径</param>
         Sphere(const VECTOR& center, float r);
 
         /// <summary>
-        /// ̓蔻̈ړ
+        /// 球体当たり判定の移動
         /// </summary>
-        /// <param name="pos">ړW</param>
+        /// <param name="pos">移動座標</param>
         void Move(const VECTOR& pos);
 
-        // ̂̃[JSW
+        // 球体のローカル中心座標
         VECTOR localCenter;
 
-        // ̂̃[hSW
+        // 球体のワールド中心座標
         VECTOR worldCenter;
 
-        // ̂̔a
+        // 球体の半径
         float radius;
 
     };
 
     /// <summary>
-    /// JvZ蔻
+    /// カプセル当たり判定
     /// </summary>
     struct Capsule
     {
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
         Capsule();
 
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
-        /// <param name="start">n_W</param>
-        /// <param name="end">I_W</param>
-        /// <param name="r">a</param>
+        /// <param name="start">初期始点座標</param>
+        /// <param name="end">初期終点座標</param>
+        /// <param name="r">半径</param>
         Capsule(const VECTOR& start, const VECTOR& end, float r);
 
         /// <summary>
-        /// JvZ蔻̈ړ
+        /// カプセル当たり判定の移動
         /// </summary>
-        /// <param name="pos">ړW</param>
+        /// <param name="pos">移動座標</param>
         void Move(const VECTOR& pos);
 
-        // JvZ̃[Jn_W
+        // カプセルのローカル始点座標
         VECTOR localStart;
 
-        // JvZ̃[JI_W
+        // カプセルのローカル終点座標
         VECTOR localEnd;
 
-        // JvZ̃[hn_W
+        // カプセルのワールド始点座標
+        VECTOR worldStart;
+
+        // カプセルのワールド終点座標
+        VECTOR worldEnd;
+
+        // カプセルの半径
+        float radius;
+
+    };
+
+    /// <summary>
+    /// 移動する球の当たり判定（移動の始点から今の位置までに通った範囲を調べ、速い弾のすり抜けを防ぐ）
+    /// </summary>
+    struct SweptSphere
+    {
+        /// <summary>
+        /// コンストラクタ
+        /// </summary>
+        SweptSphere();
+
+        /// <summary>
+        /// コンストラクタ
+        /// </summary>
+        /// <param name="center">中心座標</param>
+        /// <param name="r">半径</param>
+        SweptSphere(const VECTOR& center, float r);
+
+        /// <summary>
+        /// 移動する球の当たり判定の移動（移動の始点は変えない）
+        /// </summary>
+        /// <param name="pos">移動座標</param>
+        void Move(const VECTOR& pos);
+
+        /// <summary>
+        /// 今の位置を次の移動の始点にする（フレームの始めに呼ぶ）
+        /// </summary>
+        void BeginSweep();
+
+        // 球体のローカル中心座標
+        VECTOR localCenter;
+
+        // 移動の始点のワールド中心座標
         VECTOR worldStart;
 
-        // JvZ̃[hI_W
+        // 今のワールド中心座標
         VECTOR worldEnd;
 
-        // JvZ̔a
+        // 球体の半径
         float radius;
 
     };
 
     /// <summary>
-    /// ̑΋̂̓蔻
+    /// メッシュ当たり判定（ローカル座標で1回だけ作った三角形BVHを平行移動して使う）
+    /// </summary>
+    struct MeshCollider
+    {
+        /// <summary>
+        /// コンストラクタ
+        /// </summary>
+        MeshCollider();
+
+        /// <summary>
+        /// コンストラクタ
+        /// </summary>
+        /// <param name="bvh">ローカル座標の三角形BVH</param>
+        /// <param name="origin">メッシュ原点の初期座標</param>
+        MeshCollider(const TriangleBVH* bvh, const VECTOR& origin);
+
+        /// <summary>
+        /// メッシュ当たり判定の移動（三角形は作り直さない）
+        /// </summary>
+        /// <param name="pos">移動座標</param>
+        void Move(const VECTOR& pos);
+
+        // ローカル座標の三角形BVH（持たない場合はnullptr、実体は持ち主が持つ）
+        const TriangleBVH* bvh;
+
+        // メッシュ原点のローカル座標
+        VECTOR localOrigin;
+
+        // メッシュ原点のワールド座標
+        VECTOR worldOrigin;
+
+        // ローカル座標の地面の高さの格子（持たない場合はnullptr、実体は持ち主が持つ）
+        const HeightField* heightField;
+
+    };
+
+    /// <summary>
+    /// 軸に平行な境界箱
+    /// </summary>
+    struct AABB
+    {
+        /// <summary>
+        /// コンストラクタ
+        /// </summary>
+        AABB();
+
+        /// <summary>
+        /// コンストラクタ
+        /// </summary>
+        /// <param name="minPos">最小座標</param>
+        /// <param name="maxPos">最大座標</param>
+        AABB(const VECTOR& minPos, const VECTOR& maxPos);
+
+        /// <summary>
+        /// 他の箱も囲むように広げる
+        /// </summary>
+        /// <param name="other">囲みたい箱</param>
+        void Merge(const AABB& other);
+
+        /// <summary>
+        /// 他の箱を完全に含んでいるか
+        /// </summary>
+        /// <param name="other">調べる箱</param>
+        /// <returns>含んでいる場合はtrueを返す</returns>
+        bool Contains(const AABB& other) const;
+
+        /// <summary>
+        /// 表面積の取得（木構造の挿入先を選ぶ評価値に使う）
+        /// </summary>
+        /// <returns>表面積</returns>
+        float GetSurfaceArea() const;
+
+        // 最小座標
+        VECTOR minPos;
+
+        // 最大座標
+        VECTOR maxPos;
+
+    };
+
+    /// <summary>
+    /// 線分を囲む境界箱の計算
+    /// </summary>
+    /// <param name="line">線分</param>
+    /// <returns>ワールド座標の境界箱</returns>
+    AABB CalcAABB(const LineSegment& line);
+
+    /// <summary>
+    /// 球体を囲む境界箱の計算
+    /// </summary>
+    /// <param name="sphere">球体</param>
+    /// <returns>ワールド座標の境界箱</returns>
+    AABB CalcAABB(const Sphere& sphere);
+
+    /// <summary>
+    /// カプセルを囲む境界箱の計算
+    /// </summary>
+    /// <param name="capsule">カプセル</param>
+    /// <returns>ワールド座標の境界箱</returns>
+    AABB CalcAABB(const Capsule& capsule);
+
+    /// <summary>
+    /// 移動する球の通る範囲を囲む境界箱の計算
+    /// </summary>
+    /// <param name="sweep">移動する球</param>
+    /// <returns>ワールド座標の境界箱</returns>
+    AABB CalcAABB(const SweptSphere& sweep);
+
+    /// <summary>
+    /// メッシュを囲む境界箱の計算
+    /// </summary>
+    /// <param name="mesh">メッシュ</param>
+    /// <returns>ワールド座標の境界箱</returns>
+    AABB CalcAABB(const MeshCollider& mesh);
+
+    /// <summary>
+    /// 境界箱対境界箱の当たり判定
+    /// </summary>
+    /// <param name="boxA">境界箱A</param>
+    /// <param name="boxB">境界箱B</param>
+    /// <returns>重なっている場合はtrueを返す</returns>
+    bool CollisionPair(const AABB& boxA, const AABB& boxB);
+
+    /// <summary>
+    /// 球体対球体の当たり判定
     /// </summary>
-    /// <param name="sphereA">A</param>
-    /// <param name="sphereB">B</param>
-    /// <returns>Փ˂ĂꍇtrueԂ</returns>
+    /// <param name="sphereA">球体A</param>
+    /// <param name="sphereB">球体B</param>
+    /// <returns>衝突している場合はtrueを返す</returns>
     bool CollisionPair(const Sphere& sphereA, const Sphere& sphereB);
 
     /// <summary>
-    /// ΋̂̓蔻
+    /// 線分対球体の当たり判定
     /// </summary>
-    /// <param name="line"></param>
-    /// <param name="sphere"></param>
-    /// <returns>Փ˂ĂꍇtrueԂ</returns>
+    /// <param name="line">線分</param>
+    /// <param name="sphere">球体</param>
+    /// <returns>衝突している場合はtrueを返す</returns>
     bool CollisionPair(const LineSegment& line, const Sphere& sphere);
 
     /// <summary>
-    /// ̑ΐ̓蔻
+    /// 球体対線分の当たり判定
     /// </summary>
-    /// <param name="sphere"></param>
-    /// <param name="line"></param>
-    /// <returns>Փ˂ĂꍇtrueԂ</returns>
+    /// <param name="sphere">球体</param>
+    /// <param name="line">線分</param>
+    /// <returns>衝突している場合はtrueを返す</returns>
     bool CollisionPair(const Sphere& sphere, const LineSegment& line);
 
     /// <summary>
-    ///   bV ̓蔻
+    /// カプセル対カプセルの当たり判定
+    /// </summary>
+    /// <param name="capsuleA">カプセルA</param>
+    /// <param name="capsuleB">カプセルB</param>
+    /// <returns>衝突している場合はtrueを返す</returns>
+    bool CollisionPair(const Capsule& capsuleA, const Capsule& capsuleB);
+
+    /// <summary>
+    /// カプセル対球体の当たり判定
+    /// </summary>
+    /// <param name="capsule">カプセル</param>
+    /// <param name="sphere">球体</param>
+    /// <returns>衝突している場合はtrueを返す</returns>
+    bool CollisionPair(const Capsule& capsule, const Sphere& sphere);
+
+    /// <summary>
+    /// 球体対カプセルの当たり判定
+    /// </summary>
+    /// <param name="sphere">球体</param>
+    /// <param name="capsule">カプセル</param>
+    /// <returns>衝突している場合はtrueを返す</returns>
+    bool CollisionPair(const Sphere& sphere, const Capsule& capsule);
+
+    /// <summary>
+    /// カプセル対線分の当たり判定
     /// </summary>
-    /// <param name="sphere"></param>
-    /// <param name="modelHandle">bṼfID</param>
-    /// <param name="collisionInfo">ꍇ̃|SA|SXg</param>
-    /// <returns>Փ˂ĂꍇtrueԂ</returns>
+    /// <param name="capsule">カプセル</param>
+    /// <param name="line">線分</param>
+    /// <returns>衝突している場合はtrueを返す</returns>
+    bool CollisionPair(const Capsule& capsule, const LineSegment& line);
+
+    /// <summary>
+    /// 線分対カプセルの当たり判定
+    /// </summary>
+    /// <param name="line">線分</param>
+    /// <param name="capsule">カプセル</param>
+    /// <returns>衝突している場合はtrueを返す</returns>
+    bool CollisionPair(const LineSegment& line, const Capsule& capsule);
+
+    /// <summary>
+    /// 移動する球対球体の当たり判定
+    /// </summary>
+    /// <param name="sweep">移動する球</param>
+    /// <param name="sphere">球体（止まっているものとして扱う）</param>
+    /// <param name="hitTime">最初に触れる時刻（移動の始点を0、今の位置を1とした割合）</param>
+    /// <returns>移動中に触れる場合はtrueを返す</returns>
+    bool CollisionPair(const SweptSphere& sweep, const Sphere& sphere, float& hitTime);
+
+    /// <summary>
+    /// 移動する球対カプセルの当たり判定
+    /// </summary>
+    /// <param name="sweep">移動する球</param>
+    /// <param name="capsule">カプセル（止まっているものとして扱う）</param>
+    /// <param name="hitTime">最初に触れる時刻（移動の始点を0、今の位置を1とした割合）</param>
+    /// <returns>移動中に触れる場合はtrueを返す</returns>
+    bool CollisionPair(const SweptSphere& sweep, const Capsule& capsule, float& hitTime);
+
+    /// <summary>
+    /// 移動する球対メッシュの当たり判定（ワーカースレッドからも呼べる）
+    /// </summary>
+    /// <param name="sweep">移動する球</param>
+    /// <param name="mesh">メッシュ</param>
+    /// <param name="hit">最初に触れる三角形の情報（hitRateは時刻、positionは触れたときの球の中心のワールド座標）</param>
+    /// <returns>移動中に触れる場合はtrueを返す</returns>
+    bool CollisionPair(const SweptSphere& sweep, const MeshCollider& mesh, MeshRayHit& hit);
+
+    /// <summary>
+    /// 球体 対 メッシュ の当たり判定
+    /// </summary>
+    /// <param name="sphere">球体</param>
+    /// <param name="modelHandle">メッシュのモデルID</param>
+    /// <param name="collisionInfo">当たった場合のポリゴン数、ポリゴンリスト</param>
+    /// <returns>衝突している場合はtrueを返す</returns>
     bool CollisionPair(const Sphere& sphere, const int modelHandle, MV1_COLL_RESULT_POLY_DIM& collisionInfo);
 
     /// <summary>
-    /// ΃bV̓蔻
+    /// 線分対メッシュの当たり判定
     /// </summary>
-    /// <param name="line"></param>
-    /// <param name="modelHandle">bṼfID</param>
-    /// <param name="collisionInfo">ꍇ̃|SA|SXg</param>
-    /// <returns>Փ˂ĂꍇtrueԂ</returns>
+    /// <param name="line">線分</param>
+    /// <param name="modelHandle">メッシュのモデルID</param>
+    /// <param name="collisionInfo">当たった場合のポリゴン数、ポリゴンリスト</param>
+    /// <returns>衝突している場合はtrueを返す</returns>
     bool CollisionPair(const LineSegment& line, const int modelHandle, MV1_COLL_RESULT_POLY& collisionInfo);
 
     /// <summary>
-    /// bVΐ̓蔻
+    /// メッシュ対線分の当たり判定
     /// </summary>
-    /// <param name="modelHandle">bṼfID</param>
-    /// <param name="line"></param>
-    /// <param name="collisionInfo">ꍇ̃|SA|SXg</param>
-    /// <returns>Փ˂ĂꍇtrueԂ</returns>
+    /// <param name="modelHandle">メッシュのモデルID</param>
+    /// <param name="line">線分</param>
+    /// <param name="collisionInfo">当たった場合のポリゴン数、ポリゴンリスト</param>
+    /// <returns>衝突している場合はtrueを返す</returns>
     bool CollisionPair(const int modelHandle, const LineSegment& line, MV1_COLL_RESULT_POLY& collisionInfo);
 
     /// <summary>
-    /// ̂ƃbVƂ̔̉߂ʌvZ
+    /// 球体とメッシュとの判定後の押し戻し量計算
     /// </summary>
-    /// <param name="sphere"></param>
-    /// <param name="collisionInfo">MV1CollCheck_Sphere()֐ԂՓˏ</param>
-    /// <returns>̂bV痣̈ړxNgԂ</returns>
+    /// <param name="sphere">球体</param>
+    /// <param name="collisionInfo">MV1CollCheck_Sphere()関数が返す衝突情報</param>
+    /// <returns>球体がメッシュから離れる向きの移動ベクトルを返す</returns>
     VECTOR CalcSpherePushBackVecFromMesh(const Sphere& sphere, const MV1_COLL_RESULT_POLY_DIM& collisionInfo);
 
+    /// <summary>
+    /// 球体対メッシュの当たり判定（ワーカースレッドからも呼べる）
+    /// </summary>
+    /// <param name="sphere">球体</param>
+    /// <param name="mesh">メッシュ</param>
+    /// <param name="hitList">当たった三角形の一覧（呼び出し側のバッファ）</param>
+    /// <returns>衝突している場合はtrueを返す</returns>
+    bool CollisionPair(const Sphere& sphere, const MeshCollider& mesh, MeshHitList& hitList);
+
+    /// <summary>
+    /// カプセル対メッシュの当たり判定（ワーカースレッドからも呼べる）
+    /// </summary>
+    /// <param name="capsule">カプセル</param>
+    /// <param name="mesh">メッシュ</param>
+    /// <param name="hitList">当たった三角形の一覧（呼び出し側のバッファ）</param>
+    /// <returns>衝突している場合はtrueを返す</returns>
+    bool CollisionPair(const Capsule& capsule, const MeshCollider& mesh, MeshHitList& hitList);
+
+    /// <summary>
+    /// 線分対メッシュの当たり判定（ワーカースレッドからも呼べる）
+    /// </summary>
+    /// <param name="line">線分</param>
+    /// <param name="mesh">メッシュ</param>
+    /// <param name="hit">始点に最も近い交点の情報（交点はワールド座標）</param>
+    /// <returns>衝突している場合はtrueを返す</returns>
+    bool CollisionPair(const LineSegment& line, const MeshCollider& mesh, MeshRayHit& hit);
+
+    /// <summary>
+    /// 球体とメッシュとの判定後の押し戻し量計算
+    /// </summary>
+    /// <param name="sphere">球体</param>
+    /// <param name="mesh">メッシュ</param>
+    /// <param name="hitList">CollisionPairが返した当たった三角形の一覧</param>
+    /// <returns>球体がメッシュから離れる向きの移動ベクトルを返す</returns>
+    VECTOR CalcSpherePushBackVecFromMesh(const Sphere& sphere, const MeshCollider& mesh, const MeshHitList& hitList);
+
+    /// <summary>
+    /// カプセルとメッシュとの判定後の押し戻し量計算
+    /// </summary>
+    /// <param name="capsule">カプセル</param>
+    /// <param name="mesh">メッシュ</param>
+    /// <param name="hitList">CollisionPairが返した当たった三角形の一覧</param>
+    /// <returns>カプセルがメッシュから離れる向きの移動ベクトルを返す</returns>
+    VECTOR CalcCapsulePushBackVecFromMesh(const Capsule& capsule, const MeshCollider& mesh, const MeshHitList& hitList);
+
+    /// <summary>
+    /// 線分上の点のうち、指定した点に最も近い点の計算
+    /// </summary>
+    /// <param name="point">点</param>
+    /// <param name="start">線分の始点</param>
+    /// <param name="end">線分の終点</param>
+    /// <returns>線分上の最近点</returns>
+    VECTOR CalcClosestPointOnSegment(const VECTOR& point, const VECTOR& start, const VECTOR& end);
+
+    /// <summary>
+    /// 三角形上の点のうち、指定した点に最も近い点の計算
+    /// </summary>
+    /// <param name="point">点</param>
+    /// <param name="a">三角形の頂点A</param>
+    /// <param name="b">三角形の頂点B</param>
+    /// <param name="c">三角形の頂点C</param>
+    /// <returns>三角形上の最近点</returns>
+    VECTOR CalcClosestPointOnTriangle(const VECTOR& point, const VECTOR& a, const VECTOR& b, const VECTOR& c);
+
+    /// <summary>
+    /// 線分と三角形の交差判定（表裏どちらからでも当たる）
+    /// </summary>
+    /// <param name="start">線分の始点</param>
+    /// <param name="end">線分の終点</param>
+    /// <param name="a">三角形の頂点A</param>
+    /// <param name="b">三角形の頂点B</param>
+    /// <param name="c">三角形の頂点C</param>
+    /// <param name="hitRate">交差する場合、始点からの交点の位置の割合（0～1）</param>
+    /// <returns>交差する場合はtrueを返す</returns>
+    bool IntersectSegmentTriangle(const VECTOR& start, const VECTOR& end, const VECTOR& a, const VECTOR& b, const VECTOR& c, float& hitRate);
+
+    /// <summary>
+    /// 線分と球の交差判定
+    /// </summary>
+    /// <param name="start">線分の始点</param>
+    /// <param name="end">線分の終点</param>
+    /// <param name="center">球の中心</param>
+    /// <param name="radius">球の半径</param>
+    /// <param name="hitRate">始点から最初に球に入る位置の割合（始点が球の中なら0）</param>
+    /// <returns>交差する場合はtrueを返す</returns>
+    bool IntersectSegmentSphere(const VECTOR& start, const VECTOR& end, const VECTOR& center, float radius, float& hitRate);
+
+    /// <summary>
+    /// 線分とカプセルの交差判定
+    /// </summary>
+    /// <param name="start">線分の始点</param>
+    /// <param name="end">線分の終点</param>
+    /// <param name="capsuleStart">カプセルの芯の始点</param>
+    /// <param name="capsuleEnd">カプセルの芯の終点</param>
+    /// <param name="radius">カプセルの半径</param>
+    /// <param name="hitRate">始点から最初にカプセルに入る位置の割合（始点がカプセルの中なら0）</param>
+    /// <returns>交差する場合はtrueを返す</returns>
+    bool IntersectSegmentCapsule(const VECTOR& start, const VECTOR& end, const VECTOR& capsuleStart, const VECTOR& capsuleEnd, float radius, float& hitRate);
+
+    /// <summary>
+    /// 移動する球と三角形の衝突時刻の計算
+    /// </summary>
+    /// <param name="start">球の中心の移動の始点</param>
+    /// <param name="end">球の中心の移動の終点</param>
+    /// <param name="radius">球の半径</param>
+    /// <param name="a">三角形の頂点A</param>
+    /// <param name="b">三角形の頂点B</param>
+    /// <param name="c">三角形の頂点C</param>
+    /// <param name="hitTime">最初に触れる時刻（始点を0、終点を1とした割合、始点で重なっていれば0）</param>
+    /// <returns>移動中に触れる場合はtrueを返す</returns>
+    bool IntersectSweptSphereTriangle(const VECTOR& start, const VECTOR& end, float radius, const VECTOR& a, const VECTOR& b, const VECTOR& c, float& hitTime);
+
+    /// <summary>
+    /// 線分同士の最短距離の2乗の計算
+    /// </summary>
+    /// <param name="start1">線分1の始点</param>
+    /// <param name="end1">線分1の終点</param>
+    /// <param name="start2">線分2の始点</param>
+    /// <param name="end2">線分2の終点</param>
+    /// <returns>最短距離の2乗</returns>
+    float CalcSegmentSegmentDistanceSquare(const VECTOR& start1, const VECTOR& end1, const VECTOR& start2, const VECTOR& end2);
+
+    /// <summary>
+    /// 線分同士の最も近い点の組の計算
+    /// </summary>
+    /// <param name="start1">線分1の始点</param>
+    /// <param name="end1">線分1の終点</param>
+    /// <param name="start2">線分2の始点</param>
+    /// <param name="end2">線分2の終点</param>
+    /// <param name="closest1">線分1上の最近点</param>
+    /// <param name="closest2">線分2上の最近点</param>
+    /// <returns>最短距離の2乗</returns>
+    float CalcClosestPointsSegmentSegment(const VECTOR& start1, const VECTOR& end1, const VECTOR& start2, const VECTOR& end2, VECTOR& closest1, VECTOR& closest2);
+
+    /// <summary>
+    /// 線分と三角形の最短距離の2乗の計算
+    /// </summary>
+    /// <param name="start">線分の始点</param>
+    /// <param name="end">線分の終点</param>
+    /// <param name="a">三角形の頂点A</param>
+    /// <param name="b">三角形の頂点B</param>
+    /// <param name="c">三角形の頂点C</param>
+    /// <returns>最短距離の2乗（交差していれば0）</returns>
+    float CalcSegmentTriangleDistanceSquare(const VECTOR& start, const VECTOR& end, const VECTOR& a, const VECTOR& b, const VECTOR& c);
+
 }// namespace My3dApp
\ No newline at end of file
@@ -0,0 +1,225 @@
+#include "CollisionMeshFile.h"
+#include <windows.h>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace My3dApp
+{
+    // ファイルの種類を表す文字
+    const char fileMagic[4] = { 'M', 'C', 'O', 'L' };
+
+    // 配列の位置のそろえ（4つ組をそのままSSEで読めるようにする）
+    const unsigned int sectionAlignment = 16;
+
+    CollisionMeshFile::CollisionMeshFile()
+        : fileHandle(INVALID_HANDLE_VALUE)
+        , mappingHandle(nullptr)
+        , view(nullptr)
+    {
+        // 処理なし
+    }
+
+    CollisionMeshFile::~CollisionMeshFile()
+    {
+        Close();
+    }
+
+    bool CollisionMeshFile::IsInside(unsigned int fileSize, unsigned int offset, unsigned long long num, unsigned int size, unsigned int alignment)
+    {
+        return offset % alignment == 0 && offset <= fileSize && num <= (fileSize - offset) / size;
+    }
+
+    bool CollisionMeshFile::Write(const char* fileName, const TriangleBVH& bvh, const HeightField& heightField)
+    {
+        const bool hasHeightField = heightField.IsValid();
+        const size_t cellNum = hasHeightField ? static_cast<size_t>(heightField.GetCellNumX()) * heightField.GetCellNumZ() : 0;
+        const size_t vertexNum = hasHeightField ? static_cast<size_t>(heightField.GetCellNumX() + 1) * (heightField.GetCellNumZ() + 1) : 0;
+
+        // 配列ごとにそろえた位置を決める
+        size_t fileSize = sizeof(Header);
+        auto place = [&fileSize](size_t num, size_t size)
+        {
+            fileSize = (fileSize + sectionAlignment - 1) / sectionAlignment * sectionAlignment;
+            const size_t offset = fileSize;
+            fileSize += num * size;
+            return offset;
+        };
+
+        const size_t nodeOffset = place(bvh.GetNodeNum(), sizeof(TriangleBVH::Node));
+        const size_t triangleOffset = place(bvh.GetTriangleNum(), sizeof(MeshTriangle));
+        const size_t packetOffset = place(bvh.GetPacketNum(), sizeof(TrianglePacket));
+        const size_t heightOffset = place(vertexNum, sizeof(float));
+        const size_t normalOffset = place(cellNum, sizeof(VECTOR));
+        const size_t fallbackOffset = place(cellNum, sizeof(unsigned char));
+
+        if (0xFFFFFFFFu < fileSize)
+        {
+            return false;
+        }
+
+        Header header = {};
+        memcpy(header.magic, fileMagic, sizeof(fileMagic));
+        header.version = version;
+        header.fileSize = static_cast<unsigned int>(fileSize);
+        header.nodeSize = sizeof(TriangleBVH::Node);
+        header.triangleSize = sizeof(MeshTriangle);
+        header.packetSize = sizeof(TrianglePacket);
+        header.nodeNum = bvh.GetNodeNum();
+        header.nodeOffset = static_cast<unsigned int>(nodeOffset);
+        header.triangleNum = bvh.GetTriangleNum();
+        header.triangleOffset = static_cast<unsigned int>(triangleOffset);
+        header.packetNum = bvh.GetPacketNum();
+        header.packetOffset = static_cast<unsigned int>(packetOffset);
+        header.cellSize = hasHeightField ? heightField.GetCellSize() : 0.0f;
+        header.originX = hasHeightField ? heightField.GetOrigin().x : 0.0f;
+        header.originZ = hasHeightField ? heightField.GetOrigin().z : 0.0f;
+        header.cellNumX = hasHeightField ? heightField.GetCellNumX() : 0;
+        header.cellNumZ = hasHeightField ? heightField.GetCellNumZ() : 0;
+        header.heightOffset = static_cast<unsigned int>(heightOffset);
+        header.normalOffset = static_cast<unsigned int>(normalOffset);
+        header.fallbackOffset = static_cast<unsigned int>(fallbackOffset);
+
+        // ファイルの中身をそのままの並びで組み立てて1回で書き出す（隙間は0で埋める）
+        vector<unsigned char> image(fileSize, 0);
+        auto copy = [&image](size_t offset, const void* data, size_t size)
+        {
+            if (size)
+            {
+                memcpy(&image[offset], data, size);
+            }
+        };
+
+        copy(0, &header, sizeof(Header));
+        copy(nodeOffset, bvh.GetNodeData(), bvh.GetNodeNum() * sizeof(TriangleBVH::Node));
+        copy(triangleOffset, bvh.GetTriangleNum() ? &bvh.GetTriangle(0) : nullptr, bvh.GetTriangleNum() * sizeof(MeshTriangle));
+        copy(packetOffset, bvh.GetPacketNum() ? &bvh.GetPacket(0) : nullptr, bvh.GetPacketNum() * sizeof(TrianglePacket));
+        copy(heightOffset, heightField.GetHeightData(), vertexNum * sizeof(float));
+        copy(normalOffset, heightField.GetNormalData(), cellNum * sizeof(VECTOR));
+        copy(fallbackOffset, heightField.GetFallbackData(), cellNum * sizeof(unsigned char));
+
+        ofstream file(fileName, ios::binary | ios::trunc);
+        file.write(reinterpret_cast<const char*>(image.data()), image.size());
+        return static_cast<bool>(file);
+    }
+
+    bool CollisionMeshFile::Open(const char* fileName, TriangleBVH& bvh, HeightField& heightField)
+    {
+        // 新しいファイルは手元のハンドルで割り当てて確かめ、使えると分かってから前のファイルと入れ替える
+        HANDLE newFileHandle = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        HANDLE newMappingHandle = nullptr;
+        const unsigned char* newView = nullptr;
+
+        auto discard = [&newFileHandle, &newMappingHandle, &newView]()
+        {
+            if (newView)
+            {
+                UnmapViewOfFile(newView);
+            }
+
+            if (newMappingHandle)
+            {
+                CloseHandle(newMappingHandle);
+            }
+
+            if (newFileHandle != INVALID_HANDLE_VALUE)
+            {
+                CloseHandle(newFileHandle);
+            }
+
+            return false;
+        };
+
+        if (newFileHandle == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(newFileHandle, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(Header)) || 0xFFFFFFFFll < fileSize.QuadPart)
+        {
+            return discard();
+        }
+
+        // 読み取り専用で割り当てる（ページはOSが必要になったときに読み込む）
+        newMappingHandle = CreateFileMappingA(newFileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        newView = newMappingHandle ? static_cast<const unsigned char*>(MapViewOfFile(newMappingHandle, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+        if (!newView)
+        {
+            return discard();
+        }
+
+        // 先頭の情報と木の節の並びを確かめ、中身は読み直さずにそのまま使う
+        const Header& header = *reinterpret_cast<const Header*>(newView);
+        const unsigned int size = static_cast<unsigned int>(fileSize.QuadPart);
+        const unsigned long long cellNum = static_cast<unsigned long long>(header.cellNumX) * header.cellNumZ;
+        const unsigned long long vertexNum = cellNum ? (header.cellNumX + 1ull) * (header.cellNumZ + 1ull) : 0;
+
+        const bool isValid = memcmp(header.magic, fileMagic, sizeof(fileMagic)) == 0
+            && header.version == version
+            && header.fileSize == size
+            && header.nodeSize == sizeof(TriangleBVH::Node)
+            && header.triangleSize == sizeof(MeshTriangle)
+            && header.packetSize == sizeof(TrianglePacket)
+            && header.nodeNum <= 0x7FFFFFFFu && header.triangleNum <= 0x7FFFFFFFu && header.packetNum <= 0x7FFFFFFFu
+            && IsInside(size, header.nodeOffset, header.nodeNum, sizeof(TriangleBVH::Node), sectionAlignment)
+            && IsInside(size, header.triangleOffset, header.triangleNum, sizeof(MeshTriangle), sectionAlignment)
+            && IsInside(size, header.packetOffset, header.packetNum, sizeof(TrianglePacket), sectionAlignment)
+            && (cellNum == 0 || (0.0f < header.cellSize && cellNum <= 0x7FFFFFFFu
+                && IsInside(size, header.heightOffset, vertexNum, sizeof(float), sectionAlignment)
+                && IsInside(size, header.normalOffset, cellNum, sizeof(VECTOR), sectionAlignment)
+                && IsInside(size, header.fallbackOffset, cellNum, sizeof(unsigned char), sectionAlignment)))
+            && TriangleBVH::IsValidTree(reinterpret_cast<const TriangleBVH::Node*>(newView + header.nodeOffset), static_cast<int>(header.nodeNum),
+                static_cast<int>(header.triangleNum), static_cast<int>(header.packetNum));
+
+        if (!isValid)
+        {
+            return discard();
+        }
+
+        bvh.Attach(reinterpret_cast<const TriangleBVH::Node*>(newView + header.nodeOffset), static_cast<int>(header.nodeNum),
+            reinterpret_cast<const MeshTriangle*>(newView + header.triangleOffset), static_cast<int>(header.triangleNum),
+            reinterpret_cast<const TrianglePacket*>(newView + header.packetOffset), static_cast<int>(header.packetNum));
+
+        if (cellNum)
+        {
+            heightField.Attach(header.cellSize, VGet(header.originX, 0.0f, header.originZ), static_cast<int>(header.cellNumX), static_cast<int>(header.cellNumZ),
+                reinterpret_cast<const float*>(newView + header.heightOffset),
+                reinterpret_cast<const VECTOR*>(newView + header.normalOffset),
+                newView + header.fallbackOffset);
+        }
+        else
+        {
+            heightField.Attach(1.0f, VGet(0.0f, 0.0f, 0.0f), 0, 0, nullptr, nullptr, nullptr);
+        }
+
+        // 前のファイルを解放して入れ替える
+        Close();
+        fileHandle = newFileHandle;
+        mappingHandle = newMappingHandle;
+        view = newView;
+
+        return true;
+    }
+
+    void CollisionMeshFile::Close()
+    {
+        if (view)
+        {
+            UnmapViewOfFile(view);
+            view = nullptr;
+        }
+
+        if (mappingHandle)
+        {
+            CloseHandle(mappingHandle);
+            mappingHandle = nullptr;
+        }
+
+        if (fileHandle != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(fileHandle);
+            fileHandle = INVALID_HANDLE_VALUE;
+        }
+    }
+}// namespace My3dApp
\ No newline at end of file
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "TriangleBVH.h"
+#include "HeightField.h"
+
+namespace My3dApp
+{
+    /// <summary>
+    /// 調理済みの当たり判定メッシュのファイル（三角形BVHと地面の高さの格子をそのままの並びで書き出したもの）
+    /// 位置はすべてファイル先頭からのずれで持つので、メモリに割り当てた領域を読み直さずにそのまま検索に使える
+    /// </summary>
+    class CollisionMeshFile final
+    {
+    public:
+        // ファイルの版（並びを変えたら上げる、違う版のファイルは読み込まない）
+        static const unsigned int version = 1;
+
+    private:
+        /// <summary>
+        /// ファイルの先頭に置く情報
+        /// </summary>
+        struct Header
+        {
+            // ファイルの種類を表す文字（"MCOL"）
+            char magic[4];
+
+            // ファイルの版
+            unsigned int version;
+
+            // ファイル全体の大きさ
+            unsigned int fileSize;
+
+            // 書き出したときの構造体の大きさ（読み込む側と違えば並びが違うので読み込まない）
+            unsigned int nodeSize;
+            unsigned int triangleSize;
+            unsigned int packetSize;
+
+            // 三角形BVHの節・三角形・4つ組の数とファイル先頭からの位置
+            unsigned int nodeNum;
+            unsigned int nodeOffset;
+            unsigned int triangleNum;
+            unsigned int triangleOffset;
+            unsigned int packetNum;
+            unsigned int packetOffset;
+
+            // 地面の高さの格子（セルの数が0なら持たない）
+            float cellSize;
+            float originX;
+            float originZ;
+            unsigned int cellNumX;
+            unsigned int cellNumZ;
+            unsigned int heightOffset;
+            unsigned int normalOffset;
+            unsigned int fallbackOffset;
+        };
+
+        // ファイルのハンドル（windows.hを広く読み込ませないよう、HANDLEと同じvoid*で持つ）
+        void* fileHandle;
+
+        // ファイルの割り当てのハンドル
+        void* mappingHandle;
+
+        // ファイルを割り当てた領域の先頭
+        const unsigned char* view;
+
+        /// <summary>
+        /// 配列の範囲がファイル内に収まっているか
+        /// </summary>
+        /// <param name="fileSize">ファイル全体の大きさ</param>
+        /// <param name="offset">ファイル先頭からの位置</param>
+        /// <param name="num">要素の数</param>
+        /// <param name="size">要素1つの大きさ</param>
+        /// <param name="alignment">位置のそろえ</param>
+        /// <returns>収まっていればtrueを返す</returns>
+        static bool IsInside(unsigned int fileSize, unsigned int offset, unsigned long long num, unsigned int size, unsigned int alignment);
+
+    public:
+        /// <summary>
+        /// コンストラクタ
+        /// </summary>
+        CollisionMeshFile();
+
+        /// <summary>
+        /// デストラクタ
+        /// </summary>
+        ~CollisionMeshFile();
+
+        // ハンドルを持つのでコピーしない
+        CollisionMeshFile(const CollisionMeshFile&) = delete;
+        CollisionMeshFile& operator=(const CollisionMeshFile&) = delete;
+
+        /// <summary>
+        /// 三角形BVHと地面の高さの格子をファイルに書き出す（調理ツールから呼ぶ）
+        /// </summary>
+        /// <param name="fileName">書き出すファイルのパス</param>
+        /// <param name="bvh">ローカル座標の三角形BVH</param>
+        /// <param name="heightField">ローカル座標の地面の高さの格子（作っていなければ書き出さない）</param>
+        /// <returns>書き出せた場合はtrueを返す</returns>
+        static bool Write(const char* fileName, const TriangleBVH& bvh, const HeightField& heightField);
+
+        /// <summary>
+        /// ファイルをメモリに割り当て、三角形BVHと地面の高さの格子がその領域を直接指すようにする
+        /// 割り当てた領域はCloseを呼ぶかこのオブジェクトが消えるまで残る
+        /// </summary>
+        /// <param name="fileName">読み込むファイルのパス</param>
+        /// <param name="bvh">ファイルの領域を指す三角形BVH</param>
+        /// <param name="heightField">ファイルの領域を指す地面の高さの格子（ファイルが持たない場合は空のまま）</param>
+        /// <returns>ファイルが無い・版や並びが違う・壊れている場合はfalseを返す（bvhとheightFieldと、前に割り当てていたファイルは変えない）</returns>
+        bool Open(const char* fileName, TriangleBVH& bvh, HeightField& heightField);
+
+        /// <summary>
+        /// 割り当てた領域の解放（Openで渡した三角形BVHと地面の高さの格子はこれより前に使い終えておく）
+        /// </summary>
+        void Close();
+
+        /// <summary>
+        /// ファイルを割り当てているか
+        /// </summary>
+        /// <returns>割り当てている場合はtrueを返す</returns>
+        bool IsOpen() const { return view != nullptr; }
+    };
+}// namespace My3dApp
\ No newline at end of file
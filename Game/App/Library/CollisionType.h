@@ -2,12 +2,13 @@
 
 namespace My3dApp
 {
-    // 蔻̌`̎
+    // 当たり判定の形状の種類
     enum class CollisionType
     {
-        Line,     // 
-        Sphere,   // 
-        Capsule,  // JvZ
-        Model,    // fibVj
+        Line,     // 線分
+        Sphere,   // 球体
+        Capsule,  // カプセル
+        SweptSphere, // 移動する球（速い弾の連続判定）
+        Model,    // モデル（メッシュ）
     };
 }// namespace My3dApp
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "ContactCache.h"
+#include <utility>
+
+namespace My3dApp
+{
+    // 表の最小の大きさ（2のべき乗）
+    const size_t minTableSize = 64;
+
+    ContactCache::ContactCache()
+        : contacts()
+        , tableKeys()
+        , tableContacts()
+        , frame(0)
+    {
+        // 処理なし
+    }
+
+    unsigned long long ContactCache::PairKey(int idA, int idB)
+    {
+        return (static_cast<unsigned long long>(static_cast<unsigned int>(idA)) << 32) | static_cast<unsigned int>(idB);
+    }
+
+    size_t ContactCache::TableSlot(unsigned long long key, size_t tableSize)
+    {
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 20) & (tableSize - 1);
+    }
+
+    void ContactCache::Clear()
+    {
+        contacts.clear();
+        tableKeys.assign(tableKeys.size(), ~0ull);
+    }
+
+    void ContactCache::SetArena(MemoryArena* arena)
+    {
+        RebindArena(contacts, arena);
+        RebindArena(tableKeys, arena);
+        RebindArena(tableContacts, arena);
+    }
+
+    void ContactCache::Rehash(size_t tableSize)
+    {
+        // 埋まり具合が半分を超えないようにする
+        if (tableSize < minTableSize)
+        {
+            tableSize = minTableSize;
+        }
+        while (tableSize < contacts.size() * 2)
+        {
+            tableSize *= 2;
+        }
+
+        tableKeys.assign(tableSize, ~0ull);
+        tableContacts.resize(tableSize);
+
+        for (size_t i = 0; i < contacts.size(); ++i)
+        {
+            const unsigned long long key = PairKey(contacts[i].idA, contacts[i].idB);
+
+            size_t slot = TableSlot(key, tableSize);
+            while (tableKeys[slot] != ~0ull)
+            {
+                slot = (slot + 1) & (tableSize - 1);
+            }
+
+            tableKeys[slot] = key;
+            tableContacts[slot] = static_cast<int>(i);
+        }
+    }
+
+    int ContactCache::Touch(int idA, unsigned int serialA, int idB, unsigned int serialB)
+    {
+        if (idB < idA)
+        {
+            swap(idA, idB);
+            swap(serialA, serialB);
+        }
+
+        if (tableKeys.size() < (contacts.size() + 1) * 2)
+        {
+            Rehash(tableKeys.size() * 2);
+        }
+
+        const unsigned long long key = PairKey(idA, idB);
+        const size_t tableSize = tableKeys.size();
+        size_t slot = TableSlot(key, tableSize);
+
+        while (tableKeys[slot] != ~0ull)
+        {
+            if (tableKeys[slot] == key)
+            {
+                Contact& contact = contacts[tableContacts[slot]];
+                contact.frame = frame;
+
+                // 登録番号が別のオブジェクトに使い回されていれば新しい組み合わせとして扱う
+                if (contact.serialA != serialA || contact.serialB != serialB)
+                {
+                    contact.serialA = serialA;
+                    contact.serialB = serialB;
+                    contact.isTested = false;
+                    contact.isTouching = false;
+                }
+                return tableContacts[slot];
+            }
+            slot = (slot + 1) & (tableSize - 1);
+        }
+
+        Contact contact;
+        contact.idA = idA;
+        contact.idB = idB;
+        contact.serialA = serialA;
+        contact.serialB = serialB;
+        contact.versionA = 0;
+        contact.versionB = 0;
+        contact.frame = frame;
+        contact.isTested = false;
+        contact.isTouching = false;
+
+        tableKeys[slot] = key;
+        tableContacts[slot] = static_cast<int>(contacts.size());
+        contacts.push_back(contact);
+
+        return tableContacts[slot];
+    }
+}// namespace My3dApp
\ No newline at end of file
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <vector>
+#include "MemoryArena.h"
+
+using namespace std;
+
+namespace My3dApp
+{
+    // 接触の変化の種類
+    enum class ContactEvent
+    {
+        Enter,  // 触れ始めた
+        Stay,   // 前のフレームから触れ続けている
+        Exit,   // 離れた
+    };
+
+    /// <summary>
+    /// 前のフレームまでの組み合わせの接触状態の記録（登録番号の組をキーにした開番地法の表）
+    /// 組み合わせとして見つからなくなったものはフレームの終わりに消す
+    /// </summary>
+    class ContactCache final
+    {
+    public:
+        /// <summary>
+        /// 組み合わせの接触状態
+        /// </summary>
+        struct Contact
+        {
+            // 登録番号（idA < idB）
+            int idA;
+            int idB;
+
+            // 登録番号を使い回したときに別物と見分けるための通し番号
+            unsigned int serialA;
+            unsigned int serialB;
+
+            // 前回判定したときの当たり判定位置の版
+            unsigned int versionA;
+            unsigned int versionB;
+
+            // 最後に組み合わせとして見つかったフレーム
+            unsigned int frame;
+
+            // 前回の判定結果を持っているか
+            bool isTested;
+
+            // 触れているか
+            bool isTouching;
+        };
+
+    private:
+        // 接触状態の並び
+        ArenaVector<Contact> contacts;
+
+        // 組み合わせのキーから接触状態の添字を引く表（開番地法）
+        ArenaVector<unsigned long long> tableKeys;
+        ArenaVector<int> tableContacts;
+
+        // フレーム番号
+        unsigned int frame;
+
+        /// <summary>
+        /// 登録番号の組を1つのキーに詰める
+        /// </summary>
+        static unsigned long long PairKey(int idA, int idB);
+
+        /// <summary>
+        /// キーの表の位置の計算
+        /// </summary>
+        /// <param name="key">組み合わせのキー</param>
+        /// <param name="tableSize">表の大きさ（2のべき乗）</param>
+        /// <returns>表の位置</returns>
+        static size_t TableSlot(unsigned long long key, size_t tableSize);
+
+        /// <summary>
+        /// 表の作り直し
+        /// </summary>
+        /// <param name="tableSize">表の大きさ（2のべき乗）</param>
+        void Rehash(size_t tableSize);
+
+    public:
+        /// <summary>
+        /// コンストラクタ
+        /// </summary>
+        ContactCache();
+
+        /// <summary>
+        /// すべての接触状態の削除（確保した領域は残す）
+        /// </summary>
+        void Clear();
+
+        /// <summary>
+        /// 記録の確保元の変更（記録は新しい確保元に移す）
+        /// </summary>
+        /// <param name="arena">確保元のアリーナ（nullptrならヒープ）</param>
+        void SetArena(MemoryArena* arena);
+
+        /// <summary>
+        /// 1フレーム分の記録の開始
+        /// </summary>
+        void BeginFrame() { ++frame; }
+
+        /// <summary>
+        /// 組み合わせの接触状態を引き、今回のフレームで見つかった印をつける
+        /// 無い場合と通し番号が変わっていた場合は、判定結果のない離れた状態にする
+        /// </summary>
+        /// <param name="idA">登録番号</param>
+        /// <param name="serialA">通し番号</param>
+        /// <param name="idB">登録番号</param>
+        /// <param name="serialB">通し番号</param>
+        /// <returns>接触状態の添字（次にTouchを呼ぶまで有効）</returns>
+        int Touch(int idA, unsigned int serialA, int idB, unsigned int serialB);
+
+        /// <summary>
+        /// 接触状態の取得
+        /// </summary>
+        /// <param name="index">Touchが返した添字</param>
+        /// <returns>接触状態</returns>
+        Contact& GetContact(int index) { return contacts[index]; }
+
+        /// <summary>
+        /// 条件に合う接触状態の削除
+        /// </summary>
+        /// <param name="func">消す場合にtrueを返す処理 bool(const Contact&)</param>
+        template<class Func>
+        void RemoveIf(Func func)
+        {
+            size_t keepNum = 0;
+            for (size_t i = 0; i < contacts.size(); ++i)
+            {
+                if (!func(static_cast<const Contact&>(contacts[i])))
+                {
+                    contacts[keepNum++] = contacts[i];
+                }
+            }
+
+            if (keepNum != contacts.size())
+            {
+                contacts.resize(keepNum);
+                Rehash(tableKeys.size());
+            }
+        }
+
+        /// <summary>
+        /// 1フレーム分の記録の終了（今回見つからなかった組み合わせを消す）
+        /// </summary>
+        /// <param name="onExit">触れていた組み合わせを消すときの処理 void(const Contact&)</param>
+        template<class Func>
+        void EndFrame(Func onExit)
+        {
+            const unsigned int currentFrame = frame;
+            RemoveIf([currentFrame, &onExit](const Contact& contact)
+            {
+                if (contact.frame == currentFrame)
+                {
+                    return false;
+                }
+
+                if (contact.isTouching)
+                {
+                    onExit(contact);
+                }
+                return true;
+            });
+        }
+
+        /// <summary>
+        /// 記録している組み合わせの数の取得
+        /// </summary>
+        /// <returns>組み合わせの数</returns>
+        int GetContactNum() const { return static_cast<int>(contacts.size()); }
+    };
+}// namespace My3dApp
\ No newline at end of file
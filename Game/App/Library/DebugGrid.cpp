@@ -5,22 +5,22 @@ namespace My3dApp
 {
     void DrawGrid(float groundSize, int divideNum)
     {
-        // n_
+        // 始点
         VECTOR start = VGet(0, 0, 0);
 
-        // I_
+        // 終点
         VECTOR end = VGet(0, 0, 0);
 
-        // ̐F
+        // 線の色
         int lineColor = GetColor(0, 128, 0);
 
-        // Obh͈͂̔̕
+        // グリッド線を引く範囲の半分の幅
         float halfWidth = groundSize * 0.5f;
 
-        // ObhԊu
+        // グリッド線を引く間隔
         float addWidth = groundSize / (float)divideNum;
 
-        // c
+        // 縦線を引く
         start.z = -halfWidth;
         end.z = +halfWidth;
         for (int ix = 0; ix < divideNum + 1; ix++)
@@ -30,7 +30,7 @@ namespace My3dApp
             DrawLine3D(start, end, lineColor);
         }
 
-        // 
+        // 横線
         start.x = -halfWidth;
         end.x = +halfWidth;
         for (int iz = 0; iz < divideNum + 1; iz++)
@@ -3,10 +3,10 @@
 namespace My3dApp
 {
     /// <summary>
-    /// Obh̕`
+    /// グリッド線の描画
     /// </summary>
-    /// <param name="groundSize">L</param>
-    /// <param name="divideNum"></param>
+    /// <param name="groundSize">広さ</param>
+    /// <param name="divideNum">分割数</param>
     void DrawGrid(float groundSize, int divideNum);
 
 }// namespace My3dApp
\ No newline at end of file
@@ -10,22 +10,22 @@ namespace My3dApp
 
     const unsigned int BIT_FLAG[] =
     {
-        (1 << 0),   // fW^{^
-        (1 << 1),   // fW^{^
-        (1 << 2),   // fW^{^
-        (1 << 3),   // fW^{^E
-        (1 << 4),   // START{^
-        (1 << 5),   // BACK{^
-        (1 << 6),   // XeBbN
-        (1 << 7),   // EXeBbN
-        (1 << 8),   // LB{^
-        (1 << 9),   // RB{^
-        (1 << 10),  // UȂ
-        (1 << 11),  // UȂ
-        (1 << 12),  // A{^
-        (1 << 13),  // B{^
-        (1 << 14),  // X{^
-        (1 << 15),  // Y{^
+        (1 << 0),   // デジタル方向ボタン上
+        (1 << 1),   // デジタル方向ボタン下
+        (1 << 2),   // デジタル方向ボタン左
+        (1 << 3),   // デジタル方向ボタン右
+        (1 << 4),   // STARTボタン
+        (1 << 5),   // BACKボタン
+        (1 << 6),   // 左スティック押し込み
+        (1 << 7),   // 右スティック押し込み
+        (1 << 8),   // LBボタン
+        (1 << 9),   // RBボタン
+        (1 << 10),  // 割り振りなし
+        (1 << 11),  // 割り振りなし
+        (1 << 12),  // Aボタン
+        (1 << 13),  // Bボタン
+        (1 << 14),  // Xボタン
+        (1 << 15),  // Yボタン
     };
 
     GamePad::GamePad()
@@ -59,7 +59,7 @@ namespace My3dApp
     {
         GetJoypadXInputState(DX_INPUT_KEY_PAD1, &padState);
 
-        // S{^̓͊mF
+        // 全ボタンの入力確認
         for (int i = 0; i < 16; i++)
         {
             if (padState.Buttons[i])
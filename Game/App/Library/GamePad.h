@@ -7,106 +7,106 @@ using namespace std;
 namespace My3dApp
 {
     /// <summary>
-    /// Q[pbhNX
+    /// ゲームパッドクラス
     /// </summary>
     class GamePad final
     {
     private:
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
         GamePad();
 
         /// <summary>
-        /// fXgN^
+        /// デストラクタ
         /// </summary>
         ~GamePad();
 
-        // Q[pbhNX̗B̃CX^X
+        // ゲームパッドクラスの唯一のインスタンス
         static GamePad* instance;
 
-        // pbh̓͏
+        // パッドの入力状態
         static XINPUT_STATE padState;
 
-        // {^͎̓ʗp
+        // ボタンの入力識別用
         static int buttonInput;
 
     public:
         /// <summary>
-        /// CX^X̐
+        /// インスタンスの生成
         /// </summary>
         static void CreateInstance();
 
         /// <summary>
-        /// CX^X̍폜
+        /// インスタンスの削除
         /// </summary>
         static void DeleteInstance();
 
         /// <summary>
-        /// Q[pbh̍XV
+        /// ゲームパッドの更新
         /// </summary>
         static void Update();
 
-        // {^̗񋓌^i}WbNio[pj
+        // ボタンの列挙型（マジックナンバー回避用）
         enum ButtonNum
         {
-            UP = 0,  // fW^{^
-            DOWN,    // fW^{^
-            LEFT,    // fW^{^
-            RIGHT,   // fW^{^E
-            START,   // START{^
-            BACK,    // BACK{^
-            LSTICK,  // XeBbN
-            RSTICK,  // EXeBbN
-            LB,      // LB{^
-            RB,      // RB{^
-            NONE1,   // UȂ
-            NONE2,   // UȂ
-            A,       // A{^
-            B,       // B{^
-            X,       // X{^
-            Y,       // Y{^
+            UP = 0,  // デジタル方向ボタン上
+            DOWN,    // デジタル方向ボタン下
+            LEFT,    // デジタル方向ボタン左
+            RIGHT,   // デジタル方向ボタン右
+            START,   // STARTボタン
+            BACK,    // BACKボタン
+            LSTICK,  // 左スティック押し込み
+            RSTICK,  // 右スティック押し込み
+            LB,      // LBボタン
+            RB,      // RBボタン
+            NONE1,   // 割り振りなし
+            NONE2,   // 割り振りなし
+            A,       // Aボタン
+            B,       // Bボタン
+            X,       // Xボタン
+            Y,       // Yボタン
         };
 
         /// <summary>
-        /// {^̓͏Ԃ̎擾
+        /// ボタンの入力状態の取得
         /// </summary>
-        /// <param name="buttonNumber">擾{^</param>
-        /// <returns>͂Ătrue łȂfalse</returns>
+        /// <param name="buttonNumber">取得したいボタン</param>
+        /// <returns>入力されていたらtrue そうでなければfalse</returns>
         static bool GetInput(const int buttonNumber);
 
         /// <summary>
-        /// gK[̎擾
+        /// 左トリガーの取得
         /// </summary>
         /// <returns></returns>
         static const unsigned char GetLeftTrigger() { return padState.LeftTrigger; }
 
         /// <summary>
-        /// EgK[̎擾
+        /// 右トリガーの取得
         /// </summary>
         /// <returns></returns>
         static const unsigned char GetRightTrigger() { return padState.RightTrigger; }
 
         /// <summary>
-        /// XeBbNXW
+        /// 左スティックのX座標
         /// </summary>
         /// <returns></returns>
         static const short GetLeftStickX() { return padState.ThumbLX; }
 
         /// <summary>
-        /// XeBbNYW
+        /// 左スティックのY座標
         /// </summary>
         /// <returns></returns>
         static const short GetLeftStickY() { return padState.ThumbLY; }
 
         /// <summary>
-        /// EXeBbNXW
+        /// 右スティックのX座標
         /// </summary>
         /// <returns></returns>
         static const short GetRightStickX() { return padState.ThumbRX; }
 
         /// <summary>
-        /// EXeBbNYW
+        /// 右スティックのY座標
         /// </summary>
         /// <returns></returns>
         static const short GetRightStickY() { return padState.ThumbRY; }
@@ -0,0 +1,345 @@
+#include "HeightField.h"
+#include <algorithm>
+#include <cmath>
+#include "Calc3D.h"
+
+namespace My3dApp
+{
+    // 面をたどるときに、当たった面のすぐ下から調べ直す距離
+    const float scanStep = 0.01f;
+
+    // 格子のセル数の上限（超える場合はセルを広げる）
+    const long long maxCellNum = 1 << 22;
+
+    /// <summary>
+    /// 上から見た三角形と長方形の重なり判定（分離軸判定）
+    /// </summary>
+    /// <param name="triangle">三角形</param>
+    /// <param name="minX">長方形の最小のx座標</param>
+    /// <param name="minZ">長方形の最小のz座標</param>
+    /// <param name="maxX">長方形の最大のx座標</param>
+    /// <param name="maxZ">長方形の最大のz座標</param>
+    /// <returns>重なっている場合はtrueを返す</returns>
+    static bool OverlapTriangleRect(const MeshTriangle& triangle, float minX, float minZ, float maxX, float maxZ)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            const VECTOR& p = triangle.position[i];
+            const VECTOR& q = triangle.position[(i + 1) % 3];
+            const VECTOR& r = triangle.position[(i + 2) % 3];
+
+            // 辺に垂直な軸（長さ0の辺は軸にならない）
+            const float axisX = q.z - p.z;
+            const float axisZ = p.x - q.x;
+            if (axisX == 0.0f && axisZ == 0.0f)
+            {
+                continue;
+            }
+
+            const float edgeDot = p.x * axisX + p.z * axisZ;
+            const float otherDot = r.x * axisX + r.z * axisZ;
+            const float triangleMin = min(edgeDot, otherDot);
+            const float triangleMax = max(edgeDot, otherDot);
+
+            // 長方形の4つの角を軸に投影した範囲
+            const float rectDotX0 = minX * axisX;
+            const float rectDotX1 = maxX * axisX;
+            const float rectDotZ0 = minZ * axisZ;
+            const float rectDotZ1 = maxZ * axisZ;
+            const float rectMin = min(rectDotX0, rectDotX1) + min(rectDotZ0, rectDotZ1);
+            const float rectMax = max(rectDotX0, rectDotX1) + max(rectDotZ0, rectDotZ1);
+
+            if (rectMax < triangleMin || triangleMax < rectMin)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    HeightField::HeightField()
+        : cellSize(1.0f)
+        , invCellSize(1.0f)
+        , origin()
+        , cellNumX(0)
+        , cellNumZ(0)
+        , heights()
+        , normals()
+        , isFallback()
+        , heightData(nullptr)
+        , normalData(nullptr)
+        , fallbackData(nullptr)
+    {
+        // 処理なし
+    }
+
+    bool HeightField::ScanSurface(const TriangleBVH& bvh, float x, float z, float top, float bottom, float minNormalY, float& height, VECTOR& normal)
+    {
+        MeshRayHit hit;
+        if (!bvh.Raycast(VGet(x, top, z), VGet(x, bottom, z), hit))
+        {
+            return false;
+        }
+
+        height = hit.position.y;
+        normal = hit.normal;
+
+        if (fabsf(normal.y) < minNormalY)
+        {
+            return false;
+        }
+
+        // 最も上の面と同じ向きの歩ける面がさらに下にあれば張り出し（上の面の下にも立てる場所がある）
+        // 逆向きの面は床の裏側なので数えない
+        float startY = height - scanStep;
+        while (bottom < startY && bvh.Raycast(VGet(x, startY, z), VGet(x, bottom, z), hit))
+        {
+            if (minNormalY <= fabsf(hit.normal.y) && 0.0f < hit.normal.y * normal.y)
+            {
+                return false;
+            }
+            startY = hit.position.y - scanStep;
+        }
+
+        return true;
+    }
+
+    float HeightField::Interpolate(int cellX, int cellZ, float rateX, float rateZ) const
+    {
+        const int vertexNumX = cellNumX + 1;
+        const float* row0 = &heightData[cellZ * vertexNumX + cellX];
+        const float* row1 = row0 + vertexNumX;
+
+        const float height0 = row0[0] + (row0[1] - row0[0]) * rateX;
+        const float height1 = row1[0] + (row1[1] - row1[0]) * rateX;
+        return height0 + (height1 - height0) * rateZ;
+    }
+
+    void HeightField::Build(const TriangleBVH& bvh, float cellSize, float minNormalY, float tolerance, float stepHeight)
+    {
+        Attach(cellSize, VGet(0.0f, 0.0f, 0.0f), 0, 0, nullptr, nullptr, nullptr);
+
+        if (bvh.GetTriangleNum() == 0)
+        {
+            return;
+        }
+
+        const AABB bounds = bvh.GetBounds();
+        const float sizeX = bounds.maxPos.x - bounds.minPos.x;
+        const float sizeZ = bounds.maxPos.z - bounds.minPos.z;
+
+        // 格子が大きくなりすぎる場合はセルを広げる
+        while (maxCellNum < static_cast<long long>(ceilf(sizeX / cellSize) + 1) * static_cast<long long>(ceilf(sizeZ / cellSize) + 1))
+        {
+            cellSize *= 2.0f;
+        }
+
+        this->cellSize = cellSize;
+        invCellSize = 1.0f / cellSize;
+        origin = VGet(bounds.minPos.x, 0.0f, bounds.minPos.z);
+        cellNumX = max(1, static_cast<int>(ceilf(sizeX * invCellSize)));
+        cellNumZ = max(1, static_cast<int>(ceilf(sizeZ * invCellSize)));
+
+        const int vertexNumX = cellNumX + 1;
+        const int cellNum = cellNumX * cellNumZ;
+        const float top = bounds.maxPos.y + cellSize;
+        const float bottom = bounds.minPos.y - cellSize;
+
+        // 格子点ごとに最も上の面を調べる
+        heights.resize(vertexNumX * (cellNumZ + 1));
+        heightData = heights.data();
+        vector<VECTOR> vertexNormals(heights.size());
+        vector<unsigned char> isVertexValid(heights.size());
+
+        for (int z = 0; z <= cellNumZ; ++z)
+        {
+            for (int x = 0; x <= cellNumX; ++x)
+            {
+                const int index = z * vertexNumX + x;
+                isVertexValid[index] = ScanSurface(bvh, origin.x + x * cellSize, origin.z + z * cellSize,
+                    top, bottom, minNormalY, heights[index], vertexNormals[index]);
+            }
+        }
+
+        // 角がすべて同じ向きの1つの歩ける面にあり、中心の実際の高さが補間と合うセルだけ格子で答える
+        normals.assign(cellNum, VGet(0.0f, 1.0f, 0.0f));
+        isFallback.assign(cellNum, 1);
+        vector<float> facings(cellNum, 0.0f);
+        vector<float> minHeights(cellNum, 0.0f);
+        vector<float> maxHeights(cellNum, 0.0f);
+
+        for (int z = 0; z < cellNumZ; ++z)
+        {
+            for (int x = 0; x < cellNumX; ++x)
+            {
+                const int cell = z * cellNumX + x;
+                const int corners[4] = { z * vertexNumX + x, z * vertexNumX + x + 1, (z + 1) * vertexNumX + x, (z + 1) * vertexNumX + x + 1 };
+
+                const float facing = vertexNormals[corners[0]].y < 0.0f ? -1.0f : 1.0f;
+                VECTOR normalSum = VGet(0.0f, 0.0f, 0.0f);
+                bool isValid = true;
+
+                for (int corner : corners)
+                {
+                    isValid = isValid && isVertexValid[corner] && 0.0f < vertexNormals[corner].y * facing;
+                    normalSum += VScale(vertexNormals[corner], facing);
+                }
+
+                float centerHeight;
+                VECTOR centerNormal;
+                if (!isValid || !ScanSurface(bvh, origin.x + (x + 0.5f) * cellSize, origin.z + (z + 0.5f) * cellSize,
+                    top, bottom, minNormalY, centerHeight, centerNormal)
+                    || centerNormal.y * facing <= 0.0f || tolerance < fabsf(centerHeight - Interpolate(x, z, 0.5f, 0.5f)))
+                {
+                    continue;
+                }
+
+                isFallback[cell] = 0;
+                normals[cell] = VNorm(normalSum);
+                facings[cell] = facing;
+                minHeights[cell] = min(centerHeight, min(min(heights[corners[0]], heights[corners[1]]), min(heights[corners[2]], heights[corners[3]])));
+                maxHeights[cell] = max(centerHeight, max(max(heights[corners[0]], heights[corners[1]]), max(heights[corners[2]], heights[corners[3]])));
+            }
+        }
+
+        // 三角形ごとに重なるセルを調べ、急な面やセルより小さな凹凸があるセルはメッシュとの判定に任せる
+        for (int i = 0; i < bvh.GetTriangleNum(); ++i)
+        {
+            const MeshTriangle& triangle = bvh.GetTriangle(i);
+            const VECTOR& a = triangle.position[0];
+            const VECTOR& b = triangle.position[1];
+            const VECTOR& c = triangle.position[2];
+
+            const float minY = min(a.y, min(b.y, c.y));
+            const float maxY = max(a.y, max(b.y, c.y));
+            const bool isSteep = fabsf(triangle.normal.y) < minNormalY;
+
+            const int minCellX = max(0, static_cast<int>(floorf((min(a.x, min(b.x, c.x)) - origin.x) * invCellSize)));
+            const int minCellZ = max(0, static_cast<int>(floorf((min(a.z, min(b.z, c.z)) - origin.z) * invCellSize)));
+            const int maxCellX = min(cellNumX - 1, static_cast<int>(floorf((max(a.x, max(b.x, c.x)) - origin.x) * invCellSize)));
+            const int maxCellZ = min(cellNumZ - 1, static_cast<int>(floorf((max(a.z, max(b.z, c.z)) - origin.z) * invCellSize)));
+
+            for (int z = minCellZ; z <= maxCellZ; ++z)
+            {
+                for (int x = minCellX; x <= maxCellX; ++x)
+                {
+                    const int cell = z * cellNumX + x;
+                    const float cellMinX = origin.x + x * cellSize;
+                    const float cellMinZ = origin.z + z * cellSize;
+
+                    if (isFallback[cell] || !OverlapTriangleRect(triangle, cellMinX, cellMinZ, cellMinX + cellSize, cellMinZ + cellSize))
+                    {
+                        continue;
+                    }
+
+                    // 地面から足元の線分が届く高さまでにかかる急な面（壁や段差）
+                    if (isSteep)
+                    {
+                        if (minY <= maxHeights[cell] + stepHeight && minHeights[cell] - tolerance <= maxY)
+                        {
+                            isFallback[cell] = 1;
+                        }
+                        continue;
+                    }
+
+                    // 逆向きの面は床の裏側なので上からは当たらない
+                    if (triangle.normal.y * facings[cell] <= 0.0f)
+                    {
+                        continue;
+                    }
+
+                    // セル内にある頂点が補間した高さから離れていれば、格子より小さな凹凸がある
+                    for (const VECTOR& position : triangle.position)
+                    {
+                        const float rateX = (position.x - cellMinX) * invCellSize;
+                        const float rateZ = (position.z - cellMinZ) * invCellSize;
+
+                        if (0.0f <= rateX && rateX <= 1.0f && 0.0f <= rateZ && rateZ <= 1.0f
+                            && tolerance < fabsf(position.y - Interpolate(x, z, rateX, rateZ)))
+                        {
+                            isFallback[cell] = 1;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        normalData = normals.data();
+        fallbackData = isFallback.data();
+    }
+
+    void HeightField::Attach(float cellSize, const VECTOR& origin, int cellNumX, int cellNumZ, const float* heights, const VECTOR* normals, const unsigned char* fallbacks)
+    {
+        // 自身で作った格子の領域は解放する
+        vector<float>().swap(this->heights);
+        vector<VECTOR>().swap(this->normals);
+        vector<unsigned char>().swap(isFallback);
+
+        this->cellSize = cellSize;
+        invCellSize = 1.0f / cellSize;
+        this->origin = origin;
+        this->cellNumX = cellNumX;
+        this->cellNumZ = cellNumZ;
+        heightData = heights;
+        normalData = normals;
+        fallbackData = fallbacks;
+    }
+
+    bool HeightField::Sample(float x, float z, float& height, VECTOR& normal) const
+    {
+        const float cellX = (x - origin.x) * invCellSize;
+        const float cellZ = (z - origin.z) * invCellSize;
+
+        // 範囲外（NaNも含む）
+        if (!(0.0f <= cellX && cellX <= cellNumX && 0.0f <= cellZ && cellZ <= cellNumZ))
+        {
+            return false;
+        }
+
+        const int indexX = min(static_cast<int>(cellX), cellNumX - 1);
+        const int indexZ = min(static_cast<int>(cellZ), cellNumZ - 1);
+        const int cell = indexZ * cellNumX + indexX;
+
+        if (fallbackData[cell])
+        {
+            return false;
+        }
+
+        height = Interpolate(indexX, indexZ, cellX - indexX, cellZ - indexZ);
+        normal = normalData[cell];
+        return true;
+    }
+
+    bool HeightField::RaycastDown(const VECTOR& start, const VECTOR& end, bool& isHit, MeshRayHit& hit) const
+    {
+        if (start.x != end.x || start.z != end.z || start.y < end.y)
+        {
+            return false;
+        }
+
+        float height;
+        VECTOR normal;
+        if (!Sample(start.x, start.z, height, normal))
+        {
+            return false;
+        }
+
+        isHit = end.y <= height && height <= start.y;
+        if (isHit)
+        {
+            hit.triangle = -1;
+            hit.hitRate = end.y < start.y ? (start.y - height) / (start.y - end.y) : 0.0f;
+            hit.position = VGet(start.x, height, start.z);
+            hit.normal = normal;
+        }
+
+        return true;
+    }
+
+    int HeightField::GetFallbackCellNum() const
+    {
+        return static_cast<int>(count(fallbackData, fallbackData + cellNumX * cellNumZ, 1));
+    }
+}// namespace My3dApp
\ No newline at end of file
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <vector>
+#include "DxLib.h"
+#include "TriangleBVH.h"
+
+using namespace std;
+
+namespace My3dApp
+{
+    /// <summary>
+    /// メッシュの歩ける面を上から見下ろした高さの格子（読み込み時に三角形BVHから1回だけ作る）
+    /// 格子点の高さを双線形補間して地面の高さを定数時間で求める
+    /// 張り出し・急な面・補間で表せない凹凸があるセルは、線分とメッシュの判定に任せる印をつける
+    /// </summary>
+    class HeightField final
+    {
+    private:
+        // セル1辺の長さ
+        float cellSize;
+
+        // セル1辺の長さの逆数
+        float invCellSize;
+
+        // 格子の最小の角のローカル座標（yは使わない）
+        VECTOR origin;
+
+        // セルの数
+        int cellNumX;
+        int cellNumZ;
+
+        // 格子点の高さ（z方向の行ごとに、cellNumX + 1個ずつ並べる）
+        vector<float> heights;
+
+        // セルの面の法線（上向きにそろえたもの）
+        vector<VECTOR> normals;
+
+        // セルごとに、高さの格子で答えられずメッシュとの判定に任せるか
+        vector<unsigned char> isFallback;
+
+        // 検索で使う格子点の高さ・セルの法線・セルの印の先頭（自身で作った場合は上の配列、読み込んだ場合はファイルの領域を指す）
+        const float* heightData;
+        const VECTOR* normalData;
+        const unsigned char* fallbackData;
+
+        /// <summary>
+        /// 真上から真下への線分で面を上から順にたどり、最も上の面を調べる
+        /// </summary>
+        /// <param name="bvh">三角形BVH</param>
+        /// <param name="x">調べる位置のx座標</param>
+        /// <param name="z">調べる位置のz座標</param>
+        /// <param name="top">線分の始点の高さ</param>
+        /// <param name="bottom">線分の終点の高さ</param>
+        /// <param name="minNormalY">歩ける面の法線のy成分の最小値</param>
+        /// <param name="height">最も上の面の高さ</param>
+        /// <param name="normal">最も上の面の法線（メッシュの向きのまま）</param>
+        /// <returns>最も上の面が歩ける面で、その下に同じ向きの歩ける面が無い場合はtrueを返す</returns>
+        static bool ScanSurface(const TriangleBVH& bvh, float x, float z, float top, float bottom, float minNormalY, float& height, VECTOR& normal);
+
+        /// <summary>
+        /// セル内の双線形補間した高さ
+        /// </summary>
+        /// <param name="cellX">セルのx方向の番号</param>
+        /// <param name="cellZ">セルのz方向の番号</param>
+        /// <param name="rateX">セル内のx方向の位置の割合（0～1）</param>
+        /// <param name="rateZ">セル内のz方向の位置の割合（0～1）</param>
+        /// <returns>補間した高さ</returns>
+        float Interpolate(int cellX, int cellZ, float rateX, float rateZ) const;
+
+    public:
+        /// <summary>
+        /// コンストラクタ
+        /// </summary>
+        HeightField();
+
+        // 外部の領域を指すことがあるのでコピーしない
+        HeightField(const HeightField&) = delete;
+        HeightField& operator=(const HeightField&) = delete;
+
+        /// <summary>
+        /// 三角形BVHから高さの格子を作る
+        /// </summary>
+        /// <param name="bvh">ローカル座標の三角形BVH</param>
+        /// <param name="cellSize">セル1辺の長さ</param>
+        /// <param name="minNormalY">歩ける面の法線のy成分の最小値（これより急な面はメッシュとの判定に任せる）</param>
+        /// <param name="tolerance">補間した高さと実際の面との許容する誤差</param>
+        /// <param name="stepHeight">足元の線分が地面より上に伸びる長さ（これより高い位置だけにある急な面は地面合わせに影響しない）</param>
+        void Build(const TriangleBVH& bvh, float cellSize, float minNormalY = 0.7f, float tolerance = 1.0f, float stepHeight = 50.0f);
+
+        /// <summary>
+        /// 外部の領域（調理済みファイルを割り当てたメモリなど）にある格子をそのまま使う
+        /// 領域は呼び出し側が持ち、この格子を使い終わるまで残しておく
+        /// </summary>
+        /// <param name="cellSize">セル1辺の長さ</param>
+        /// <param name="origin">格子の最小の角のローカル座標</param>
+        /// <param name="cellNumX">x方向のセルの数</param>
+        /// <param name="cellNumZ">z方向のセルの数</param>
+        /// <param name="heights">格子点の高さの先頭（(cellNumX + 1) * (cellNumZ + 1)個）</param>
+        /// <param name="normals">セルの法線の先頭（cellNumX * cellNumZ個）</param>
+        /// <param name="fallbacks">セルの印の先頭（cellNumX * cellNumZ個）</param>
+        void Attach(float cellSize, const VECTOR& origin, int cellNumX, int cellNumZ, const float* heights, const VECTOR* normals, const unsigned char* fallbacks);
+
+        /// <summary>
+        /// 地面の高さと法線の取得
+        /// </summary>
+        /// <param name="x">ローカル座標のx座標</param>
+        /// <param name="z">ローカル座標のz座標</param>
+        /// <param name="height">地面の高さ</param>
+        /// <param name="normal">地面の法線（上向き）</param>
+        /// <returns>格子で答えられない場合（範囲外・メッシュとの判定に任せるセル）はfalseを返す</returns>
+        bool Sample(float x, float z, float& height, VECTOR& normal) const;
+
+        /// <summary>
+        /// 真下向きの線分と地面の交点の計算
+        /// </summary>
+        /// <param name="start">ローカル座標の線分の始点</param>
+        /// <param name="end">ローカル座標の線分の終点（始点の真下）</param>
+        /// <param name="isHit">線分が地面と交わるか</param>
+        /// <param name="hit">交わる場合の交点の情報（triangleは-1）</param>
+        /// <returns>格子で答えられない場合（真下向きでない線分も含む）はfalseを返す</returns>
+        bool RaycastDown(const VECTOR& start, const VECTOR& end, bool& isHit, MeshRayHit& hit) const;
+
+        /// <summary>
+        /// メッシュとの判定に任せるセルの数の取得
+        /// </summary>
+        /// <returns>メッシュとの判定に任せるセルの数</returns>
+        int GetFallbackCellNum() const;
+
+        /// <summary>
+        /// 格子を持っているか
+        /// </summary>
+        /// <returns>作られていない、または三角形が無ければfalseを返す</returns>
+        bool IsValid() const { return heightData != nullptr; }
+
+        /// <summary>
+        /// セル1辺の長さの取得
+        /// </summary>
+        /// <returns>セル1辺の長さ</returns>
+        float GetCellSize() const { return cellSize; }
+
+        /// <summary>
+        /// 格子の最小の角のローカル座標の取得
+        /// </summary>
+        /// <returns>格子の最小の角のローカル座標</returns>
+        const VECTOR& GetOrigin() const { return origin; }
+
+        /// <summary>
+        /// x方向のセルの数の取得
+        /// </summary>
+        /// <returns>x方向のセルの数</returns>
+        int GetCellNumX() const { return cellNumX; }
+
+        /// <summary>
+        /// z方向のセルの数の取得
+        /// </summary>
+        /// <returns>z方向のセルの数</returns>
+        int GetCellNumZ() const { return cellNumZ; }
+
+        /// <summary>
+        /// 格子点の高さの先頭の取得
+        /// </summary>
+        /// <returns>格子点の高さの先頭</returns>
+        const float* GetHeightData() const { return heightData; }
+
+        /// <summary>
+        /// セルの法線の先頭の取得
+        /// </summary>
+        /// <returns>セルの法線の先頭</returns>
+        const VECTOR* GetNormalData() const { return normalData; }
+
+        /// <summary>
+        /// セルの印の先頭の取得
+        /// </summary>
+        /// <returns>セルの印の先頭</returns>
+        const unsigned char* GetFallbackData() const { return fallbackData; }
+    };
+}// namespace My3dApp
\ No newline at end of file
@@ -0,0 +1,182 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+namespace My3dApp
+{
+    // ジョブシステムインスタンスへのポインタ定義
+    JobSystem* JobSystem::instance = nullptr;
+
+    JobSystem::JobSystem(int workerNum)
+        : workers()
+        , queues()
+        , isRunning(true)
+        , pendingJobNum(0)
+    {
+        for (int i = 0; i < workerNum + 1; ++i)
+        {
+            queues.push_back(new WorkQueue());
+        }
+
+        for (int i = 0; i < workerNum; ++i)
+        {
+            workers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            lock_guard<mutex> lock(wakeMutex);
+            isRunning = false;
+        }
+        wakeCondition.notify_all();
+
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+
+        for (auto queue : queues)
+        {
+            delete queue;
+        }
+    }
+
+    void JobSystem::CreateInstance(int workerNum)
+    {
+        if (!instance)
+        {
+            if (workerNum < 0)
+            {
+                int coreNum = static_cast<int>(thread::hardware_concurrency());
+                workerNum = coreNum > 1 ? coreNum - 1 : 0;
+            }
+
+            instance = new JobSystem(workerNum);
+        }
+    }
+
+    void JobSystem::DeleteInstance()
+    {
+        if (instance)
+        {
+            delete instance;
+            instance = nullptr;
+        }
+    }
+
+    int JobSystem::GetThreadNum()
+    {
+        if (!instance)
+        {
+            return 1;
+        }
+        return static_cast<int>(instance->queues.size());
+    }
+
+    void JobSystem::WorkerLoop(int threadIndex)
+    {
+        while (isRunning)
+        {
+            Job job;
+            if (TryGetJob(threadIndex, job))
+            {
+                Execute(job, threadIndex);
+                continue;
+            }
+
+            // ジョブが無ければ積まれるまで眠る
+            unique_lock<mutex> lock(wakeMutex);
+            wakeCondition.wait(lock, [this] { return !isRunning || 0 < pendingJobNum; });
+        }
+    }
+
+    bool JobSystem::TryGetJob(int threadIndex, Job& job)
+    {
+        // 自分のキューの末尾から取る
+        {
+            WorkQueue* own = queues[threadIndex];
+            lock_guard<mutex> lock(own->queueMutex);
+            if (!own->jobs.empty())
+            {
+                job = own->jobs.back();
+                own->jobs.pop_back();
+                --pendingJobNum;
+                return true;
+            }
+        }
+
+        // 他のスレッドのキューの先頭から盗む
+        const int queueNum = static_cast<int>(queues.size());
+        for (int i = 1; i < queueNum; ++i)
+        {
+            WorkQueue* victim = queues[(threadIndex + i) % queueNum];
+            lock_guard<mutex> lock(victim->queueMutex);
+            if (!victim->jobs.empty())
+            {
+                job = victim->jobs.front();
+                victim->jobs.pop_front();
+                --pendingJobNum;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void JobSystem::Execute(const Job& job, int threadIndex)
+    {
+        (*job.func)(job.begin, job.end, threadIndex);
+
+        --(*job.remaining);
+    }
+
+    void JobSystem::ParallelFor(int count, int grainSize, const RangeFunc& func)
+    {
+        if (count <= 0)
+        {
+            return;
+        }
+
+        // ワーカーがいない、または1ジョブに収まるならその場で処理
+        if (!instance || instance->workers.empty() || count <= grainSize)
+        {
+            func(0, count, 0);
+            return;
+        }
+
+        const int jobNum = (count + grainSize - 1) / grainSize;
+        const int queueNum = static_cast<int>(instance->queues.size());
+        atomic<int> remaining(jobNum);
+
+        // 各スレッドのキューに順番に配る
+        for (int i = 0; i < jobNum; ++i)
+        {
+            Job job = { &func, i * grainSize, min(count, (i + 1) * grainSize), &remaining };
+
+            WorkQueue* queue = instance->queues[i % queueNum];
+            lock_guard<mutex> lock(queue->queueMutex);
+            queue->jobs.push_back(job);
+        }
+
+        {
+            lock_guard<mutex> lock(instance->wakeMutex);
+            instance->pendingJobNum += jobNum;
+        }
+        instance->wakeCondition.notify_all();
+
+        // メインスレッドも終わるまでジョブを処理する
+        while (0 < remaining)
+        {
+            Job job;
+            if (instance->TryGetJob(0, job))
+            {
+                instance->Execute(job, 0);
+            }
+            else
+            {
+                this_thread::yield();
+            }
+        }
+    }
+}// namespace My3dApp
\ No newline at end of file
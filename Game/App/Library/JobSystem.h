@@ -0,0 +1,129 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+using namespace std;
+
+namespace My3dApp
+{
+    /// <summary>
+    /// ジョブシステム（ワークスティーリング方式のスレッドプール）
+    /// </summary>
+    class JobSystem final
+    {
+    public:
+        // 範囲処理の関数（開始添字、終了添字、実行スレッド番号）
+        using RangeFunc = function<void(int begin, int end, int threadIndex)>;
+
+    private:
+        /// <summary>
+        /// コンストラクタ（シングルトン）
+        /// </summary>
+        /// <param name="workerNum">ワーカースレッド数</param>
+        JobSystem(int workerNum);
+
+        /// <summary>
+        /// デストラクタ
+        /// </summary>
+        ~JobSystem();
+
+        /// <summary>
+        /// ジョブ（範囲処理の一区切り）
+        /// </summary>
+        struct Job
+        {
+            // 実行する関数
+            const RangeFunc* func;
+
+            // 開始添字
+            int begin;
+
+            // 終了添字
+            int end;
+
+            // 残りジョブ数のカウンタ
+            atomic<int>* remaining;
+        };
+
+        /// <summary>
+        /// スレッドごとのジョブキュー（自分は末尾から取り、他のスレッドは先頭から盗む）
+        /// </summary>
+        struct WorkQueue
+        {
+            mutex queueMutex;
+            deque<Job> jobs;
+        };
+
+        // ジョブシステムの唯一のインスタンス
+        static JobSystem* instance;
+
+        // ワーカースレッド
+        vector<thread> workers;
+
+        // スレッドごとのジョブキュー（0番はメインスレッド）
+        vector<WorkQueue*> queues;
+
+        // 実行中フラグ
+        atomic<bool> isRunning;
+
+        // 待機中のワーカーを起こすための同期
+        mutex wakeMutex;
+        condition_variable wakeCondition;
+
+        // 積まれているジョブ数
+        atomic<int> pendingJobNum;
+
+        /// <summary>
+        /// ワーカースレッドの処理
+        /// </summary>
+        /// <param name="threadIndex">スレッド番号</param>
+        void WorkerLoop(int threadIndex);
+
+        /// <summary>
+        /// ジョブを1つ取り出す（自分のキューが空なら他のキューから盗む）
+        /// </summary>
+        /// <param name="threadIndex">取り出すスレッドの番号</param>
+        /// <param name="job">取り出したジョブ</param>
+        /// <returns>取り出せたらtrue</returns>
+        bool TryGetJob(int threadIndex, Job& job);
+
+        /// <summary>
+        /// ジョブの実行
+        /// </summary>
+        /// <param name="job">実行するジョブ</param>
+        /// <param name="threadIndex">実行スレッドの番号</param>
+        void Execute(const Job& job, int threadIndex);
+
+    public:
+        /// <summary>
+        /// インスタンスの生成
+        /// </summary>
+        /// <param name="workerNum">ワーカースレッド数（負ならコア数-1）</param>
+        static void CreateInstance(int workerNum = -1);
+
+        /// <summary>
+        /// インスタンスの削除
+        /// </summary>
+        static void DeleteInstance();
+
+        /// <summary>
+        /// メインスレッドを含めたスレッド数の取得
+        /// </summary>
+        /// <returns>スレッド数（インスタンスが無ければ1）</returns>
+        static int GetThreadNum();
+
+        /// <summary>
+        /// 範囲を分割して並列に処理する（全ジョブの終了まで待つ、メインスレッドも処理に加わる）
+        /// </summary>
+        /// <param name="count">処理する要素数</param>
+        /// <param name="grainSize">ジョブ1つあたりの要素数</param>
+        /// <param name="func">範囲処理の関数</param>
+        static void ParallelFor(int count, int grainSize, const RangeFunc& func);
+    };
+}// namespace My3dApp
\ No newline at end of file
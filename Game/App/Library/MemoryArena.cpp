@@ -0,0 +1,82 @@
+#include "MemoryArena.h"
+#include <new>
+
+namespace My3dApp
+{
+    MemoryArena::MemoryArena(size_t pageSize)
+        : pages()
+        , used(0)
+        , pageSize(pageSize)
+        , totalAllocated(0)
+    {
+        // 処理なし
+    }
+
+    MemoryArena::~MemoryArena()
+    {
+        for (auto& page : pages)
+        {
+            ::operator delete(page.data);
+        }
+        pages.clear();
+    }
+
+    void MemoryArena::AddPage(size_t minSize)
+    {
+        // 標準サイズに収まらない大きな確保は専用のページにする
+        size_t size = minSize < pageSize ? pageSize : minSize;
+
+        Page page;
+        page.data = static_cast<unsigned char*>(::operator new(size));
+        page.size = size;
+        pages.push_back(page);
+
+        used = 0;
+    }
+
+    void* MemoryArena::Allocate(size_t size, size_t alignment)
+    {
+        if (!pages.empty())
+        {
+            // ページ先頭のアドレスを基準に境界を合わせる
+            const Page& page = pages.back();
+            size_t address = reinterpret_cast<size_t>(page.data) + used;
+            size_t offset = ((address + alignment - 1) & ~(alignment - 1)) - reinterpret_cast<size_t>(page.data);
+
+            if (offset + size <= page.size)
+            {
+                used = offset + size;
+                totalAllocated += size;
+                return page.data + offset;
+            }
+        }
+
+        // 境界合わせの余白も含めて新しいページを確保
+        AddPage(size + alignment);
+
+        const Page& page = pages.back();
+        size_t address = reinterpret_cast<size_t>(page.data);
+        size_t offset = ((address + alignment - 1) & ~(alignment - 1)) - address;
+
+        used = offset + size;
+        totalAllocated += size;
+        return page.data + offset;
+    }
+
+    void MemoryArena::Reset()
+    {
+        // 先頭のページ以外を解放
+        for (size_t i = 1; i < pages.size(); ++i)
+        {
+            ::operator delete(pages[i].data);
+        }
+
+        if (!pages.empty())
+        {
+            pages.resize(1);
+        }
+
+        used = 0;
+        totalAllocated = 0;
+    }
+}// namespace My3dApp
\ No newline at end of file
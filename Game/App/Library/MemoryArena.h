@@ -0,0 +1,181 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+using namespace std;
+
+namespace My3dApp
+{
+    /// <summary>
+    /// 先頭から順に切り出すだけのメモリアリーナ（個別の解放はせず、まとめて解放する）
+    /// </summary>
+    class MemoryArena final
+    {
+    private:
+        /// <summary>
+        /// ページ（まとめて確保した領域）
+        /// </summary>
+        struct Page
+        {
+            // 領域の先頭
+            unsigned char* data;
+
+            // 領域のサイズ
+            size_t size;
+        };
+
+        // 確保したページ
+        vector<Page> pages;
+
+        // 次に切り出す位置（末尾のページ内）
+        size_t used;
+
+        // ページ1つの標準サイズ
+        size_t pageSize;
+
+        // 切り出した合計サイズ
+        size_t totalAllocated;
+
+        /// <summary>
+        /// ページを1つ追加する
+        /// </summary>
+        /// <param name="minSize">最低限必要なサイズ</param>
+        void AddPage(size_t minSize);
+
+    public:
+        /// <summary>
+        /// コンストラクタ
+        /// </summary>
+        /// <param name="pageSize">ページ1つの標準サイズ</param>
+        MemoryArena(size_t pageSize = 256 * 1024);
+
+        /// <summary>
+        /// デストラクタ
+        /// </summary>
+        ~MemoryArena();
+
+        MemoryArena(const MemoryArena&) = delete;
+        MemoryArena& operator=(const MemoryArena&) = delete;
+
+        /// <summary>
+        /// 領域の切り出し
+        /// </summary>
+        /// <param name="size">必要なサイズ</param>
+        /// <param name="alignment">境界（2のべき乗）</param>
+        /// <returns>切り出した領域の先頭</returns>
+        void* Allocate(size_t size, size_t alignment = 16);
+
+        /// <summary>
+        /// 切り出した領域をすべてまとめて解放する（先頭のページは次に使うため残す）
+        /// </summary>
+        void Reset();
+
+        /// <summary>
+        /// 切り出した合計サイズの取得
+        /// </summary>
+        /// <returns>切り出した合計サイズ</returns>
+        size_t GetAllocatedSize() const { return totalAllocated; }
+    };
+
+    /// <summary>
+    /// アリーナから確保する標準コンテナ用アロケータ（解放はアリーナのReset、破棄でまとめて行う）
+    /// アリーナが無ければヒープから確保する
+    /// </summary>
+    template<class T>
+    class ArenaAllocator
+    {
+    public:
+        using value_type = T;
+
+        // 確保元を差し替えた配列の代入・入れ替えで、確保元も一緒に移す
+        using propagate_on_container_copy_assignment = true_type;
+        using propagate_on_container_move_assignment = true_type;
+        using propagate_on_container_swap = true_type;
+
+        // 確保元のアリーナ（nullptrならヒープ）
+        MemoryArena* arena;
+
+        /// <summary>
+        /// コンストラクタ（ヒープから確保する）
+        /// </summary>
+        ArenaAllocator()
+            : arena(nullptr)
+        {
+        }
+
+        /// <summary>
+        /// コンストラクタ
+        /// </summary>
+        /// <param name="arena">確保元のアリーナ（nullptrならヒープ）</param>
+        ArenaAllocator(MemoryArena* arena)
+            : arena(arena)
+        {
+        }
+
+        template<class U>
+        ArenaAllocator(const ArenaAllocator<U>& other)
+            : arena(other.arena)
+        {
+        }
+
+        /// <summary>
+        /// 要素の領域の確保
+        /// </summary>
+        /// <param name="n">要素数</param>
+        /// <returns>確保した領域の先頭</returns>
+        T* allocate(size_t n)
+        {
+            if (!arena)
+            {
+                return static_cast<T*>(::operator new(sizeof(T) * n));
+            }
+            return static_cast<T*>(arena->Allocate(sizeof(T) * n, alignof(T)));
+        }
+
+        /// <summary>
+        /// 要素の領域の解放（アリーナから確保したものはアリーナでまとめて解放するため何もしない）
+        /// </summary>
+        /// <param name="data">解放する領域の先頭</param>
+        void deallocate(T* data, size_t)
+        {
+            if (!arena)
+            {
+                ::operator delete(data);
+            }
+        }
+
+        template<class U>
+        bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+
+        template<class U>
+        bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+    };
+
+    // アリーナから確保する可変長配列
+    template<class T>
+    using ArenaVector = vector<T, ArenaAllocator<T>>;
+
+    /// <summary>
+    /// 配列の確保元の差し替え（中身は新しい確保元に移す、古いアリーナが残っているうちに呼ぶ）
+    /// </summary>
+    /// <param name="array">差し替える配列</param>
+    /// <param name="arena">新しい確保元のアリーナ（nullptrならヒープ）</param>
+    template<class T>
+    void RebindArena(ArenaVector<T>& array, MemoryArena* arena)
+    {
+        if (array.get_allocator().arena == arena)
+        {
+            return;
+        }
+
+        ArenaVector<T> rebound{ ArenaAllocator<T>(arena) };
+        rebound.reserve(array.size());
+        rebound.insert(rebound.end(), make_move_iterator(array.begin()), make_move_iterator(array.end()));
+        array = move(rebound);
+    }
+}// namespace My3dApp
\ No newline at end of file
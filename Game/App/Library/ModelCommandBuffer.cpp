@@ -0,0 +1,55 @@
+#include "ModelCommandBuffer.h"
+
+namespace My3dApp
+{
+    // スレッドごとの記録先（nullptrなら直接呼ぶ）
+    static thread_local ModelCommandBuffer* recordingBuffer = nullptr;
+
+    ModelCommandBuffer::ModelCommandBuffer()
+        : commands()
+    {
+    }
+
+    void ModelCommandBuffer::Execute()
+    {
+        for (const auto& command : commands)
+        {
+            switch (command.type)
+            {
+            case CommandType::SetPosition:
+                MV1SetPosition(command.modelHandle, command.vec1);
+                break;
+
+            case CommandType::SetRotationZYAxis:
+                MV1SetRotationZYAxis(command.modelHandle, command.vec1, command.vec2, command.value);
+                break;
+            }
+        }
+        commands.clear();
+    }
+
+    void ModelCommandBuffer::SetRecording(ModelCommandBuffer* buffer)
+    {
+        recordingBuffer = buffer;
+    }
+
+    void ModelCommandBuffer::SetPosition(int modelHandle, const VECTOR& pos)
+    {
+        if (!recordingBuffer)
+        {
+            MV1SetPosition(modelHandle, pos);
+            return;
+        }
+        recordingBuffer->commands.push_back({ CommandType::SetPosition, modelHandle, pos, VGet(0, 0, 0), 0.0f });
+    }
+
+    void ModelCommandBuffer::SetRotationZYAxis(int modelHandle, const VECTOR& zAxis, const VECTOR& yAxis, float zRot)
+    {
+        if (!recordingBuffer)
+        {
+            MV1SetRotationZYAxis(modelHandle, zAxis, yAxis, zRot);
+            return;
+        }
+        recordingBuffer->commands.push_back({ CommandType::SetRotationZYAxis, modelHandle, zAxis, yAxis, zRot });
+    }
+}// namespace My3dApp
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+#include "DxLib.h"
+
+using namespace std;
+
+namespace My3dApp
+{
+    /// <summary>
+    /// モデル操作のコマンドバッファ（メインスレッドでしか呼べないDxLibのモデル操作を記録して後で再生する）
+    /// </summary>
+    class ModelCommandBuffer final
+    {
+    private:
+        // コマンドの種類
+        enum class CommandType
+        {
+            SetPosition,         // MV1SetPosition
+            SetRotationZYAxis,   // MV1SetRotationZYAxis
+        };
+
+        /// <summary>
+        /// 記録したコマンド
+        /// </summary>
+        struct Command
+        {
+            CommandType type;
+            int modelHandle;
+            VECTOR vec1;
+            VECTOR vec2;
+            float value;
+        };
+
+        // 記録したコマンド
+        vector<Command> commands;
+
+    public:
+        /// <summary>
+        /// コンストラクタ
+        /// </summary>
+        ModelCommandBuffer();
+
+        /// <summary>
+        /// 記録したコマンドをすべて実行して空にする（メインスレッドで呼ぶ）
+        /// </summary>
+        void Execute();
+
+        /// <summary>
+        /// 呼び出したスレッドの記録先を設定する（nullptrで記録をやめて直接呼ぶ）
+        /// </summary>
+        /// <param name="buffer">記録先のバッファ</param>
+        static void SetRecording(ModelCommandBuffer* buffer);
+
+        /// <summary>
+        /// モデルの座標設定（記録中ならバッファに積む）
+        /// </summary>
+        /// <param name="modelHandle">モデルハンドル</param>
+        /// <param name="pos">座標</param>
+        static void SetPosition(int modelHandle, const VECTOR& pos);
+
+        /// <summary>
+        /// モデルの回転設定（記録中ならバッファに積む）
+        /// </summary>
+        /// <param name="modelHandle">モデルハンドル</param>
+        /// <param name="zAxis">Z軸の向き</param>
+        /// <param name="yAxis">Y軸の向き</param>
+        /// <param name="zRot">Z軸周りの回転</param>
+        static void SetRotationZYAxis(int modelHandle, const VECTOR& zAxis, const VECTOR& yAxis, float zRot);
+    };
+}// namespace My3dApp
\ No newline at end of file
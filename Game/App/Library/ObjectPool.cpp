@@ -0,0 +1,100 @@
+#include "ObjectPool.h"
+#include "MemoryArena.h"
+
+namespace My3dApp
+{
+    // スロットの境界（doubleやSIMD型を含むオブジェクトでも崩れないように16バイト）
+    const size_t slotAlignment = 16;
+
+    ObjectPool::ObjectPool(size_t objectSize, int slotsPerBlock)
+        : slotSize((objectSize + slotAlignment - 1) & ~(slotAlignment - 1))
+        , slotsPerBlock(slotsPerBlock)
+        , blocks()
+        , freeList(nullptr)
+        , usedCount(0)
+        , arena(nullptr)
+    {
+        // 空きリンクを格納できる大きさは必要
+        if (slotSize < sizeof(FreeSlot))
+        {
+            slotSize = slotAlignment;
+        }
+    }
+
+    ObjectPool::~ObjectPool()
+    {
+        ReleaseAll();
+    }
+
+    void ObjectPool::AddBlock()
+    {
+        unsigned char* block;
+        if (arena)
+        {
+            block = static_cast<unsigned char*>(arena->Allocate(slotSize * slotsPerBlock, slotAlignment));
+            blocks.push_back(block);
+        }
+        else
+        {
+            // ヒープは16バイト境界を保証しないので、余白を取って先頭を境界に合わせる（解放には確保した先頭を使う）
+            unsigned char* raw = static_cast<unsigned char*>(::operator new(slotSize * slotsPerBlock + slotAlignment - 1));
+            blocks.push_back(raw);
+
+            const size_t address = reinterpret_cast<size_t>(raw);
+            block = raw + (((address + slotAlignment - 1) & ~(slotAlignment - 1)) - address);
+        }
+
+        // 先頭のスロットから順に使われるよう、後ろからリストにつなぐ
+        for (int i = slotsPerBlock - 1; 0 <= i; --i)
+        {
+            FreeSlot* slot = reinterpret_cast<FreeSlot*>(block + slotSize * i);
+            slot->next = freeList;
+            freeList = slot;
+        }
+    }
+
+    void* ObjectPool::Allocate()
+    {
+        if (!freeList)
+        {
+            AddBlock();
+        }
+
+        FreeSlot* slot = freeList;
+        freeList = slot->next;
+        ++usedCount;
+
+        return slot;
+    }
+
+    void ObjectPool::Free(void* slot)
+    {
+        FreeSlot* freeSlot = static_cast<FreeSlot*>(slot);
+        freeSlot->next = freeList;
+        freeList = freeSlot;
+        --usedCount;
+    }
+
+    void ObjectPool::ReleaseAll()
+    {
+        // アリーナのブロックはアリーナ側でまとめて解放される
+        if (!arena)
+        {
+            for (auto block : blocks)
+            {
+                ::operator delete(block);
+            }
+        }
+        blocks.clear();
+
+        freeList = nullptr;
+        usedCount = 0;
+    }
+
+    void ObjectPool::SetArena(MemoryArena* set)
+    {
+        ReleaseAll();
+
+        arena = set;
+    }
+}// namespace My3dApp
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <vector>
+
+using namespace std;
+
+namespace My3dApp
+{
+    /// <summary>
+    /// 固定サイズのスロットを使いまわすオブジェクトプール
+    /// </summary>
+    class ObjectPool final
+    {
+    private:
+        /// <summary>
+        /// 空きスロット（空いている間はスロットの先頭を次の空きへのリンクとして使う）
+        /// </summary>
+        struct FreeSlot
+        {
+            FreeSlot* next;
+        };
+
+        // スロット1つのサイズ
+        size_t slotSize;
+
+        // ブロック1つあたりのスロット数
+        int slotsPerBlock;
+
+        // 確保したブロック（ヒープから確保したものは境界を合わせる前の先頭）
+        vector<unsigned char*> blocks;
+
+        // 空きスロットのリスト
+        FreeSlot* freeList;
+
+        // 使用中のスロット数
+        int usedCount;
+
+        // ブロックの確保元（nullptrならヒープから確保する）
+        class MemoryArena* arena;
+
+        /// <summary>
+        /// ブロックを1つ追加して空きスロットのリストにつなぐ
+        /// </summary>
+        void AddBlock();
+
+    public:
+        /// <summary>
+        /// コンストラクタ
+        /// </summary>
+        /// <param name="objectSize">格納するオブジェクトのサイズ</param>
+        /// <param name="slotsPerBlock">ブロック1つあたりのスロット数</param>
+        ObjectPool(size_t objectSize, int slotsPerBlock = 64);
+
+        /// <summary>
+        /// デストラクタ
+        /// </summary>
+        ~ObjectPool();
+
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool& operator=(const ObjectPool&) = delete;
+
+        /// <summary>
+        /// スロットの確保
+        /// </summary>
+        /// <returns>確保したスロットの先頭</returns>
+        void* Allocate();
+
+        /// <summary>
+        /// スロットの返却
+        /// </summary>
+        /// <param name="slot">返却するスロット</param>
+        void Free(void* slot);
+
+        /// <summary>
+        /// すべてのブロックの一括解放（使用中のスロットが残っていないこと、アリーナのブロックは手放すだけ）
+        /// </summary>
+        void ReleaseAll();
+
+        /// <summary>
+        /// ブロックの確保元の変更（持っているブロックは手放す、使用中のスロットが残っていないこと）
+        /// アリーナから確保したブロックはアリーナの破棄でまとめて解放される
+        /// </summary>
+        /// <param name="set">確保元のアリーナ（nullptrならヒープ）</param>
+        void SetArena(class MemoryArena* set);
+
+        /// <summary>
+        /// 使用中のスロット数の取得
+        /// </summary>
+        /// <returns>使用中のスロット数</returns>
+        int GetUsedCount() const { return usedCount; }
+    };
+}// namespace My3dApp
\ No newline at end of file
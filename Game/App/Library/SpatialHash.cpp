@@ -0,0 +1,443 @@
+#include "SpatialHash.h"
+#include <algorithm>
+#include <cmath>
+
+namespace My3dApp
+{
+    // セル座標1成分に使うビット数（符号をなくすため中央をずらして詰める）
+    const int cellBits = 21;
+    const int cellOffset = 1 << (cellBits - 1);
+    const unsigned long long cellMask = (1ull << cellBits) - 1;
+
+    // これより多くのセルにまたがる境界箱はセルに登録せず総当たりにする
+    const long long maxProxyCells = 64;
+
+    SpatialHash::SpatialHash(float cellSize)
+        : cellSize(cellSize)
+        , invCellSize(1.0f / cellSize)
+        , proxies()
+        , largeProxies()
+        , entries()
+        , sortScratch()
+        , tableKeys()
+        , tableCells()
+        , cellStarts()
+        , groupRanges()
+        , queryProxies()
+        , rayHits()
+    {
+        // 処理なし
+    }
+
+    int SpatialHash::ToCell(float value) const
+    {
+        return static_cast<int>(floorf(value * invCellSize));
+    }
+
+    unsigned long long SpatialHash::CellKey(int x, int y, int z)
+    {
+        return ((static_cast<unsigned long long>(x + cellOffset) & cellMask) << (cellBits * 2))
+            | ((static_cast<unsigned long long>(y + cellOffset) & cellMask) << cellBits)
+            | (static_cast<unsigned long long>(z + cellOffset) & cellMask);
+    }
+
+    size_t SpatialHash::TableSlot(unsigned long long key, size_t tableSize)
+    {
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 20) & (tableSize - 1);
+    }
+
+    void SpatialHash::Clear()
+    {
+        proxies.clear();
+        largeProxies.clear();
+        entries.clear();
+        tableKeys.clear();
+        tableCells.clear();
+        cellStarts.clear();
+    }
+
+    void SpatialHash::SetArena(MemoryArena* arena)
+    {
+        RebindArena(proxies, arena);
+        RebindArena(largeProxies, arena);
+        RebindArena(entries, arena);
+        RebindArena(sortScratch, arena);
+        RebindArena(tableKeys, arena);
+        RebindArena(tableCells, arena);
+        RebindArena(cellStarts, arena);
+        RebindArena(groupRanges, arena);
+        RebindArena(queryProxies, arena);
+        RebindArena(rayHits, arena);
+    }
+
+    void SpatialHash::BeginFrame()
+    {
+        Clear();
+    }
+
+    void SpatialHash::SetProxy(int id, const AABB& box, unsigned int group, unsigned int mask, bool isStatic)
+    {
+        Proxy proxy;
+        proxy.box = box;
+        proxy.id = id;
+        proxy.group = group;
+        proxy.mask = mask;
+        proxy.isStatic = isStatic;
+
+        proxy.groupIndex = 0;
+        while (proxy.groupIndex < 31 && !(group & (1u << proxy.groupIndex)))
+        {
+            ++proxy.groupIndex;
+        }
+
+        const int minX = ToCell(box.minPos.x);
+        const int minY = ToCell(box.minPos.y);
+        const int minZ = ToCell(box.minPos.z);
+        const int maxX = ToCell(box.maxPos.x);
+        const int maxY = ToCell(box.maxPos.y);
+        const int maxZ = ToCell(box.maxPos.z);
+
+        proxy.minCell[0] = minX;
+        proxy.minCell[1] = minY;
+        proxy.minCell[2] = minZ;
+
+        const long long cellNum = static_cast<long long>(maxX - minX + 1) * (maxY - minY + 1) * (maxZ - minZ + 1);
+        proxy.isLarge = maxProxyCells < cellNum;
+
+        const int proxyIndex = static_cast<int>(proxies.size());
+        proxies.push_back(proxy);
+
+        // マップのような大きなものは別に持つ
+        if (proxy.isLarge)
+        {
+            largeProxies.push_back(proxyIndex);
+            return;
+        }
+
+        // 境界箱が重なるセルすべてに登録する
+        for (int x = minX; x <= maxX; ++x)
+        {
+            for (int y = minY; y <= maxY; ++y)
+            {
+                for (int z = minZ; z <= maxZ; ++z)
+                {
+                    entries.push_back({ CellKey(x, y, z), 0, proxyIndex });
+                }
+            }
+        }
+    }
+
+    void SpatialHash::EndFrame()
+    {
+        SortEntries();
+    }
+
+    void SpatialHash::SortEntries()
+    {
+        const int entryNum = static_cast<int>(entries.size());
+
+        // 表の大きさは登録数の2倍以上の2のべき乗
+        size_t tableSize = 64;
+        while (tableSize < static_cast<size_t>(entryNum) * 2)
+        {
+            tableSize *= 2;
+        }
+        tableKeys.assign(tableSize, ~0ull);
+        tableCells.resize(tableSize);
+
+        // セル座標のキーに通し番号を振る
+        int cellNum = 0;
+        for (auto& entry : entries)
+        {
+            size_t slot = TableSlot(entry.key, tableSize);
+            while (tableKeys[slot] != ~0ull && tableKeys[slot] != entry.key)
+            {
+                slot = (slot + 1) & (tableSize - 1);
+            }
+
+            if (tableKeys[slot] == ~0ull)
+            {
+                tableKeys[slot] = entry.key;
+                tableCells[slot] = cellNum++;
+            }
+
+            entry.sortKey = (static_cast<unsigned int>(tableCells[slot]) << 5) | static_cast<unsigned int>(proxies[entry.proxy].groupIndex);
+        }
+
+        // 8ビットずつの基数ソート（安定なので同じセル・グループ内は登録順のまま）
+        unsigned int maxKey = (static_cast<unsigned int>(cellNum) << 5) | 31u;
+        sortScratch.resize(entryNum);
+
+        for (int shift = 0; shift < 32 && (maxKey >> shift); shift += 8)
+        {
+            int count[257] = {};
+            for (auto& entry : entries)
+            {
+                ++count[((entry.sortKey >> shift) & 0xFF) + 1];
+            }
+            for (int i = 0; i < 256; ++i)
+            {
+                count[i + 1] += count[i];
+            }
+            for (auto& entry : entries)
+            {
+                sortScratch[count[(entry.sortKey >> shift) & 0xFF]++] = entry;
+            }
+            entries.swap(sortScratch);
+        }
+
+        // 検索用にセルごとの開始位置を求める
+        cellStarts.assign(cellNum + 1, entryNum);
+        for (int i = entryNum - 1; 0 <= i; --i)
+        {
+            cellStarts[entries[i].sortKey >> 5] = i;
+        }
+    }
+
+    int SpatialHash::FindCell(unsigned long long key) const
+    {
+        if (tableKeys.empty())
+        {
+            return -1;
+        }
+
+        const size_t tableSize = tableKeys.size();
+        size_t slot = TableSlot(key, tableSize);
+
+        while (tableKeys[slot] != ~0ull)
+        {
+            if (tableKeys[slot] == key)
+            {
+                return tableCells[slot];
+            }
+            slot = (slot + 1) & (tableSize - 1);
+        }
+
+        return -1;
+    }
+
+    void SpatialHash::FindPairs(ArenaVector<pair<int, int>>& pairs)
+    {
+        const int entryNum = static_cast<int>(entries.size());
+
+        for (int begin = 0; begin < entryNum;)
+        {
+            // 同じセルの範囲を、グループごとの範囲に分けながら求める
+            const unsigned long long key = entries[begin].key;
+            const unsigned int cellID = entries[begin].sortKey >> 5;
+            groupRanges.clear();
+
+            int end = begin;
+            while (end < entryNum && (entries[end].sortKey >> 5) == cellID)
+            {
+                const Proxy& proxy = proxies[entries[end].proxy];
+
+                if (groupRanges.empty() || groupRanges.back().group != proxy.group)
+                {
+                    groupRanges.push_back({ end, end, proxy.group, 0 });
+                }
+
+                groupRanges.back().end = end + 1;
+                groupRanges.back().mask |= proxy.mask;
+                ++end;
+            }
+
+            const int cell[3] =
+            {
+                static_cast<int>((key >> (cellBits * 2)) & cellMask) - cellOffset,
+                static_cast<int>((key >> cellBits) & cellMask) - cellOffset,
+                static_cast<int>(key & cellMask) - cellOffset,
+            };
+
+            // どちらも相手のグループを対象にしていないグループの組み合わせはまとめて飛ばす
+            for (size_t rangeA = 0; rangeA < groupRanges.size(); ++rangeA)
+            {
+                for (size_t rangeB = rangeA; rangeB < groupRanges.size(); ++rangeB)
+                {
+                    const GroupRange& groupA = groupRanges[rangeA];
+                    const GroupRange& groupB = groupRanges[rangeB];
+
+                    if (!(groupA.mask & groupB.group) && !(groupB.mask & groupA.group))
+                    {
+                        continue;
+                    }
+
+                    for (int i = groupA.begin; i < groupA.end; ++i)
+                    {
+                        const Proxy& a = proxies[entries[i].proxy];
+
+                        for (int j = rangeA == rangeB ? i + 1 : groupB.begin; j < groupB.end; ++j)
+                        {
+                            const Proxy& b = proxies[entries[j].proxy];
+
+                            // 動かないもの同士や、どちらも相手を対象にしていない組み合わせは飛ばす
+                            if (a.isStatic && b.isStatic)
+                            {
+                                continue;
+                            }
+
+                            if (!(a.group & b.mask) && !(b.group & a.mask))
+                            {
+                                continue;
+                            }
+
+                            // 複数のセルで重なる組み合わせは、共通するセル範囲の最小セルでだけ返す
+                            if (max(a.minCell[0], b.minCell[0]) != cell[0]
+                                || max(a.minCell[1], b.minCell[1]) != cell[1]
+                                || max(a.minCell[2], b.minCell[2]) != cell[2])
+                            {
+                                continue;
+                            }
+
+                            if (CollisionPair(a.box, b.box))
+                            {
+                                pairs.emplace_back(a.id, b.id);
+                            }
+                        }
+                    }
+                }
+            }
+
+            begin = end;
+        }
+
+        // 大きな境界箱は登録されたすべてと総当たりにする（大きなもの同士は添字の小さい側から1回だけ）
+        const int proxyNum = static_cast<int>(proxies.size());
+
+        for (int largeIndex : largeProxies)
+        {
+            const Proxy& a = proxies[largeIndex];
+
+            for (int i = 0; i < proxyNum; ++i)
+            {
+                const Proxy& b = proxies[i];
+
+                if (i == largeIndex || (b.isLarge && i < largeIndex))
+                {
+                    continue;
+                }
+
+                if (a.isStatic && b.isStatic)
+                {
+                    continue;
+                }
+
+                if (!(a.group & b.mask) && !(b.group & a.mask))
+                {
+                    continue;
+                }
+
+                if (CollisionPair(a.box, b.box))
+                {
+                    pairs.emplace_back(a.id, b.id);
+                }
+            }
+        }
+    }
+
+    void SpatialHash::CollectOverlap(const AABB& box, unsigned int groupMask, ArenaVector<int>& result) const
+    {
+        const int minX = ToCell(box.minPos.x);
+        const int minY = ToCell(box.minPos.y);
+        const int minZ = ToCell(box.minPos.z);
+        const int maxX = ToCell(box.maxPos.x);
+        const int maxY = ToCell(box.maxPos.y);
+        const int maxZ = ToCell(box.maxPos.z);
+
+        const long long cellNum = static_cast<long long>(maxX - minX + 1) * (maxY - minY + 1) * (maxZ - minZ + 1);
+
+        // 登録数よりセルのほうが多いような広い範囲は総当たりのほうが速い
+        if (static_cast<long long>(proxies.size()) < cellNum)
+        {
+            for (int i = 0; i < static_cast<int>(proxies.size()); ++i)
+            {
+                if ((proxies[i].group & groupMask) && CollisionPair(proxies[i].box, box))
+                {
+                    result.push_back(i);
+                }
+            }
+            return;
+        }
+
+        for (int x = minX; x <= maxX; ++x)
+        {
+            for (int y = minY; y <= maxY; ++y)
+            {
+                for (int z = minZ; z <= maxZ; ++z)
+                {
+                    const int cellID = FindCell(CellKey(x, y, z));
+                    if (cellID < 0)
+                    {
+                        continue;
+                    }
+
+                    for (int i = cellStarts[cellID]; i < cellStarts[cellID + 1]; ++i)
+                    {
+                        const Proxy& proxy = proxies[entries[i].proxy];
+
+                        if (!(proxy.group & groupMask))
+                        {
+                            continue;
+                        }
+
+                        // 複数のセルで重なるものは、共通するセル範囲の最小セルでだけ返す
+                        if (max(proxy.minCell[0], minX) != x || max(proxy.minCell[1], minY) != y || max(proxy.minCell[2], minZ) != z)
+                        {
+                            continue;
+                        }
+
+                        if (CollisionPair(proxy.box, box))
+                        {
+                            result.push_back(entries[i].proxy);
+                        }
+                    }
+                }
+            }
+        }
+
+        for (int largeIndex : largeProxies)
+        {
+            if ((proxies[largeIndex].group & groupMask) && CollisionPair(proxies[largeIndex].box, box))
+            {
+                result.push_back(largeIndex);
+            }
+        }
+    }
+
+    void SpatialHash::QueryOverlap(const AABB& box, unsigned int groupMask, ArenaVector<int>& ids)
+    {
+        queryProxies.clear();
+        CollectOverlap(box, groupMask, queryProxies);
+
+        for (int proxyIndex : queryProxies)
+        {
+            ids.push_back(proxies[proxyIndex].id);
+        }
+    }
+
+    void SpatialHash::QueryRay(const VECTOR& start, const VECTOR& end, unsigned int groupMask, ArenaVector<int>& ids)
+    {
+        // 線分を囲む範囲の候補から、実際に線分と交差するものを残す
+        queryProxies.clear();
+        CollectOverlap(CalcAABB(LineSegment(start, end)), groupMask, queryProxies);
+
+        const VECTOR invDir = CalcInvDir(start, end);
+        rayHits.clear();
+
+        for (int proxyIndex : queryProxies)
+        {
+            float hitRate;
+            if (RaycastBox(start, invDir, proxies[proxyIndex].box, hitRate))
+            {
+                rayHits.emplace_back(hitRate, proxies[proxyIndex].id);
+            }
+        }
+
+        sort(rayHits.begin(), rayHits.end());
+
+        for (auto& hit : rayHits)
+        {
+            ids.push_back(hit.second);
+        }
+    }
+}// namespace My3dApp
\ No newline at end of file
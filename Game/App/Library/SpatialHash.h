@@ -0,0 +1,223 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include "DxLib.h"
+#include "Broadphase.h"
+
+using namespace std;
+
+namespace My3dApp
+{
+    /// <summary>
+    /// 一様グリッドによる空間ハッシュ（境界箱の重なる組み合わせだけを列挙するブロードフェーズ）
+    /// 毎フレーム登録し直す。セルに収まらない大きな境界箱は別に持ち、全体と総当たりにする
+    /// </summary>
+    class SpatialHash final : public Broadphase
+    {
+    private:
+        /// <summary>
+        /// 登録された境界箱
+        /// </summary>
+        struct Proxy
+        {
+            // 境界箱
+            AABB box;
+
+            // 呼び出し側の番号
+            int id;
+
+            // 自身の属するグループのビット
+            unsigned int group;
+
+            // 当たりを取りたい相手のグループのビット
+            unsigned int mask;
+
+            // グループのビット位置（同じセル内をグループごとに並べるのに使う）
+            int groupIndex;
+
+            // 動かないか（動かないもの同士は組み合わせにしない）
+            bool isStatic;
+
+            // セルに登録せず全体と総当たりにする大きな境界箱か
+            bool isLarge;
+
+            // 重なっているセル範囲の最小セル
+            int minCell[3];
+        };
+
+        /// <summary>
+        /// セルと境界箱の対応
+        /// </summary>
+        struct CellEntry
+        {
+            // セル座標を詰めたキー
+            unsigned long long key;
+
+            // 並べ替え用のキー（上位にセルの通し番号、下位5ビットにグループのビット位置）
+            unsigned int sortKey;
+
+            // 境界箱の添字
+            int proxy;
+        };
+
+        /// <summary>
+        /// 同じセル、同じグループの並びの範囲
+        /// </summary>
+        struct GroupRange
+        {
+            // 開始位置
+            int begin;
+
+            // 終了位置
+            int end;
+
+            // グループのビット
+            unsigned int group;
+
+            // 範囲内の境界箱の当たりを取りたい相手のビットをまとめたもの
+            unsigned int mask;
+        };
+
+        // セル1辺の長さ
+        float cellSize;
+
+        // セル1辺の長さの逆数
+        float invCellSize;
+
+        // 登録された境界箱
+        ArenaVector<Proxy> proxies;
+
+        // セルに登録しない大きな境界箱の添字
+        ArenaVector<int> largeProxies;
+
+        // セルと境界箱の対応（登録の終了時にセル順に並べる）
+        ArenaVector<CellEntry> entries;
+
+        // 並べ替えの作業領域
+        ArenaVector<CellEntry> sortScratch;
+
+        // セル座標のキーから通し番号を引く表（開番地法）
+        ArenaVector<unsigned long long> tableKeys;
+        ArenaVector<int> tableCells;
+
+        // セルの通し番号ごとの並べ替え後の開始位置（末尾に終端を置く）
+        ArenaVector<int> cellStarts;
+
+        // 1つのセル内のグループごとの範囲の作業領域
+        ArenaVector<GroupRange> groupRanges;
+
+        // 検索の作業領域（境界箱の添字）
+        ArenaVector<int> queryProxies;
+
+        // 線分検索の作業領域（入る位置の割合と番号）
+        ArenaVector<pair<float, int>> rayHits;
+
+        /// <summary>
+        /// セルごとの通し番号を振り、セルとグループの順に並べ替える（基数ソート）
+        /// </summary>
+        void SortEntries();
+
+        /// <summary>
+        /// セル座標のキーから通し番号を引く
+        /// </summary>
+        /// <param name="key">セル座標のキー</param>
+        /// <returns>通し番号（登録のないセルは-1）</returns>
+        int FindCell(unsigned long long key) const;
+
+        /// <summary>
+        /// 範囲と重なる境界箱の添字を重複なく集める
+        /// </summary>
+        /// <param name="box">調べる範囲</param>
+        /// <param name="groupMask">対象にするグループのビット</param>
+        /// <param name="result">見つかった境界箱の添字</param>
+        void CollectOverlap(const AABB& box, unsigned int groupMask, ArenaVector<int>& result) const;
+
+        /// <summary>
+        /// 座標からセル座標への変換
+        /// </summary>
+        /// <param name="value">座標の1成分</param>
+        /// <returns>セル座標</returns>
+        int ToCell(float value) const;
+
+        /// <summary>
+        /// セル座標を1つのキーに詰める
+        /// </summary>
+        static unsigned long long CellKey(int x, int y, int z);
+
+        /// <summary>
+        /// キーの表の位置の計算
+        /// </summary>
+        /// <param name="key">セル座標のキー</param>
+        /// <param name="tableSize">表の大きさ（2のべき乗）</param>
+        /// <returns>表の位置</returns>
+        static size_t TableSlot(unsigned long long key, size_t tableSize);
+
+    public:
+        /// <summary>
+        /// コンストラクタ
+        /// </summary>
+        /// <param name="cellSize">セル1辺の長さ（よく使う境界球の直径程度）</param>
+        SpatialHash(float cellSize);
+
+        /// <summary>
+        /// 登録されたすべての境界箱の削除（確保した領域は次のフレームのために残す）
+        /// </summary>
+        void Clear() override;
+
+        /// <summary>
+        /// 登録と作業領域の確保元の変更
+        /// </summary>
+        /// <param name="arena">確保元のアリーナ（nullptrならヒープ）</param>
+        void SetArena(MemoryArena* arena) override;
+
+        /// <summary>
+        /// 1フレーム分の登録の開始（毎フレーム作り直すので前のフレームの登録はすべて消す）
+        /// </summary>
+        void BeginFrame() override;
+
+        /// <summary>
+        /// 境界箱の登録
+        /// </summary>
+        /// <param name="id">組み合わせとして返す番号</param>
+        /// <param name="box">ワールド座標の境界箱</param>
+        /// <param name="group">自身の属するグループのビット</param>
+        /// <param name="mask">当たりを取りたい相手のグループのビット</param>
+        /// <param name="isStatic">動かないか</param>
+        void SetProxy(int id, const AABB& box, unsigned int group, unsigned int mask, bool isStatic) override;
+
+        /// <summary>
+        /// 1フレーム分の登録の終了（セル順に並べ替えて検索できるようにする）
+        /// </summary>
+        void EndFrame() override;
+
+        /// <summary>
+        /// 境界箱が重なっている組み合わせの列挙
+        /// </summary>
+        /// <param name="pairs">見つかった組み合わせの番号（呼び出し側の配列に追加する）</param>
+        void FindPairs(ArenaVector<pair<int, int>>& pairs) override;
+
+        /// <summary>
+        /// 範囲と重なる境界箱の検索
+        /// </summary>
+        /// <param name="box">調べる範囲</param>
+        /// <param name="groupMask">対象にするグループのビット</param>
+        /// <param name="ids">見つかった番号（呼び出し側の配列に追加する）</param>
+        void QueryOverlap(const AABB& box, unsigned int groupMask, ArenaVector<int>& ids) override;
+
+        /// <summary>
+        /// 線分と交差する境界箱の検索（線分を囲む範囲のセルを調べる）
+        /// </summary>
+        /// <param name="start">線分の始点</param>
+        /// <param name="end">線分の終点</param>
+        /// <param name="groupMask">対象にするグループのビット</param>
+        /// <param name="ids">見つかった番号（始点に近い順に、呼び出し側の配列に追加する）</param>
+        void QueryRay(const VECTOR& start, const VECTOR& end, unsigned int groupMask, ArenaVector<int>& ids) override;
+
+        /// <summary>
+        /// 登録された境界箱の数の取得
+        /// </summary>
+        /// <returns>登録された境界箱の数</returns>
+        int GetProxyNum() const override { return static_cast<int>(proxies.size()); }
+    };
+}// namespace My3dApp
\ No newline at end of file
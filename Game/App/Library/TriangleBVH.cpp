@@ -0,0 +1,835 @@
+#include "TriangleBVH.h"
+#include "Calc3D.h"
+#include <algorithm>
+#include <cmath>
+
+namespace My3dApp
+{
+    // 葉にまとめる三角形の数
+    const int leafTriangleNum = 4;
+
+    // 分割位置を探すときのビンの数
+    const int binNum = 12;
+
+    // 木の深さの上限（検索で使うスタックの大きさ）
+    const int maxDepth = 48;
+
+    /// <summary>
+    /// 球と箱の重なり判定（箱上の最近点との距離で調べる）
+    /// </summary>
+    static bool IsSphereOverlapBox(const VECTOR& center, float radius, const AABB& box)
+    {
+        const float x = center.x < box.minPos.x ? box.minPos.x - center.x : (box.maxPos.x < center.x ? center.x - box.maxPos.x : 0.0f);
+        const float y = center.y < box.minPos.y ? box.minPos.y - center.y : (box.maxPos.y < center.y ? center.y - box.maxPos.y : 0.0f);
+        const float z = center.z < box.minPos.z ? box.minPos.z - center.z : (box.maxPos.z < center.z ? center.z - box.maxPos.z : 0.0f);
+        return x * x + y * y + z * z <= radius * radius;
+    }
+
+    /// <summary>
+    /// 10ビットの値のビットの間に2ビットずつ空ける（モートン符号用）
+    /// </summary>
+    static unsigned int SpreadBits(unsigned int value)
+    {
+        value = (value | (value << 16)) & 0x030000FF;
+        value = (value | (value << 8)) & 0x0300F00F;
+        value = (value | (value << 4)) & 0x030C30C3;
+        value = (value | (value << 2)) & 0x09249249;
+        return value;
+    }
+
+    void MeshRayBatch::Clear()
+    {
+        starts.clear();
+        ends.clear();
+        hits.clear();
+    }
+
+    int MeshRayBatch::Add(const VECTOR& start, const VECTOR& end)
+    {
+        starts.push_back(start);
+        ends.push_back(end);
+        return static_cast<int>(starts.size()) - 1;
+    }
+
+    TriangleBVH::TriangleBVH()
+        : nodes()
+        , triangles()
+        , packets()
+        , nodeData(nullptr)
+        , triangleData(nullptr)
+        , packetData(nullptr)
+        , nodeNum(0)
+        , triangleNum(0)
+        , packetNum(0)
+    {
+        // 処理なし
+    }
+
+    void TriangleBVH::Build(const vector<VECTOR>& positions)
+    {
+        Attach(nullptr, 0, nullptr, 0, nullptr, 0);
+
+        const int triangleNum = static_cast<int>(positions.size()) / 3;
+        if (triangleNum == 0)
+        {
+            return;
+        }
+
+        // 三角形ごとの境界箱と中心を求める
+        vector<AABB> boxes(triangleNum);
+        vector<VECTOR> centers(triangleNum);
+        vector<int> order(triangleNum);
+
+        for (int i = 0; i < triangleNum; ++i)
+        {
+            const VECTOR& a = positions[i * 3];
+            const VECTOR& b = positions[i * 3 + 1];
+            const VECTOR& c = positions[i * 3 + 2];
+
+            boxes[i] = AABB(VGet(min(a.x, min(b.x, c.x)), min(a.y, min(b.y, c.y)), min(a.z, min(b.z, c.z))),
+                VGet(max(a.x, max(b.x, c.x)), max(a.y, max(b.y, c.y)), max(a.z, max(b.z, c.z))));
+            centers[i] = VScale(boxes[i].minPos + boxes[i].maxPos, 0.5f);
+            order[i] = i;
+        }
+
+        nodes.reserve(triangleNum * 2);
+        BuildNode(boxes, centers, order, 0, triangleNum, 0);
+
+        // 葉ごとに連続するように三角形を並べ替えて、法線を求めておく
+        triangles.resize(triangleNum);
+        for (int i = 0; i < triangleNum; ++i)
+        {
+            MeshTriangle& triangle = triangles[i];
+            triangle.position[0] = positions[order[i] * 3];
+            triangle.position[1] = positions[order[i] * 3 + 1];
+            triangle.position[2] = positions[order[i] * 3 + 2];
+
+            const VECTOR normal = VCross(triangle.position[1] - triangle.position[0], triangle.position[2] - triangle.position[0]);
+            const float length = VSize(normal);
+            triangle.normal = 0.0f < length ? VScale(normal, 1.0f / length) : VGet(0, 1, 0);
+        }
+
+        // 葉の三角形を先頭から4つずつまとめ、面と辺の情報を前もって求めておく
+        for (Node& node : nodes)
+        {
+            if (!node.count)
+            {
+                continue;
+            }
+
+            node.packet = static_cast<int>(packets.size());
+
+            for (int i = 0; i < node.count; i += TrianglePacket::laneNum)
+            {
+                packets.emplace_back();
+                packets.back().Load(&triangles[node.start + i], min(node.count - i, TrianglePacket::laneNum));
+            }
+        }
+
+        // 検索は自身の配列を指して行う
+        nodeData = nodes.data();
+        triangleData = triangles.data();
+        packetData = packets.data();
+        this->nodeNum = static_cast<int>(nodes.size());
+        this->triangleNum = triangleNum;
+        this->packetNum = static_cast<int>(packets.size());
+    }
+
+    void TriangleBVH::Attach(const Node* nodes, int nodeNum, const MeshTriangle* triangles, int triangleNum, const TrianglePacket* packets, int packetNum)
+    {
+        // 自身で作った木の領域は解放する
+        vector<Node>().swap(this->nodes);
+        vector<MeshTriangle>().swap(this->triangles);
+        vector<TrianglePacket>().swap(this->packets);
+
+        nodeData = nodes;
+        triangleData = triangles;
+        packetData = packets;
+        this->nodeNum = nodeNum;
+        this->triangleNum = triangleNum;
+        this->packetNum = packetNum;
+    }
+
+    bool TriangleBVH::IsValidTree(const Node* nodes, int nodeNum, int triangleNum, int packetNum)
+    {
+        if (nodeNum < 0 || triangleNum < 0 || packetNum < 0)
+        {
+            return false;
+        }
+
+        if (nodeNum == 0)
+        {
+            return true;
+        }
+
+        // 根からたどり、どの節も1度だけ訪れることを確かめる（子は親より後ろなので巡回しない）
+        vector<unsigned char> isVisited(nodeNum, 0);
+        vector<pair<int, int>> stack;
+        stack.emplace_back(0, 0);
+        int visitedNum = 0;
+
+        while (!stack.empty())
+        {
+            const int nodeIndex = stack.back().first;
+            const int depth = stack.back().second;
+            stack.pop_back();
+
+            if (isVisited[nodeIndex] || maxDepth <= depth)
+            {
+                return false;
+            }
+
+            isVisited[nodeIndex] = 1;
+            ++visitedNum;
+            const Node& node = nodes[nodeIndex];
+
+            if (node.count < 0)
+            {
+                return false;
+            }
+
+            if (!node.count)
+            {
+                if (nodeNum <= nodeIndex + 1 || node.rightChild <= nodeIndex + 1 || nodeNum <= node.rightChild)
+                {
+                    return false;
+                }
+
+                stack.emplace_back(node.rightChild, depth + 1);
+                stack.emplace_back(nodeIndex + 1, depth + 1);
+                continue;
+            }
+
+            const long long packetCount = (node.count + TrianglePacket::laneNum - 1) / TrianglePacket::laneNum;
+
+            if (node.start < 0 || triangleNum < static_cast<long long>(node.start) + node.count
+                || node.packet < 0 || packetNum < node.packet + packetCount)
+            {
+                return false;
+            }
+        }
+
+        return visitedNum == nodeNum;
+    }
+
+    int TriangleBVH::BuildNode(const vector<AABB>& boxes, const vector<VECTOR>& centers, vector<int>& order, int start, int count, int depth)
+    {
+        const int nodeIndex = static_cast<int>(nodes.size());
+        nodes.emplace_back();
+
+        // 範囲の三角形と中心を囲む箱
+        AABB box = boxes[order[start]];
+        AABB centerBox(centers[order[start]], centers[order[start]]);
+
+        for (int i = start + 1; i < start + count; ++i)
+        {
+            box.Merge(boxes[order[i]]);
+            centerBox.Merge(AABB(centers[order[i]], centers[order[i]]));
+        }
+
+        nodes[nodeIndex].box = box;
+        nodes[nodeIndex].start = start;
+        nodes[nodeIndex].count = count;
+        nodes[nodeIndex].rightChild = -1;
+        nodes[nodeIndex].packet = -1;
+
+        if (count <= leafTriangleNum || maxDepth <= depth + 1)
+        {
+            return nodeIndex;
+        }
+
+        // 中心の広がりが最も大きい軸で分ける
+        const float extent[3] =
+        {
+            centerBox.maxPos.x - centerBox.minPos.x,
+            centerBox.maxPos.y - centerBox.minPos.y,
+            centerBox.maxPos.z - centerBox.minPos.z,
+        };
+        const int axis = extent[0] < extent[1] ? (extent[1] < extent[2] ? 2 : 1) : (extent[0] < extent[2] ? 2 : 0);
+        const float axisMin = axis == 0 ? centerBox.minPos.x : (axis == 1 ? centerBox.minPos.y : centerBox.minPos.z);
+
+        // すべての中心が重なっていて分けられない
+        if (extent[axis] <= 0.0f)
+        {
+            return nodeIndex;
+        }
+
+        auto axisValue = [axis](const VECTOR& v) { return axis == 0 ? v.x : (axis == 1 ? v.y : v.z); };
+        auto binOf = [&](int triangle)
+        {
+            const int bin = static_cast<int>((axisValue(centers[triangle]) - axisMin) / extent[axis] * binNum);
+            return min(bin, binNum - 1);
+        };
+
+        // ビンごとに三角形の数と箱を集める
+        int binCount[binNum] = {};
+        AABB binBox[binNum];
+
+        for (int i = start; i < start + count; ++i)
+        {
+            const int bin = binOf(order[i]);
+            if (binCount[bin] == 0)
+            {
+                binBox[bin] = boxes[order[i]];
+            }
+            else
+            {
+                binBox[bin].Merge(boxes[order[i]]);
+            }
+            ++binCount[bin];
+        }
+
+        // 左右の表面積と三角形の数の積の和が最も小さい境界を選ぶ（表面積ヒューリスティック）
+        float rightArea[binNum];
+        int rightCount[binNum];
+        {
+            AABB accumulated;
+            int accumulatedCount = 0;
+
+            for (int bin = binNum - 1; 0 < bin; --bin)
+            {
+                if (binCount[bin] && accumulatedCount == 0)
+                {
+                    accumulated = binBox[bin];
+                }
+                else if (binCount[bin])
+                {
+                    accumulated.Merge(binBox[bin]);
+                }
+                accumulatedCount += binCount[bin];
+                rightArea[bin] = accumulatedCount ? accumulated.GetSurfaceArea() : 0.0f;
+                rightCount[bin] = accumulatedCount;
+            }
+        }
+
+        int bestSplit = -1;
+        float bestCost = 0.0f;
+        {
+            AABB accumulated;
+            int accumulatedCount = 0;
+
+            for (int split = 1; split < binNum; ++split)
+            {
+                const int bin = split - 1;
+                if (binCount[bin] && accumulatedCount == 0)
+                {
+                    accumulated = binBox[bin];
+                }
+                else if (binCount[bin])
+                {
+                    accumulated.Merge(binBox[bin]);
+                }
+                accumulatedCount += binCount[bin];
+
+                if (accumulatedCount == 0 || rightCount[split] == 0)
+                {
+                    continue;
+                }
+
+                const float cost = accumulated.GetSurfaceArea() * accumulatedCount + rightArea[split] * rightCount[split];
+                if (bestSplit == -1 || cost < bestCost)
+                {
+                    bestSplit = split;
+                    bestCost = cost;
+                }
+            }
+        }
+
+        // 境界より左のビンの三角形を前に集める（分けられなければ中央で分ける）
+        int middle = start + count / 2;
+
+        if (bestSplit != -1)
+        {
+            middle = static_cast<int>(partition(order.begin() + start, order.begin() + start + count,
+                [&](int triangle) { return binOf(triangle) < bestSplit; }) - order.begin());
+        }
+        else
+        {
+            nth_element(order.begin() + start, order.begin() + middle, order.begin() + start + count,
+                [&](int a, int b) { return axisValue(centers[a]) < axisValue(centers[b]); });
+        }
+
+        // 左の子は直後に作られ、右の子の添字だけ覚えておく
+        nodes[nodeIndex].count = 0;
+        BuildNode(boxes, centers, order, start, middle - start, depth + 1);
+        const int rightChild = BuildNode(boxes, centers, order, middle, start + count - middle, depth + 1);
+        nodes[nodeIndex].rightChild = rightChild;
+
+        return nodeIndex;
+    }
+
+    void TriangleBVH::BuildFromModel(int modelHandle)
+    {
+        // 位置・拡大率を反映したワールド座標の三角形を取り出す
+        MV1SetupReferenceMesh(modelHandle, -1, TRUE);
+        MV1_REF_POLYGONLIST refMesh = MV1GetReferenceMesh(modelHandle, -1, TRUE);
+
+        vector<VECTOR> positions;
+        positions.reserve(refMesh.PolygonNum * 3);
+
+        for (int i = 0; i < refMesh.PolygonNum; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                positions.push_back(refMesh.Vertexs[refMesh.Polygons[i].VIndex[j]].Position);
+            }
+        }
+
+        MV1TerminateReferenceMesh(modelHandle, -1, TRUE);
+
+        Build(positions);
+    }
+
+    bool TriangleBVH::AddHits(const Node& node, int packetOffset, unsigned int laneMask, MeshHitList& hitList) const
+    {
+        unsigned int addedMask = 0;
+
+        for (int lane = 0; lane < TrianglePacket::laneNum; ++lane)
+        {
+            if (!(laneMask & (1u << lane)))
+            {
+                continue;
+            }
+
+            if (MeshHitList::maxHitNum <= hitList.hitNum)
+            {
+                break;
+            }
+
+            hitList.triangles[hitList.hitNum++] = node.start + packetOffset * TrianglePacket::laneNum + lane;
+            addedMask |= 1u << lane;
+        }
+
+        if (addedMask)
+        {
+            hitList.packets[hitList.packetNum] = node.packet + packetOffset;
+            hitList.laneMasks[hitList.packetNum] = addedMask;
+            ++hitList.packetNum;
+        }
+
+        return hitList.hitNum < MeshHitList::maxHitNum;
+    }
+
+    int TriangleBVH::QuerySphere(const VECTOR& center, float radius, MeshHitList& hitList) const
+    {
+        hitList.hitNum = 0;
+        hitList.packetNum = 0;
+
+        if (nodeNum == 0)
+        {
+            return 0;
+        }
+
+
+        int stack[maxDepth + 1];
+        int stackNum = 0;
+        stack[stackNum++] = 0;
+
+        while (stackNum)
+        {
+            const int nodeIndex = stack[--stackNum];
+            const Node& node = nodeData[nodeIndex];
+
+            if (!IsSphereOverlapBox(center, radius, node.box))
+            {
+                continue;
+            }
+
+            if (!node.count)
+            {
+                stack[stackNum++] = node.rightChild;
+                stack[stackNum++] = nodeIndex + 1;
+                continue;
+            }
+
+            // 葉の三角形を4つずつまとめて調べる
+            const int packetNum = (node.count + TrianglePacket::laneNum - 1) / TrianglePacket::laneNum;
+
+            for (int i = 0; i < packetNum; ++i)
+            {
+                TrianglePacketClosest closest;
+                const unsigned int laneMask = CalcSphereContacts(packetData[node.packet + i], center, radius, closest);
+
+                if (laneMask && !AddHits(node, i, laneMask, hitList))
+                {
+                    return hitList.hitNum;
+                }
+            }
+        }
+
+        return hitList.hitNum;
+    }
+
+    int TriangleBVH::QueryCapsule(const VECTOR& start, const VECTOR& end, float radius, MeshHitList& hitList) const
+    {
+        hitList.hitNum = 0;
+        hitList.packetNum = 0;
+
+        if (nodeNum == 0)
+        {
+            return 0;
+        }
+
+        // カプセルを囲む箱で節を絞り込む
+        const VECTOR extent = VGet(radius, radius, radius);
+        AABB capsuleBox = CalcAABB(LineSegment(start, end));
+        capsuleBox.minPos = capsuleBox.minPos - extent;
+        capsuleBox.maxPos = capsuleBox.maxPos + extent;
+
+        int stack[maxDepth + 1];
+        int stackNum = 0;
+        stack[stackNum++] = 0;
+
+        while (stackNum)
+        {
+            const int nodeIndex = stack[--stackNum];
+            const Node& node = nodeData[nodeIndex];
+
+            if (!CollisionPair(capsuleBox, node.box))
+            {
+                continue;
+            }
+
+            if (!node.count)
+            {
+                stack[stackNum++] = node.rightChild;
+                stack[stackNum++] = nodeIndex + 1;
+                continue;
+            }
+
+            // 葉の三角形を4つずつまとめて調べる
+            const int packetNum = (node.count + TrianglePacket::laneNum - 1) / TrianglePacket::laneNum;
+
+            for (int i = 0; i < packetNum; ++i)
+            {
+                TrianglePacketCapsuleClosest closest;
+                const unsigned int laneMask = CalcCapsuleContacts(packetData[node.packet + i], start, end, radius, closest);
+
+                if (laneMask && !AddHits(node, i, laneMask, hitList))
+                {
+                    return hitList.hitNum;
+                }
+            }
+        }
+
+        return hitList.hitNum;
+    }
+
+    bool TriangleBVH::Raycast(const VECTOR& start, const VECTOR& end, MeshRayHit& hit) const
+    {
+        if (nodeNum == 0)
+        {
+            return false;
+        }
+
+        const VECTOR dir = end - start;
+        const float invDir[3] =
+        {
+            fabsf(dir.x) < 1.0e-12f ? 1.0e30f : 1.0f / dir.x,
+            fabsf(dir.y) < 1.0e-12f ? 1.0e30f : 1.0f / dir.y,
+            fabsf(dir.z) < 1.0e-12f ? 1.0e30f : 1.0f / dir.z,
+        };
+        const float starts[3] = { start.x, start.y, start.z };
+
+        // 見つかった交点より先の節は調べない
+        float nearestRate = 1.0f;
+        int nearestTriangle = -1;
+
+        int stack[maxDepth + 1];
+        int stackNum = 0;
+        stack[stackNum++] = 0;
+
+        while (stackNum)
+        {
+            const int nodeIndex = stack[--stackNum];
+            const Node& node = nodeData[nodeIndex];
+
+            // 箱のスラブに入る位置と出る位置の割合
+            const float mins[3] = { node.box.minPos.x, node.box.minPos.y, node.box.minPos.z };
+            const float maxs[3] = { node.box.maxPos.x, node.box.maxPos.y, node.box.maxPos.z };
+            float enter = 0.0f;
+            float leave = nearestRate;
+
+            for (int axis = 0; axis < 3 && enter <= leave; ++axis)
+            {
+                float slabEnter = (mins[axis] - starts[axis]) * invDir[axis];
+                float slabLeave = (maxs[axis] - starts[axis]) * invDir[axis];
+
+                if (slabLeave < slabEnter)
+                {
+                    swap(slabEnter, slabLeave);
+                }
+
+                enter = max(enter, slabEnter);
+                leave = min(leave, slabLeave);
+            }
+
+            if (leave < enter)
+            {
+                continue;
+            }
+
+            if (!node.count)
+            {
+                stack[stackNum++] = node.rightChild;
+                stack[stackNum++] = nodeIndex + 1;
+                continue;
+            }
+
+            // 葉の三角形を4つずつまとめて調べる
+            for (int i = 0; i < node.count; i += TrianglePacket::laneNum)
+            {
+                float hitRates[TrianglePacket::laneNum];
+                const unsigned int hitMask = IntersectSegment(packetData[node.packet + i / TrianglePacket::laneNum], start, dir, hitRates);
+
+                for (int lane = 0; lane < TrianglePacket::laneNum; ++lane)
+                {
+                    if ((hitMask & (1u << lane)) && hitRates[lane] < nearestRate)
+                    {
+                        nearestRate = hitRates[lane];
+                        nearestTriangle = node.start + i + lane;
+                    }
+                }
+            }
+        }
+
+        if (nearestTriangle == -1)
+        {
+            return false;
+        }
+
+        hit.triangle = nearestTriangle;
+        hit.hitRate = nearestRate;
+        hit.position = start + dir * nearestRate;
+        hit.normal = triangleData[nearestTriangle].normal;
+        return true;
+    }
+
+    bool TriangleBVH::SweepSphere(const VECTOR& start, const VECTOR& end, float radius, MeshRayHit& hit) const
+    {
+        if (nodeNum == 0)
+        {
+            return false;
+        }
+
+        const VECTOR dir = end - start;
+        const float invDir[3] =
+        {
+            fabsf(dir.x) < 1.0e-12f ? 1.0e30f : 1.0f / dir.x,
+            fabsf(dir.y) < 1.0e-12f ? 1.0e30f : 1.0f / dir.y,
+            fabsf(dir.z) < 1.0e-12f ? 1.0e30f : 1.0f / dir.z,
+        };
+        const float starts[3] = { start.x, start.y, start.z };
+
+        // 見つかった時刻より後に触れる節は調べない
+        float nearestTime = 1.0f;
+        int nearestTriangle = -1;
+
+        int stack[maxDepth + 1];
+        int stackNum = 0;
+        stack[stackNum++] = 0;
+
+        while (stackNum)
+        {
+            const int nodeIndex = stack[--stackNum];
+            const Node& node = nodeData[nodeIndex];
+
+            // 半径だけ広げた箱のスラブに入る時刻と出る時刻
+            const float mins[3] = { node.box.minPos.x - radius, node.box.minPos.y - radius, node.box.minPos.z - radius };
+            const float maxs[3] = { node.box.maxPos.x + radius, node.box.maxPos.y + radius, node.box.maxPos.z + radius };
+            float enter = 0.0f;
+            float leave = nearestTime;
+
+            for (int axis = 0; axis < 3 && enter <= leave; ++axis)
+            {
+                float slabEnter = (mins[axis] - starts[axis]) * invDir[axis];
+                float slabLeave = (maxs[axis] - starts[axis]) * invDir[axis];
+
+                if (slabLeave < slabEnter)
+                {
+                    swap(slabEnter, slabLeave);
+                }
+
+                enter = max(enter, slabEnter);
+                leave = min(leave, slabLeave);
+            }
+
+            if (leave < enter)
+            {
+                continue;
+            }
+
+            if (!node.count)
+            {
+                stack[stackNum++] = node.rightChild;
+                stack[stackNum++] = nodeIndex + 1;
+                continue;
+            }
+
+            // 通った範囲のカプセルと4つまとめて重なりを調べ、重なった三角形だけ衝突時刻を求める
+            const int packetNum = (node.count + TrianglePacket::laneNum - 1) / TrianglePacket::laneNum;
+
+            for (int i = 0; i < packetNum; ++i)
+            {
+                TrianglePacketCapsuleClosest closest;
+                const unsigned int laneMask = CalcCapsuleContacts(packetData[node.packet + i], start, end, radius, closest);
+
+                for (int lane = 0; lane < TrianglePacket::laneNum; ++lane)
+                {
+                    if (!(laneMask & (1u << lane)))
+                    {
+                        continue;
+                    }
+
+                    const int triangleIndex = node.start + i * TrianglePacket::laneNum + lane;
+                    const MeshTriangle& triangle = triangleData[triangleIndex];
+                    float hitTime;
+
+                    if (IntersectSweptSphereTriangle(start, end, radius, triangle.position[0], triangle.position[1], triangle.position[2], hitTime) && hitTime < nearestTime)
+                    {
+                        nearestTime = hitTime;
+                        nearestTriangle = triangleIndex;
+                    }
+                }
+            }
+        }
+
+        if (nearestTriangle == -1)
+        {
+            return false;
+        }
+
+        // 触れたときの球の中心と、三角形上の触れた点から中心へ向かう向き
+        const MeshTriangle& triangle = triangleData[nearestTriangle];
+        const VECTOR center = start + dir * nearestTime;
+        const VECTOR toCenter = center - CalcClosestPointOnTriangle(center, triangle.position[0], triangle.position[1], triangle.position[2]);
+        const float distance = VSize(toCenter);
+
+        hit.triangle = nearestTriangle;
+        hit.hitRate = nearestTime;
+        hit.position = center;
+        hit.normal = 1.0e-6f < distance ? VScale(toCenter, 1.0f / distance) : triangle.normal;
+        return true;
+    }
+
+    void TriangleBVH::RaycastBatch(MeshRayBatch& batch) const
+    {
+        const int rayNum = static_cast<int>(batch.starts.size());
+        MeshRayHit noHit;
+        noHit.triangle = -1;
+        noHit.hitRate = 1.0f;
+        noHit.position = VGet(0.0f, 0.0f, 0.0f);
+        noHit.normal = VGet(0.0f, 0.0f, 0.0f);
+        batch.hits.assign(rayNum, noHit);
+
+        if (nodeNum == 0 || rayNum == 0)
+        {
+            return;
+        }
+
+        // 始点を囲む箱の中で10ビットずつに量子化したモートン符号の順に並べ、近い線分を同じ束にする
+        AABB startBox(batch.starts[0], batch.starts[0]);
+        for (const VECTOR& start : batch.starts)
+        {
+            startBox.Merge(AABB(start, start));
+        }
+
+        const VECTOR extent = startBox.maxPos - startBox.minPos;
+        const VECTOR scale = VGet(0.0f < extent.x ? 1023.0f / extent.x : 0.0f, 0.0f < extent.y ? 1023.0f / extent.y : 0.0f, 0.0f < extent.z ? 1023.0f / extent.z : 0.0f);
+
+        batch.sortKeys.resize(rayNum);
+        for (int i = 0; i < rayNum; ++i)
+        {
+            const VECTOR cell = batch.starts[i] - startBox.minPos;
+            const unsigned int code = SpreadBits(static_cast<unsigned int>(cell.x * scale.x))
+                | (SpreadBits(static_cast<unsigned int>(cell.y * scale.y)) << 1)
+                | (SpreadBits(static_cast<unsigned int>(cell.z * scale.z)) << 2);
+            batch.sortKeys[i] = (static_cast<unsigned long long>(code) << 32) | static_cast<unsigned int>(i);
+        }
+
+        sort(batch.sortKeys.begin(), batch.sortKeys.end());
+
+        batch.order.resize(rayNum);
+        for (int i = 0; i < rayNum; ++i)
+        {
+            batch.order[i] = static_cast<int>(batch.sortKeys[i] & 0xFFFFFFFFu);
+        }
+
+        // 4本ずつ束ねて、どれかの線分が交わる節だけをたどる
+        for (int first = 0; first < rayNum; first += TrianglePacket::laneNum)
+        {
+            const int laneNum = min(rayNum - first, TrianglePacket::laneNum);
+            const int* indices = &batch.order[first];
+
+            RayPacket rays;
+            rays.Load(batch.starts.data(), batch.ends.data(), indices, laneNum);
+
+            int nearestTriangles[TrianglePacket::laneNum] = { -1, -1, -1, -1 };
+
+            int stack[maxDepth + 1];
+            int stackNum = 0;
+            stack[stackNum++] = 0;
+
+            while (stackNum)
+            {
+                const int nodeIndex = stack[--stackNum];
+                const Node& node = nodeData[nodeIndex];
+
+                const unsigned int rayMask = IntersectBox(rays, node.box.minPos, node.box.maxPos);
+                if (!rayMask)
+                {
+                    continue;
+                }
+
+                if (!node.count)
+                {
+                    stack[stackNum++] = node.rightChild;
+                    stack[stackNum++] = nodeIndex + 1;
+                    continue;
+                }
+
+                // 葉に届いた線分ごとに、三角形を4つずつまとめて調べる
+                for (int ray = 0; ray < laneNum; ++ray)
+                {
+                    if (!(rayMask & (1u << ray)))
+                    {
+                        continue;
+                    }
+
+                    const VECTOR start = VGet(rays.start[0][ray], rays.start[1][ray], rays.start[2][ray]);
+                    const VECTOR dir = VGet(rays.dir[0][ray], rays.dir[1][ray], rays.dir[2][ray]);
+
+                    for (int i = 0; i < node.count; i += TrianglePacket::laneNum)
+                    {
+                        float hitRates[TrianglePacket::laneNum];
+                        const unsigned int hitMask = IntersectSegment(packetData[node.packet + i / TrianglePacket::laneNum], start, dir, hitRates);
+
+                        for (int lane = 0; lane < TrianglePacket::laneNum; ++lane)
+                        {
+                            if ((hitMask & (1u << lane)) && hitRates[lane] < rays.maxRate[ray])
+                            {
+                                rays.maxRate[ray] = hitRates[lane];
+                                nearestTriangles[ray] = node.start + i + lane;
+                            }
+                        }
+                    }
+                }
+            }
+
+            for (int ray = 0; ray < laneNum; ++ray)
+            {
+                if (nearestTriangles[ray] == -1)
+                {
+                    continue;
+                }
+
+                MeshRayHit& hit = batch.hits[indices[ray]];
+                hit.triangle = nearestTriangles[ray];
+                hit.hitRate = rays.maxRate[ray];
+                hit.position = VGet(rays.start[0][ray], rays.start[1][ray], rays.start[2][ray])
+                    + VGet(rays.dir[0][ray], rays.dir[1][ray], rays.dir[2][ray]) * hit.hitRate;
+                hit.normal = triangleData[hit.triangle].normal;
+            }
+        }
+    }
+}// namespace My3dApp
\ No newline at end of file
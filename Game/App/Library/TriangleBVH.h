@@ -0,0 +1,306 @@
+#pragma once
+
+#include <vector>
+#include "DxLib.h"
+#include "Collision.h"
+#include "TrianglePacket.h"
+
+using namespace std;
+
+namespace My3dApp
+{
+    /// <summary>
+    /// 当たり判定用の三角形
+    /// </summary>
+    struct MeshTriangle
+    {
+        // 頂点座標
+        VECTOR position[3];
+
+        // 面の法線（正規化済み）
+        VECTOR normal;
+    };
+
+    /// <summary>
+    /// 球・カプセルと重なった三角形の一覧（呼び出し側のスタックに置く固定長のバッファ）
+    /// </summary>
+    struct MeshHitList
+    {
+        // 一度に返す三角形の最大数（壁の細かいメッシュでも足りる数）
+        static const int maxHitNum = 128;
+
+        // 当たった三角形の番号
+        int triangles[maxHitNum];
+
+        // 当たった三角形の数
+        int hitNum;
+
+        // 当たった三角形を含む4つ組の番号
+        int packets[maxHitNum];
+
+        // 4つ組のうち当たった三角形のビット
+        unsigned int laneMasks[maxHitNum];
+
+        // 当たった三角形を含む4つ組の数
+        int packetNum;
+    };
+
+    /// <summary>
+    /// 線分とメッシュの交点の情報
+    /// </summary>
+    struct MeshRayHit
+    {
+        // 当たった三角形の番号
+        int triangle;
+
+        // 始点からの交点の位置の割合（0～1）
+        float hitRate;
+
+        // 交点の座標
+        VECTOR position;
+
+        // 当たった三角形の法線
+        VECTOR normal;
+    };
+
+    /// <summary>
+    /// まとめて調べる線分の束（呼び出し側が持ち、確保した領域はフレームをまたいで使い回す）
+    /// </summary>
+    struct MeshRayBatch
+    {
+        /// <summary>
+        /// 線分をすべて削除する
+        /// </summary>
+        void Clear();
+
+        /// <summary>
+        /// 線分を加える
+        /// </summary>
+        /// <param name="start">線分の始点</param>
+        /// <param name="end">線分の終点</param>
+        /// <returns>線分の番号（結果の添字）</returns>
+        int Add(const VECTOR& start, const VECTOR& end);
+
+        // 線分の始点
+        vector<VECTOR> starts;
+
+        // 線分の終点
+        vector<VECTOR> ends;
+
+        // 線分ごとの始点に最も近い交点の情報（当たらなかった線分はtriangleが-1）
+        vector<MeshRayHit> hits;
+
+        // 並べ替えの作業領域（上位に始点のモートン符号、下位に線分の番号）
+        vector<unsigned long long> sortKeys;
+
+        // 並べ替えた線分の番号
+        vector<int> order;
+    };
+
+    /// <summary>
+    /// 動かないメッシュの三角形を囲む境界箱の木（読み込み時に1回だけ作る）
+    /// 検索は呼び出し側のバッファに書き込み、内部の状態を変えないのでワーカースレッドから同時に呼べる
+    /// </summary>
+    class TriangleBVH final
+    {
+    public:
+        /// <summary>
+        /// 木の節（深さ優先の順に並べ、左の子は直後の節）
+        /// </summary>
+        struct Node
+        {
+            // 子孫の三角形を囲む箱
+            AABB box;
+
+            // 葉の先頭の三角形の番号
+            int start;
+
+            // 葉の三角形の数（葉以外は0）
+            int count;
+
+            // 右の子の節（葉は使わない）
+            int rightChild;
+
+            // 葉の先頭の三角形の4つ組の番号（葉以外は使わない）
+            int packet;
+        };
+
+    private:
+        // 木の節（添字0が根）
+        vector<Node> nodes;
+
+        // 三角形（葉ごとに連続するように並べ替え済み）
+        vector<MeshTriangle> triangles;
+
+        // 葉の三角形を先頭から4つずつまとめたもの
+        vector<TrianglePacket> packets;
+
+        // 検索で使う節・三角形・4つ組の先頭（自身で作った場合は上の配列、読み込んだ場合はファイルの領域を指す）
+        const Node* nodeData;
+        const MeshTriangle* triangleData;
+        const TrianglePacket* packetData;
+
+        // 検索で使う節・三角形・4つ組の数
+        int nodeNum;
+        int triangleNum;
+        int packetNum;
+
+        /// <summary>
+        /// 4つ組の判定結果を当たった三角形の一覧に加える
+        /// </summary>
+        /// <param name="node">葉の節</param>
+        /// <param name="packetOffset">葉の中の4つ組の位置</param>
+        /// <param name="laneMask">当たった三角形のビット</param>
+        /// <param name="hitList">当たった三角形の一覧</param>
+        /// <returns>一覧がいっぱいになった場合はfalseを返す</returns>
+        bool AddHits(const Node& node, int packetOffset, unsigned int laneMask, MeshHitList& hitList) const;
+
+        /// <summary>
+        /// 三角形の範囲から節を作る（再帰）
+        /// </summary>
+        /// <param name="boxes">三角形ごとの境界箱</param>
+        /// <param name="centers">三角形ごとの境界箱の中心</param>
+        /// <param name="order">三角形の並び（範囲内を分割に合わせて並べ替える）</param>
+        /// <param name="start">範囲の先頭</param>
+        /// <param name="count">範囲の三角形の数</param>
+        /// <param name="depth">節の深さ</param>
+        /// <returns>作った節の添字</returns>
+        int BuildNode(const vector<AABB>& boxes, const vector<VECTOR>& centers, vector<int>& order, int start, int count, int depth);
+
+    public:
+        /// <summary>
+        /// コンストラクタ
+        /// </summary>
+        TriangleBVH();
+
+        // 外部の領域を指すことがあるのでコピーしない
+        TriangleBVH(const TriangleBVH&) = delete;
+        TriangleBVH& operator=(const TriangleBVH&) = delete;
+
+        /// <summary>
+        /// 三角形の頂点座標の並びから木を作る
+        /// </summary>
+        /// <param name="positions">三角形ごとに3頂点ずつ並べた座標</param>
+        void Build(const vector<VECTOR>& positions);
+
+        /// <summary>
+        /// モデルの参照用メッシュから木を作る（メインスレッドで読み込み時に呼ぶ）
+        /// </summary>
+        /// <param name="modelHandle">モデルのハンドル（位置・拡大率は設定済みのもの）</param>
+        void BuildFromModel(int modelHandle);
+
+        /// <summary>
+        /// 外部の領域（調理済みファイルを割り当てたメモリなど）にある木をそのまま使う
+        /// 領域は呼び出し側が持ち、この木を使い終わるまで残しておく
+        /// </summary>
+        /// <param name="nodes">節の先頭</param>
+        /// <param name="nodeNum">節の数</param>
+        /// <param name="triangles">三角形の先頭</param>
+        /// <param name="triangleNum">三角形の数</param>
+        /// <param name="packets">4つ組の先頭</param>
+        /// <param name="packetNum">4つ組の数</param>
+        void Attach(const Node* nodes, int nodeNum, const MeshTriangle* triangles, int triangleNum, const TrianglePacket* packets, int packetNum);
+
+        /// <summary>
+        /// 外部の領域にある木の並びが検索で範囲外を読まないか（Attachの前に調べる）
+        /// 節は根から1度ずつたどれ、左の子は次の節・右の子はそれより後ろで、深さは検索のスタックに収まること
+        /// 葉の三角形と4つ組はそれぞれの数の範囲に収まること
+        /// </summary>
+        /// <param name="nodes">節の先頭</param>
+        /// <param name="nodeNum">節の数</param>
+        /// <param name="triangleNum">三角形の数</param>
+        /// <param name="packetNum">4つ組の数</param>
+        /// <returns>そのまま使える場合はtrueを返す</returns>
+        static bool IsValidTree(const Node* nodes, int nodeNum, int triangleNum, int packetNum);
+
+        /// <summary>
+        /// 球と重なる三角形の検索（葉の三角形は4つまとめて調べる）
+        /// </summary>
+        /// <param name="center">球の中心</param>
+        /// <param name="radius">球の半径</param>
+        /// <param name="hitList">見つかった三角形の一覧（入りきらない分は捨てる）</param>
+        /// <returns>見つかった三角形の数</returns>
+        int QuerySphere(const VECTOR& center, float radius, MeshHitList& hitList) const;
+
+        /// <summary>
+        /// カプセルと重なる三角形の検索
+        /// </summary>
+        /// <param name="start">カプセルの始点</param>
+        /// <param name="end">カプセルの終点</param>
+        /// <param name="radius">カプセルの半径</param>
+        /// <param name="hitList">見つかった三角形の一覧（入りきらない分は捨てる）</param>
+        /// <returns>見つかった三角形の数</returns>
+        int QueryCapsule(const VECTOR& start, const VECTOR& end, float radius, MeshHitList& hitList) const;
+
+        /// <summary>
+        /// 線分と最初に交わる三角形の検索
+        /// </summary>
+        /// <param name="start">線分の始点</param>
+        /// <param name="end">線分の終点</param>
+        /// <param name="hit">始点に最も近い交点の情報</param>
+        /// <returns>交わる場合はtrueを返す</returns>
+        bool Raycast(const VECTOR& start, const VECTOR& end, MeshRayHit& hit) const;
+
+        /// <summary>
+        /// 移動する球が最初に触れる三角形の検索
+        /// 通った範囲のカプセルに重なる三角形だけ衝突時刻を求め、見つかった時刻より先の節は調べない
+        /// </summary>
+        /// <param name="start">球の中心の移動の始点</param>
+        /// <param name="end">球の中心の移動の終点</param>
+        /// <param name="radius">球の半径</param>
+        /// <param name="hit">最初に触れる三角形の情報（hitRateは時刻、positionは触れたときの球の中心、normalは押し返す向き）</param>
+        /// <returns>移動中に触れる場合はtrueを返す</returns>
+        bool SweepSphere(const VECTOR& start, const VECTOR& end, float radius, MeshRayHit& hit) const;
+
+        /// <summary>
+        /// 複数の線分と最初に交わる三角形をまとめて検索する
+        /// 始点の近い線分を4本ずつ束ねて木を1回でたどる（結果は線分を加えた順に入る）
+        /// </summary>
+        /// <param name="batch">線分の束</param>
+        void RaycastBatch(MeshRayBatch& batch) const;
+
+        /// <summary>
+        /// 三角形の取得
+        /// </summary>
+        /// <param name="index">三角形の番号</param>
+        /// <returns>三角形</returns>
+        const MeshTriangle& GetTriangle(int index) const { return triangleData[index]; }
+
+        /// <summary>
+        /// 三角形の4つ組の取得
+        /// </summary>
+        /// <param name="index">4つ組の番号</param>
+        /// <returns>三角形の4つ組</returns>
+        const TrianglePacket& GetPacket(int index) const { return packetData[index]; }
+
+        /// <summary>
+        /// 三角形の数の取得
+        /// </summary>
+        /// <returns>三角形の数</returns>
+        int GetTriangleNum() const { return triangleNum; }
+
+        /// <summary>
+        /// メッシュ全体を囲む境界箱の取得
+        /// </summary>
+        /// <returns>メッシュ全体を囲む境界箱（空なら大きさ0の箱）</returns>
+        AABB GetBounds() const { return nodeNum == 0 ? AABB() : nodeData[0].box; }
+
+        /// <summary>
+        /// 節の先頭の取得
+        /// </summary>
+        /// <returns>節の先頭（添字0が根）</returns>
+        const Node* GetNodeData() const { return nodeData; }
+
+        /// <summary>
+        /// 節の数の取得
+        /// </summary>
+        /// <returns>節の数</returns>
+        int GetNodeNum() const { return nodeNum; }
+
+        /// <summary>
+        /// 4つ組の数の取得
+        /// </summary>
+        /// <returns>4つ組の数</returns>
+        int GetPacketNum() const { return packetNum; }
+    };
+}// namespace My3dApp
\ No newline at end of file
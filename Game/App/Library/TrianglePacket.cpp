@@ -0,0 +1,677 @@
+#include "TrianglePacket.h"
+#include "TriangleBVH.h"
+#include "Calc3D.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#ifdef MY3DAPP_TRIANGLE_PACKET_SSE
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+namespace My3dApp
+{
+    // 空きの三角形の原点から面までの距離（どこからも遠く、2乗してもfloatに収まる大きさ）
+    const float emptyPlaneDistance = -1.0e18f;
+
+    void TrianglePacket::Load(const MeshTriangle* triangles, int num)
+    {
+        for (int lane = 0; lane < laneNum; ++lane)
+        {
+            // 空きと面積のない三角形は頂点を原点に置き、法線を0にして面だけを遠くに置く
+            VECTOR vertex[3] = { VGet(0.0f, 0.0f, 0.0f), VGet(0.0f, 0.0f, 0.0f), VGet(0.0f, 0.0f, 0.0f) };
+            VECTOR faceNormal = VGet(0.0f, 0.0f, 0.0f);
+            bool isEmpty = true;
+
+            if (lane < num)
+            {
+                const VECTOR cross = VCross(triangles[lane].position[1] - triangles[lane].position[0], triangles[lane].position[2] - triangles[lane].position[0]);
+                const float length = VSize(cross);
+
+                if (0.0f < length)
+                {
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        vertex[i] = triangles[lane].position[i];
+                    }
+                    faceNormal = VScale(cross, 1.0f / length);
+                    isEmpty = false;
+                }
+            }
+
+            for (int i = 0; i < 3; ++i)
+            {
+                position[i][0][lane] = vertex[i].x;
+                position[i][1][lane] = vertex[i].y;
+                position[i][2][lane] = vertex[i].z;
+            }
+
+            normal[0][lane] = faceNormal.x;
+            normal[1][lane] = faceNormal.y;
+            normal[2][lane] = faceNormal.z;
+            planeDistance[lane] = isEmpty ? emptyPlaneDistance : VDot(faceNormal, vertex[0]);
+
+            for (int edge = 0; edge < 3; ++edge)
+            {
+                const VECTOR edgeVec = vertex[edge == 2 ? 0 : edge + 1] - vertex[edge];
+                const VECTOR inward = VCross(faceNormal, edgeVec);
+                const float lengthSq = VDot(edgeVec, edgeVec);
+
+                edgeNormal[edge][0][lane] = inward.x;
+                edgeNormal[edge][1][lane] = inward.y;
+                edgeNormal[edge][2][lane] = inward.z;
+                invEdgeLengthSq[edge][lane] = 0.0f < lengthSq ? 1.0f / lengthSq : 0.0f;
+            }
+        }
+    }
+
+    void RayPacket::Load(const VECTOR* starts, const VECTOR* ends, const int* indices, int num)
+    {
+        for (int lane = 0; lane < TrianglePacket::laneNum; ++lane)
+        {
+            // 空きは1本目と同じ始点の長さ0の線分にして、調べる範囲も空にする
+            const VECTOR rayStart = starts[indices[lane < num ? lane : 0]];
+            const VECTOR rayDir = lane < num ? ends[indices[lane]] - rayStart : VGet(0.0f, 0.0f, 0.0f);
+            const float components[3][2] = { { rayStart.x, rayDir.x }, { rayStart.y, rayDir.y }, { rayStart.z, rayDir.z } };
+
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                start[axis][lane] = components[axis][0];
+                dir[axis][lane] = components[axis][1];
+                invDir[axis][lane] = fabsf(components[axis][1]) < 1.0e-12f ? 1.0e30f : 1.0f / components[axis][1];
+            }
+
+            maxRate[lane] = lane < num ? 1.0f : -1.0f;
+        }
+    }
+
+#ifdef MY3DAPP_TRIANGLE_PACKET_SSE
+    /// <summary>
+    /// マスクのビットが立っている成分はa、それ以外はbを選ぶ
+    /// </summary>
+    static inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    /// <summary>
+    /// 成分ごとに並べたベクトルの内積
+    /// </summary>
+    static inline __m128 Dot(const __m128* a, const __m128* b)
+    {
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])), _mm_mul_ps(a[2], b[2]));
+    }
+
+    /// <summary>
+    /// 0～1に収める
+    /// </summary>
+    static inline __m128 Saturate(__m128 value)
+    {
+        return _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    }
+
+    /// <summary>
+    /// 面上の点が3つの辺すべての内側にあるか
+    /// </summary>
+    /// <param name="vertex">頂点座標（[頂点][軸]）</param>
+    /// <param name="edgeNormal">辺の内側を向く法線（[辺][軸]）</param>
+    /// <param name="point">調べる点（[軸]）</param>
+    /// <returns>内側にある三角形の成分のビットがすべて立ったマスク</returns>
+    static inline __m128 IsInsideFace(const __m128 (*vertex)[3], const __m128 (*edgeNormal)[3], const __m128* point)
+    {
+        __m128 inside = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps());
+
+        for (int edge = 0; edge < 3; ++edge)
+        {
+            const __m128 diff[3] = { _mm_sub_ps(point[0], vertex[edge][0]), _mm_sub_ps(point[1], vertex[edge][1]), _mm_sub_ps(point[2], vertex[edge][2]) };
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(Dot(edgeNormal[edge], diff), _mm_setzero_ps()));
+        }
+
+        return inside;
+    }
+
+    unsigned int CalcSphereContacts(const TrianglePacket& packet, const VECTOR& center, float radius, TrianglePacketClosest& closest)
+    {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 radiusSq = _mm_set1_ps(radius * radius);
+        const __m128 p[3] = { _mm_set1_ps(center.x), _mm_set1_ps(center.y), _mm_set1_ps(center.z) };
+
+        // 面からの符号付きの距離
+        const __m128 n[3] = { _mm_loadu_ps(packet.normal[0]), _mm_loadu_ps(packet.normal[1]), _mm_loadu_ps(packet.normal[2]) };
+        const __m128 planeDistance = _mm_sub_ps(
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(n[0], p[0]), _mm_mul_ps(n[1], p[1])), _mm_mul_ps(n[2], p[2])),
+            _mm_loadu_ps(packet.planeDistance));
+        const __m128 planeDistanceSq = _mm_mul_ps(planeDistance, planeDistance);
+
+        // 面が球から離れている三角形は辺を調べるまでもなく当たらない
+        const int planeMask = _mm_movemask_ps(_mm_cmple_ps(planeDistanceSq, radiusSq));
+        if (!planeMask)
+        {
+            return 0;
+        }
+
+        // 3つの辺すべての内側にあれば、最近点は面に下ろした点になる
+        __m128 inside = _mm_cmpeq_ps(zero, zero);
+        __m128 vertex[3][3];
+        __m128 diff[3][3];
+
+        for (int edge = 0; edge < 3; ++edge)
+        {
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                vertex[edge][axis] = _mm_loadu_ps(packet.position[edge][axis]);
+                diff[edge][axis] = _mm_sub_ps(p[axis], vertex[edge][axis]);
+            }
+
+            const __m128 side = _mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(_mm_loadu_ps(packet.edgeNormal[edge][0]), diff[edge][0]),
+                _mm_mul_ps(_mm_loadu_ps(packet.edgeNormal[edge][1]), diff[edge][1])),
+                _mm_mul_ps(_mm_loadu_ps(packet.edgeNormal[edge][2]), diff[edge][2]));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(side, zero));
+        }
+
+        __m128 onFace[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            onFace[axis] = _mm_sub_ps(p[axis], _mm_mul_ps(planeDistance, n[axis]));
+        }
+
+        // 面が近い三角形がすべて面の内側なら辺を調べない（床や壁の真ん中に立っている場合）
+        const int insideMask = _mm_movemask_ps(inside);
+        if ((insideMask & planeMask) == planeMask)
+        {
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                _mm_storeu_ps(closest.position[axis], onFace[axis]);
+            }
+            _mm_storeu_ps(closest.distanceSq, planeDistanceSq);
+            return static_cast<unsigned int>(planeMask);
+        }
+
+        // 辺上の最近点のうち最も近いもの
+        __m128 edgeDistanceSq = _mm_set1_ps(FLT_MAX);
+        __m128 edgePos[3] = { zero, zero, zero };
+
+        for (int edge = 0; edge < 3; ++edge)
+        {
+            const int next = edge == 2 ? 0 : edge + 1;
+            __m128 edgeVec[3];
+
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                edgeVec[axis] = _mm_sub_ps(vertex[next][axis], vertex[edge][axis]);
+            }
+
+            // 辺上で点に最も近い位置の割合（0～1に収める）
+            __m128 rate = _mm_add_ps(_mm_add_ps(_mm_mul_ps(diff[edge][0], edgeVec[0]), _mm_mul_ps(diff[edge][1], edgeVec[1])), _mm_mul_ps(diff[edge][2], edgeVec[2]));
+            rate = _mm_min_ps(_mm_max_ps(_mm_mul_ps(rate, _mm_loadu_ps(packet.invEdgeLengthSq[edge])), zero), one);
+
+            __m128 onEdge[3];
+            __m128 distanceSq = zero;
+
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                onEdge[axis] = _mm_add_ps(vertex[edge][axis], _mm_mul_ps(edgeVec[axis], rate));
+                const __m128 toPoint = _mm_sub_ps(p[axis], onEdge[axis]);
+                distanceSq = _mm_add_ps(distanceSq, _mm_mul_ps(toPoint, toPoint));
+            }
+
+            const __m128 isCloser = _mm_cmplt_ps(distanceSq, edgeDistanceSq);
+            edgeDistanceSq = _mm_min_ps(distanceSq, edgeDistanceSq);
+
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                edgePos[axis] = Select(isCloser, onEdge[axis], edgePos[axis]);
+            }
+        }
+
+        // 面の内側なら面に下ろした点、外側なら最も近い辺上の点
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            _mm_storeu_ps(closest.position[axis], Select(inside, onFace[axis], edgePos[axis]));
+        }
+
+        const __m128 distanceSq = Select(inside, planeDistanceSq, edgeDistanceSq);
+        _mm_storeu_ps(closest.distanceSq, distanceSq);
+
+        return static_cast<unsigned int>(_mm_movemask_ps(_mm_cmple_ps(distanceSq, radiusSq)) & planeMask);
+    }
+
+    unsigned int CalcCapsuleContacts(const TrianglePacket& packet, const VECTOR& start, const VECTOR& end, float radius, TrianglePacketCapsuleClosest& closest)
+    {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 r = _mm_set1_ps(radius);
+        const VECTOR segmentVec = end - start;
+        const __m128 s[3] = { _mm_set1_ps(start.x), _mm_set1_ps(start.y), _mm_set1_ps(start.z) };
+        const __m128 e[3] = { _mm_set1_ps(end.x), _mm_set1_ps(end.y), _mm_set1_ps(end.z) };
+        const __m128 d[3] = { _mm_set1_ps(segmentVec.x), _mm_set1_ps(segmentVec.y), _mm_set1_ps(segmentVec.z) };
+
+        // 芯の両端の面からの符号付きの距離
+        const __m128 n[3] = { _mm_loadu_ps(packet.normal[0]), _mm_loadu_ps(packet.normal[1]), _mm_loadu_ps(packet.normal[2]) };
+        const __m128 planeDistance = _mm_loadu_ps(packet.planeDistance);
+        const __m128 startDistance = _mm_sub_ps(Dot(n, s), planeDistance);
+        const __m128 endDistance = _mm_sub_ps(Dot(n, e), planeDistance);
+
+        // 両端が面の同じ側で半径より離れている三角形は当たらない
+        const __m128 nearPlane = _mm_and_ps(
+            _mm_cmple_ps(_mm_min_ps(startDistance, endDistance), r),
+            _mm_cmpge_ps(_mm_max_ps(startDistance, endDistance), _mm_sub_ps(zero, r)));
+        const int planeMask = _mm_movemask_ps(nearPlane);
+        if (!planeMask)
+        {
+            return 0;
+        }
+
+        __m128 vertex[3][3];
+        __m128 edgeNormal[3][3];
+
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                vertex[i][axis] = _mm_loadu_ps(packet.position[i][axis]);
+                edgeNormal[i][axis] = _mm_loadu_ps(packet.edgeNormal[i][axis]);
+            }
+        }
+
+        // 最近点の組の候補のうち最も近いもの
+        __m128 bestDistanceSq = _mm_set1_ps(FLT_MAX);
+        __m128 bestTriangle[3] = { zero, zero, zero };
+        __m128 bestSegment[3] = { zero, zero, zero };
+
+        auto update = [&](__m128 candidate, __m128 distanceSq, const __m128* onTriangle, const __m128* onSegment)
+        {
+            const __m128 isCloser = _mm_and_ps(candidate, _mm_cmplt_ps(distanceSq, bestDistanceSq));
+            bestDistanceSq = Select(isCloser, distanceSq, bestDistanceSq);
+
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                bestTriangle[axis] = Select(isCloser, onTriangle[axis], bestTriangle[axis]);
+                bestSegment[axis] = Select(isCloser, onSegment[axis], bestSegment[axis]);
+            }
+        };
+
+        // 芯が面を貫く点が三角形の内側なら距離0
+        const __m128 crossing = _mm_and_ps(_mm_cmple_ps(_mm_mul_ps(startDistance, endDistance), zero), _mm_cmpneq_ps(startDistance, endDistance));
+        const __m128 crossRate = _mm_div_ps(startDistance, Select(crossing, _mm_sub_ps(startDistance, endDistance), one));
+        __m128 pierce[3];
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            pierce[axis] = _mm_add_ps(s[axis], _mm_mul_ps(d[axis], crossRate));
+        }
+
+        const __m128 pierceInside = _mm_and_ps(crossing, IsInsideFace(vertex, edgeNormal, pierce));
+        update(pierceInside, zero, pierce, pierce);
+
+        // 端点を面に下ろした点が三角形の内側なら、面までの距離
+        __m128 startOnFace[3];
+        __m128 endOnFace[3];
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            startOnFace[axis] = _mm_sub_ps(s[axis], _mm_mul_ps(startDistance, n[axis]));
+            endOnFace[axis] = _mm_sub_ps(e[axis], _mm_mul_ps(endDistance, n[axis]));
+        }
+
+        const __m128 startInside = IsInsideFace(vertex, edgeNormal, startOnFace);
+        const __m128 endInside = IsInsideFace(vertex, edgeNormal, endOnFace);
+        update(startInside, _mm_mul_ps(startDistance, startDistance), startOnFace, s);
+        update(endInside, _mm_mul_ps(endDistance, endDistance), endOnFace, e);
+
+        // 貫いているか両端とも面の内側なら、芯全体が面の上にあるので辺は調べない（床や壁の真ん中に立っている場合）
+        const int faceMask = _mm_movemask_ps(_mm_or_ps(pierceInside, _mm_and_ps(startInside, endInside)));
+
+        if ((faceMask & planeMask) != planeMask)
+        {
+            // 芯と3つの辺それぞれの最近点の組（無限直線同士の最近点を求めてから線分の範囲に収める）
+            const float segmentLengthSq = VDot(segmentVec, segmentVec);
+            const __m128 a = _mm_set1_ps(segmentLengthSq);
+            const __m128 invA = _mm_set1_ps(1.0e-8f < segmentLengthSq ? 1.0f / segmentLengthSq : 0.0f);
+
+            for (int edge = 0; edge < 3; ++edge)
+            {
+                const int next = edge == 2 ? 0 : edge + 1;
+                __m128 edgeVec[3];
+                __m128 diff[3];
+
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    edgeVec[axis] = _mm_sub_ps(vertex[next][axis], vertex[edge][axis]);
+                    diff[axis] = _mm_sub_ps(s[axis], vertex[edge][axis]);
+                }
+
+                const __m128 b = Dot(d, edgeVec);
+                const __m128 c = Dot(d, diff);
+                const __m128 f = Dot(edgeVec, diff);
+                const __m128 edgeLengthSq = Dot(edgeVec, edgeVec);
+                const __m128 denom = _mm_sub_ps(_mm_mul_ps(a, edgeLengthSq), _mm_mul_ps(b, b));
+
+                // 平行な場合は芯の始点から求める
+                const __m128 isSkew = _mm_cmpgt_ps(denom, _mm_set1_ps(1.0e-8f));
+                __m128 segmentRate = Select(isSkew,
+                    Saturate(_mm_div_ps(_mm_sub_ps(_mm_mul_ps(b, f), _mm_mul_ps(c, edgeLengthSq)), Select(isSkew, denom, one))),
+                    zero);
+                const __m128 edgeRate = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(b, segmentRate), f), _mm_loadu_ps(packet.invEdgeLengthSq[edge]));
+
+                // 辺の範囲からはみ出した場合は、辺の端点に最も近い芯の上の点にする
+                segmentRate = Select(_mm_cmplt_ps(edgeRate, zero), Saturate(_mm_mul_ps(_mm_sub_ps(zero, c), invA)),
+                    Select(_mm_cmpgt_ps(edgeRate, one), Saturate(_mm_mul_ps(_mm_sub_ps(b, c), invA)), segmentRate));
+                const __m128 clampedEdgeRate = Saturate(edgeRate);
+
+                __m128 onSegment[3];
+                __m128 onEdge[3];
+                __m128 distanceSq = zero;
+
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    onSegment[axis] = _mm_add_ps(s[axis], _mm_mul_ps(d[axis], segmentRate));
+                    onEdge[axis] = _mm_add_ps(vertex[edge][axis], _mm_mul_ps(edgeVec[axis], clampedEdgeRate));
+                    const __m128 toSegment = _mm_sub_ps(onSegment[axis], onEdge[axis]);
+                    distanceSq = _mm_add_ps(distanceSq, _mm_mul_ps(toSegment, toSegment));
+                }
+
+                update(nearPlane, distanceSq, onEdge, onSegment);
+            }
+        }
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            _mm_storeu_ps(closest.position[axis], bestTriangle[axis]);
+            _mm_storeu_ps(closest.segmentPosition[axis], bestSegment[axis]);
+        }
+        _mm_storeu_ps(closest.distanceSq, bestDistanceSq);
+
+        return static_cast<unsigned int>(_mm_movemask_ps(_mm_cmple_ps(bestDistanceSq, _mm_mul_ps(r, r))) & planeMask);
+    }
+
+    unsigned int IntersectSegment(const TrianglePacket& packet, const VECTOR& start, const VECTOR& dir, float* hitRates)
+    {
+        // Moller-Trumboreの方法を4つの三角形に同時に使う
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 d[3] = { _mm_set1_ps(dir.x), _mm_set1_ps(dir.y), _mm_set1_ps(dir.z) };
+
+        __m128 edge1[3];
+        __m128 edge2[3];
+        __m128 tvec[3];
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const __m128 a = _mm_loadu_ps(packet.position[0][axis]);
+            edge1[axis] = _mm_sub_ps(_mm_loadu_ps(packet.position[1][axis]), a);
+            edge2[axis] = _mm_sub_ps(_mm_loadu_ps(packet.position[2][axis]), a);
+            tvec[axis] = _mm_sub_ps(_mm_set1_ps(axis == 0 ? start.x : (axis == 1 ? start.y : start.z)), a);
+        }
+
+        const __m128 pvec[3] =
+        {
+            _mm_sub_ps(_mm_mul_ps(d[1], edge2[2]), _mm_mul_ps(d[2], edge2[1])),
+            _mm_sub_ps(_mm_mul_ps(d[2], edge2[0]), _mm_mul_ps(d[0], edge2[2])),
+            _mm_sub_ps(_mm_mul_ps(d[0], edge2[1]), _mm_mul_ps(d[1], edge2[0])),
+        };
+        const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(edge1[0], pvec[0]), _mm_mul_ps(edge1[1], pvec[1])), _mm_mul_ps(edge1[2], pvec[2]));
+
+        // 三角形の面と平行なもの（空きや面積のない三角形も含む）は除く
+        const __m128 absDet = _mm_andnot_ps(_mm_set1_ps(-0.0f), det);
+        __m128 valid = _mm_cmpge_ps(absDet, _mm_set1_ps(1.0e-8f));
+        if (!_mm_movemask_ps(valid))
+        {
+            return 0;
+        }
+
+        const __m128 invDet = _mm_div_ps(one, Select(valid, det, one));
+
+        const __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tvec[0], pvec[0]), _mm_mul_ps(tvec[1], pvec[1])), _mm_mul_ps(tvec[2], pvec[2])), invDet);
+        valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+
+        const __m128 qvec[3] =
+        {
+            _mm_sub_ps(_mm_mul_ps(tvec[1], edge1[2]), _mm_mul_ps(tvec[2], edge1[1])),
+            _mm_sub_ps(_mm_mul_ps(tvec[2], edge1[0]), _mm_mul_ps(tvec[0], edge1[2])),
+            _mm_sub_ps(_mm_mul_ps(tvec[0], edge1[1]), _mm_mul_ps(tvec[1], edge1[0])),
+        };
+
+        const __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(d[0], qvec[0]), _mm_mul_ps(d[1], qvec[1])), _mm_mul_ps(d[2], qvec[2])), invDet);
+        valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+
+        const __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(edge2[0], qvec[0]), _mm_mul_ps(edge2[1], qvec[1])), _mm_mul_ps(edge2[2], qvec[2])), invDet);
+        valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(t, zero), _mm_cmple_ps(t, one)));
+
+        _mm_storeu_ps(hitRates, t);
+        return static_cast<unsigned int>(_mm_movemask_ps(valid));
+    }
+
+    unsigned int IntersectBox(const RayPacket& rays, const VECTOR& minPos, const VECTOR& maxPos)
+    {
+        // スラブごとに入る位置と出る位置の割合を求め、範囲を狭めていく
+        __m128 enter = _mm_setzero_ps();
+        __m128 leave = _mm_loadu_ps(rays.maxRate);
+        const float mins[3] = { minPos.x, minPos.y, minPos.z };
+        const float maxs[3] = { maxPos.x, maxPos.y, maxPos.z };
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const __m128 start = _mm_loadu_ps(rays.start[axis]);
+            const __m128 invDir = _mm_loadu_ps(rays.invDir[axis]);
+            const __m128 slab1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(mins[axis]), start), invDir);
+            const __m128 slab2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(maxs[axis]), start), invDir);
+
+            enter = _mm_max_ps(enter, _mm_min_ps(slab1, slab2));
+            leave = _mm_min_ps(leave, _mm_max_ps(slab1, slab2));
+        }
+
+        return static_cast<unsigned int>(_mm_movemask_ps(_mm_cmple_ps(enter, leave)));
+    }
+#else
+    unsigned int CalcSphereContacts(const TrianglePacket& packet, const VECTOR& center, float radius, TrianglePacketClosest& closest)
+    {
+        const float p[3] = { center.x, center.y, center.z };
+        unsigned int contactMask = 0;
+
+        for (int lane = 0; lane < TrianglePacket::laneNum; ++lane)
+        {
+            // 面が球から離れている三角形は辺を調べるまでもなく当たらない
+            const float planeDistance = packet.normal[0][lane] * p[0] + packet.normal[1][lane] * p[1] + packet.normal[2][lane] * p[2] - packet.planeDistance[lane];
+            if (radius * radius < planeDistance * planeDistance)
+            {
+                continue;
+            }
+
+            // 3つの辺すべての内側にあれば、最近点は面に下ろした点になる
+            bool inside = true;
+
+            // 辺上の最近点のうち最も近いもの
+            float edgeDistanceSq = FLT_MAX;
+            float edgePos[3] = {};
+
+            for (int edge = 0; edge < 3; ++edge)
+            {
+                const int next = edge == 2 ? 0 : edge + 1;
+                float edgeVec[3];
+                float diff[3];
+                float side = 0.0f;
+                float rate = 0.0f;
+
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    edgeVec[axis] = packet.position[next][axis][lane] - packet.position[edge][axis][lane];
+                    diff[axis] = p[axis] - packet.position[edge][axis][lane];
+                    side += packet.edgeNormal[edge][axis][lane] * diff[axis];
+                    rate += diff[axis] * edgeVec[axis];
+                }
+                inside = inside && 0.0f <= side;
+
+                // 辺上で点に最も近い位置の割合（0～1に収める）
+                rate = min(max(rate * packet.invEdgeLengthSq[edge][lane], 0.0f), 1.0f);
+
+                float onEdge[3];
+                float distanceSq = 0.0f;
+
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    onEdge[axis] = packet.position[edge][axis][lane] + edgeVec[axis] * rate;
+                    distanceSq += (p[axis] - onEdge[axis]) * (p[axis] - onEdge[axis]);
+                }
+
+                if (distanceSq < edgeDistanceSq)
+                {
+                    edgeDistanceSq = distanceSq;
+                    edgePos[0] = onEdge[0];
+                    edgePos[1] = onEdge[1];
+                    edgePos[2] = onEdge[2];
+                }
+            }
+
+            // 面の内側なら面に下ろした点、外側なら最も近い辺上の点
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                closest.position[axis][lane] = inside ? p[axis] - planeDistance * packet.normal[axis][lane] : edgePos[axis];
+            }
+
+            closest.distanceSq[lane] = inside ? planeDistance * planeDistance : edgeDistanceSq;
+
+            if (closest.distanceSq[lane] <= radius * radius)
+            {
+                contactMask |= 1u << lane;
+            }
+        }
+
+        return contactMask;
+    }
+
+    unsigned int CalcCapsuleContacts(const TrianglePacket& packet, const VECTOR& start, const VECTOR& end, float radius, TrianglePacketCapsuleClosest& closest)
+    {
+        unsigned int contactMask = 0;
+
+        for (int lane = 0; lane < TrianglePacket::laneNum; ++lane)
+        {
+            // 両端が面の同じ側で半径より離れている三角形は当たらない
+            const VECTOR normal = VGet(packet.normal[0][lane], packet.normal[1][lane], packet.normal[2][lane]);
+            const float startDistance = VDot(normal, start) - packet.planeDistance[lane];
+            const float endDistance = VDot(normal, end) - packet.planeDistance[lane];
+
+            if (radius < min(startDistance, endDistance) || max(startDistance, endDistance) < -radius)
+            {
+                continue;
+            }
+
+            const VECTOR a = VGet(packet.position[0][0][lane], packet.position[0][1][lane], packet.position[0][2][lane]);
+            const VECTOR b = VGet(packet.position[1][0][lane], packet.position[1][1][lane], packet.position[1][2][lane]);
+            const VECTOR c = VGet(packet.position[2][0][lane], packet.position[2][1][lane], packet.position[2][2][lane]);
+
+            VECTOR onTriangle;
+            VECTOR onSegment;
+            float distanceSq;
+            float hitRate;
+
+            if (IntersectSegmentTriangle(start, end, a, b, c, hitRate))
+            {
+                // 芯が三角形を貫いている
+                onTriangle = start + (end - start) * hitRate;
+                onSegment = onTriangle;
+                distanceSq = 0.0f;
+            }
+            else
+            {
+                // 芯の両端と三角形、芯と三角形の各辺の最近点の組のうち最も近いもの
+                onSegment = start;
+                onTriangle = CalcClosestPointOnTriangle(start, a, b, c);
+                distanceSq = VDot(start - onTriangle, start - onTriangle);
+
+                const VECTOR endOnTriangle = CalcClosestPointOnTriangle(end, a, b, c);
+                const float endDistanceSq = VDot(end - endOnTriangle, end - endOnTriangle);
+                if (endDistanceSq < distanceSq)
+                {
+                    onSegment = end;
+                    onTriangle = endOnTriangle;
+                    distanceSq = endDistanceSq;
+                }
+
+                const VECTOR vertex[3] = { a, b, c };
+                for (int edge = 0; edge < 3; ++edge)
+                {
+                    VECTOR segmentPos;
+                    VECTOR edgePos;
+                    const float edgeDistanceSq = CalcClosestPointsSegmentSegment(start, end, vertex[edge], vertex[edge == 2 ? 0 : edge + 1], segmentPos, edgePos);
+
+                    if (edgeDistanceSq < distanceSq)
+                    {
+                        onSegment = segmentPos;
+                        onTriangle = edgePos;
+                        distanceSq = edgeDistanceSq;
+                    }
+                }
+            }
+
+            closest.position[0][lane] = onTriangle.x;
+            closest.position[1][lane] = onTriangle.y;
+            closest.position[2][lane] = onTriangle.z;
+            closest.segmentPosition[0][lane] = onSegment.x;
+            closest.segmentPosition[1][lane] = onSegment.y;
+            closest.segmentPosition[2][lane] = onSegment.z;
+            closest.distanceSq[lane] = distanceSq;
+
+            if (distanceSq <= radius * radius)
+            {
+                contactMask |= 1u << lane;
+            }
+        }
+
+        return contactMask;
+    }
+
+    unsigned int IntersectSegment(const TrianglePacket& packet, const VECTOR& start, const VECTOR& dir, float* hitRates)
+    {
+        unsigned int hitMask = 0;
+
+        for (int lane = 0; lane < TrianglePacket::laneNum; ++lane)
+        {
+            const VECTOR a = VGet(packet.position[0][0][lane], packet.position[0][1][lane], packet.position[0][2][lane]);
+            const VECTOR b = VGet(packet.position[1][0][lane], packet.position[1][1][lane], packet.position[1][2][lane]);
+            const VECTOR c = VGet(packet.position[2][0][lane], packet.position[2][1][lane], packet.position[2][2][lane]);
+
+            if (IntersectSegmentTriangle(start, start + dir, a, b, c, hitRates[lane]))
+            {
+                hitMask |= 1u << lane;
+            }
+        }
+
+        return hitMask;
+    }
+
+    unsigned int IntersectBox(const RayPacket& rays, const VECTOR& minPos, const VECTOR& maxPos)
+    {
+        const float mins[3] = { minPos.x, minPos.y, minPos.z };
+        const float maxs[3] = { maxPos.x, maxPos.y, maxPos.z };
+        unsigned int hitMask = 0;
+
+        for (int lane = 0; lane < TrianglePacket::laneNum; ++lane)
+        {
+            // スラブごとに入る位置と出る位置の割合を求め、範囲を狭めていく
+            float enter = 0.0f;
+            float leave = rays.maxRate[lane];
+
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                const float slab1 = (mins[axis] - rays.start[axis][lane]) * rays.invDir[axis][lane];
+                const float slab2 = (maxs[axis] - rays.start[axis][lane]) * rays.invDir[axis][lane];
+
+                enter = max(enter, min(slab1, slab2));
+                leave = min(leave, max(slab1, slab2));
+            }
+
+            if (enter <= leave)
+            {
+                hitMask |= 1u << lane;
+            }
+        }
+
+        return hitMask;
+    }
+#endif
+}// namespace My3dApp
\ No newline at end of file
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "DxLib.h"
+
+// SSE2が使える環境では4つの三角形を1命令でまとめて計算する（それ以外は同じ計算をループで行う）
+#if defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && 2 <= _M_IX86_FP) || defined(__SSE2__)
+#define MY3DAPP_TRIANGLE_PACKET_SSE 1
+#endif
+
+namespace My3dApp
+{
+    struct MeshTriangle;
+
+    /// <summary>
+    /// 4つの三角形を成分ごとに並べたもの（まとめて判定するために面と辺の情報を前もって求めておく）
+    /// 4つに満たない分や面積のない三角形は、どこからも当たらない三角形で埋める
+    /// </summary>
+    struct TrianglePacket
+    {
+        // まとめて計算する三角形の数
+        static const int laneNum = 4;
+
+        // 頂点座標（[頂点][軸][三角形]）
+        float position[3][3][laneNum];
+
+        // 面の法線（[軸][三角形]）
+        float normal[3][laneNum];
+
+        // 原点から面までの距離
+        float planeDistance[laneNum];
+
+        // 辺（頂点0→1、1→2、2→0）の三角形の内側を向く法線（[辺][軸][三角形]）
+        float edgeNormal[3][3][laneNum];
+
+        // 辺の長さの2乗の逆数（[辺][三角形]）
+        float invEdgeLengthSq[3][laneNum];
+
+        /// <summary>
+        /// 三角形を読み込んで面と辺の情報を求める
+        /// </summary>
+        /// <param name="triangles">三角形の並びの先頭</param>
+        /// <param name="num">読み込む三角形の数（laneNum以下）</param>
+        void Load(const MeshTriangle* triangles, int num);
+    };
+
+    /// <summary>
+    /// 4本の線分を成分ごとに並べたもの（まとめて木をたどるのに使う、足りない分は長さ0の線分で埋める）
+    /// </summary>
+    struct RayPacket
+    {
+        // 線分の始点（[軸][線分]）
+        float start[3][TrianglePacket::laneNum];
+
+        // 線分の始点から終点へのベクトル（[軸][線分]）
+        float dir[3][TrianglePacket::laneNum];
+
+        // 線分の向きの各成分の逆数（0の成分は十分大きな値にする）
+        float invDir[3][TrianglePacket::laneNum];
+
+        // 調べる範囲の終わりの割合（交点が見つかるたびに縮める）
+        float maxRate[TrianglePacket::laneNum];
+
+        /// <summary>
+        /// 線分を読み込む
+        /// </summary>
+        /// <param name="starts">線分の始点の並び</param>
+        /// <param name="ends">線分の終点の並び</param>
+        /// <param name="indices">読み込む線分の番号</param>
+        /// <param name="num">読み込む線分の数（laneNum以下）</param>
+        void Load(const VECTOR* starts, const VECTOR* ends, const int* indices, int num);
+    };
+
+    /// <summary>
+    /// 球と4つの三角形それぞれの最近点
+    /// </summary>
+    struct TrianglePacketClosest
+    {
+        // 三角形上の球の中心に最も近い点（[軸][三角形]）
+        float position[3][TrianglePacket::laneNum];
+
+        // 最近点までの距離の2乗
+        float distanceSq[TrianglePacket::laneNum];
+    };
+
+    /// <summary>
+    /// カプセルと4つの三角形それぞれの最近点の組
+    /// </summary>
+    struct TrianglePacketCapsuleClosest
+    {
+        // 三角形上のカプセルの芯に最も近い点（[軸][三角形]）
+        float position[3][TrianglePacket::laneNum];
+
+        // カプセルの芯の上の三角形に最も近い点（[軸][三角形]）
+        float segmentPosition[3][TrianglePacket::laneNum];
+
+        // 最近点同士の距離の2乗（芯が三角形を貫いていれば0）
+        float distanceSq[TrianglePacket::laneNum];
+    };
+
+    /// <summary>
+    /// 球と4つの三角形の接触の計算（面が球から離れている三角形は最近点を求めずに除く）
+    /// </summary>
+    /// <param name="packet">4つの三角形</param>
+    /// <param name="center">球の中心</param>
+    /// <param name="radius">球の半径</param>
+    /// <param name="closest">三角形ごとの最近点（戻り値のビットが立っている三角形だけ入る）</param>
+    /// <returns>球と重なる三角形のビット</returns>
+    unsigned int CalcSphereContacts(const TrianglePacket& packet, const VECTOR& center, float radius, TrianglePacketClosest& closest);
+
+    /// <summary>
+    /// カプセルと4つの三角形の接触の計算（芯の両端が面の同じ側で離れている三角形は最近点を求めずに除く）
+    /// </summary>
+    /// <param name="packet">4つの三角形</param>
+    /// <param name="start">カプセルの芯の始点</param>
+    /// <param name="end">カプセルの芯の終点</param>
+    /// <param name="radius">カプセルの半径</param>
+    /// <param name="closest">三角形ごとの最近点の組（戻り値のビットが立っている三角形だけ入る）</param>
+    /// <returns>カプセルと重なる三角形のビット</returns>
+    unsigned int CalcCapsuleContacts(const TrianglePacket& packet, const VECTOR& start, const VECTOR& end, float radius, TrianglePacketCapsuleClosest& closest);
+
+    /// <summary>
+    /// 線分と4つの三角形の交差判定（表裏どちらからでも当たる）
+    /// </summary>
+    /// <param name="packet">4つの三角形</param>
+    /// <param name="start">線分の始点</param>
+    /// <param name="dir">線分の始点から終点へのベクトル</param>
+    /// <param name="hitRates">三角形ごとの始点からの交点の位置の割合（戻り値のビットが立っている三角形だけ入る）</param>
+    /// <returns>線分と交差する三角形のビット</returns>
+    unsigned int IntersectSegment(const TrianglePacket& packet, const VECTOR& start, const VECTOR& dir, float* hitRates);
+
+    /// <summary>
+    /// 4本の線分と箱の交差判定
+    /// </summary>
+    /// <param name="rays">4本の線分</param>
+    /// <param name="minPos">箱の最小座標</param>
+    /// <param name="maxPos">箱の最大座標</param>
+    /// <returns>調べる範囲の中で箱と交差する線分のビット</returns>
+    unsigned int IntersectBox(const RayPacket& rays, const VECTOR& minPos, const VECTOR& maxPos);
+}// namespace My3dApp
\ No newline at end of file
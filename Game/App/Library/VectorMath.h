@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cmath>
+#include "DxLib.h"
+
+// SSE2が使える環境ではまとめて計算する関数を4成分ずつ1命令で計算する（それ以外は同じ計算をループで行う）
+#if defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && 2 <= _M_IX86_FP) || defined(__SSE2__)
+#define MY3DAPP_VECTOR_MATH_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace My3dApp
+{
+    /// <summary>
+    /// ベクトルの並びへの加算（dst[i] += src[i]）
+    /// VECTORの並びを成分の並びとみなして4成分ずつ計算する
+    /// </summary>
+    /// <param name="dst">加算されるベクトルの並び</param>
+    /// <param name="src">加算するベクトルの並び</param>
+    /// <param name="num">ベクトルの数</param>
+    inline void AddVectors(VECTOR* dst, const VECTOR* src, int num)
+    {
+        float* d = &dst->x;
+        const float* s = &src->x;
+        const int floatNum = num * 3;
+        int i = 0;
+
+#ifdef MY3DAPP_VECTOR_MATH_SSE
+        for (; i + 4 <= floatNum; i += 4)
+        {
+            _mm_storeu_ps(d + i, _mm_add_ps(_mm_loadu_ps(d + i), _mm_loadu_ps(s + i)));
+        }
+#endif
+
+        for (; i < floatNum; ++i)
+        {
+            d[i] += s[i];
+        }
+    }
+
+    /// <summary>
+    /// Y軸回りの向き（XZ平面の長さ1のベクトルを単位複素数として持ち、三角関数や行列を使わずに回す）
+    /// 角度の正の向きはMGetRotYと同じ
+    /// </summary>
+    struct Yaw
+    {
+        // 向きのx成分とz成分（長さ1）
+        float x;
+        float z;
+
+        constexpr Yaw() : x(1.0f), z(0.0f) {}
+        constexpr Yaw(float x, float z) : x(x), z(z) {}
+
+        /// <summary>
+        /// 向きベクトルから作る（y成分は無視し、XZ平面での長さが0ならx軸向き）
+        /// </summary>
+        static Yaw FromDirection(const VECTOR& dir)
+        {
+            const float lengthSq = dir.x * dir.x + dir.z * dir.z;
+            if (lengthSq <= 0.0f)
+            {
+                return Yaw();
+            }
+
+            const float invLength = 1.0f / sqrtf(lengthSq);
+            return Yaw(dir.x * invLength, dir.z * invLength);
+        }
+
+        /// <summary>
+        /// 角度から作る（x軸向きをMGetRotY(radian)で回した向き、回す量としても使う）
+        /// </summary>
+        static Yaw FromAngle(float radian) { return Yaw(cosf(radian), -sinf(radian)); }
+
+        /// <summary>
+        /// 向きベクトルへの変換
+        /// </summary>
+        constexpr VECTOR ToDirection() const { return VECTOR{ x, 0.0f, z }; }
+
+        /// <summary>
+        /// 反対の向き（180度回した向き）
+        /// </summary>
+        constexpr Yaw Reversed() const { return Yaw(-x, -z); }
+
+        /// <summary>
+        /// 回した向き（複素数の積）
+        /// </summary>
+        /// <param name="step">回す量（FromAngleで作ったもの）</param>
+        constexpr Yaw Rotated(const Yaw& step) const { return Yaw(x * step.x - z * step.z, x * step.z + z * step.x); }
+
+        /// <summary>
+        /// 相手の向きまでの角度の余弦
+        /// </summary>
+        constexpr float CosTo(const Yaw& other) const { return x * other.x + z * other.z; }
+
+        /// <summary>
+        /// 相手の向きまでの角度の正弦（正ならMGetRotYの正の向きに回すと近づく）
+        /// </summary>
+        constexpr float SinTo(const Yaw& other) const { return z * other.x - x * other.z; }
+    };
+
+    /// <summary>
+    /// 向きを目標の向きへ最大の角度まで近づける（近い側へ回し、行き過ぎる場合は目標にそろえる）
+    /// </summary>
+    /// <param name="now">現在の向き</param>
+    /// <param name="aim">目標の向き</param>
+    /// <param name="maxStep">1回に回す最大の量（Yaw::FromAngleで作ったもの、180度未満）</param>
+    /// <returns>目標の向きにそろった場合はtrueを返す</returns>
+    inline bool RotateToward(Yaw& now, const Yaw& aim, const Yaw& maxStep)
+    {
+        // 残りの角度が1回分以内なら目標にそろえる
+        if (maxStep.x <= now.CosTo(aim))
+        {
+            now = aim;
+            return true;
+        }
+
+        // 目標の側へ1回分回し、誤差で長さがずれていかないように1次の近似で長さを1に戻す
+        const Yaw rotated = now.Rotated(Yaw(maxStep.x, now.SinTo(aim) < 0.0f ? -maxStep.z : maxStep.z));
+        const float scale = 1.5f - 0.5f * (rotated.x * rotated.x + rotated.z * rotated.z);
+        now = Yaw(rotated.x * scale, rotated.z * scale);
+        return false;
+    }
+}// namespace My3dApp
\ No newline at end of file
@@ -3,7 +3,7 @@
 
 namespace My3dApp
 {
-    // AZbg}l[WCX^Xւ̃|C^`
+    // アセットマネージャインスタンスへのポインタ定義
     AssetManager* AssetManager::instance = nullptr;
 
     AssetManager::AssetManager()
@@ -35,32 +35,32 @@ namespace My3dApp
 
     void AssetManager::AddSoundEffect(string fileName, string key)
     {
-        // L[ƃTEhL^
+        // キーとサウンドを記録する
         instance->soundEffectMap.emplace(key, LoadSoundMem(fileName.c_str()));
     }
 
     void AssetManager::PlaySoundEffect(string key)
     {
-        // L[pTEȟ
+        // キーを用いたサウンドの検索
         auto sound = instance->soundEffectMap[key];
 
-        // ĐĂȂ
+        // 再生されていなければ
         if (!CheckSoundMem(sound))
         {
-            // Đ
+            // 再生する
             PlaySoundMem(sound, DX_PLAYTYPE_BACK);
         }
     }
 
     void AssetManager::StopSoundEffect(string key)
     {
-        // L[pTEȟ
+        // キーを用いたサウンドの検索
         auto sound = instance->soundEffectMap[key];
 
-        // ĐĂ 
+        // 再生されていれば 
         if (CheckSoundMem(sound))
         {
-            // ~
+            // 停止する
             StopSoundMem(sound);
         }
     }
@@ -68,7 +68,7 @@ namespace My3dApp
     void AssetManager::StopAllSE()
     {
        
-        //! ̂ɏC
+        //! のちに修正
         //StopSoundEffect("title");
     }
 
@@ -76,13 +76,13 @@ namespace My3dApp
     {
         int meshID = 0;
 
-        // ȑOɓo^ĂȂ𒲂ׂ
+        // 以前に登録されていないかを調べる
         auto itr = instance->meshMap.find(fileName);
 
-        // Ȃꍇ
+        // 見つからなかった場合
         if (itr == instance->meshMap.end())
         {
-            // Vǂݍ
+            // 新しく読み込み
             meshID = MV1LoadModel(fileName.c_str());
 
             if (meshID == -1)
@@ -90,15 +90,15 @@ namespace My3dApp
                 return meshID;
             }
 
-            // fileNamemeshIDL^
+            // fileNameとmeshIDを記録する
             instance->meshMap.emplace(fileName, meshID);
         }
 
-        // ̂meshIDɓ
+        // 複製したものをmeshIDに入れる
         meshID = MV1DuplicateModel(instance->meshMap[fileName]);
 
-        // bVgLꍇɁA{ƍ邽
-        // bṼRs[폜pduplicateMeshɕۑ
+        // メッシュを使うキャラが複数いた場合に、原本を消されると困るため
+        // メッシュのコピー削除用にduplicateMeshに保存
         instance->duplicateMesh.push_back(meshID);
 
         return meshID;
@@ -106,7 +106,7 @@ namespace My3dApp
 
     void AssetManager::ReleaseMesh(int meshID)
     {
-        // meshIDT
+        // meshIDを探して
         auto itr = find(instance->duplicateMesh.begin(), instance->duplicateMesh.end(), meshID);
 
         if (itr == instance->duplicateMesh.end())
@@ -114,10 +114,10 @@ namespace My3dApp
             return;
         }
 
-        // bV̉
+        // メッシュの解放
         MV1DeleteModel(meshID);
 
-        // ̃f[^ƓւĖ폜
+        // 末尾のデータと入れ替えて末尾を削除
         iter_swap(itr, instance->duplicateMesh.end() - 1);
         instance->duplicateMesh.pop_back();
     }
@@ -128,10 +128,10 @@ namespace My3dApp
 
         auto itr = instance->animationMap.find(fileName);
 
-        // Ȃꍇ
+        // 見つからなかった場合
         if (itr == instance->animationMap.end())
         {
-            // Vǂ݂
+            // 新しく読みこむ
             animID = MV1LoadModel(fileName.c_str());
 
             if (animID == -1)
@@ -139,7 +139,7 @@ namespace My3dApp
                 return animID;
             }
 
-            // fileNameanimIDL^
+            // fileNameとanimIDを記録する
             instance->animationMap.emplace(fileName, animID);
         }
 
@@ -148,28 +148,28 @@ namespace My3dApp
 
     void AssetManager::ReleaseAll()
     {
-        // ׂĂ̕폜
+        // すべての複製を削除
         for (auto itr = instance->duplicateMesh.begin(); itr != instance->duplicateMesh.end(); ++itr)
         {
             MV1DeleteModel(*itr);
         }
         instance->duplicateMesh.clear();
 
-        // ׂẴAj[V
+        // すべてのアニメーションを解放
         for (auto itr = instance->animationMap.begin(); itr != instance->animationMap.end(); ++itr)
         {
             MV1DeleteModel(itr->second);
         }
         instance->animationMap.clear();
 
-        // ׂẴf
+        // すべてのモデルを解放
         for (auto itr = instance->meshMap.begin(); itr != instance->meshMap.end(); ++itr)
         {
             MV1DeleteModel(itr->second);
         }
         instance->meshMap.clear();
 
-        // ׂẴTEh
+        // すべてのサウンドを解放
         for (auto itr = instance->soundEffectMap.begin(); itr != instance->soundEffectMap.end(); ++itr)
         {
             DeleteSoundMem(itr->second);
@@ -8,93 +8,93 @@ using namespace std;
 namespace My3dApp
 {
     /// <summary>
-    /// AZbg}l[W
+    /// アセットマネージャ
     /// </summary>
     class AssetManager final
     {
     private:
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
         AssetManager();
 
         /// <summary>
-        /// fXgN^
+        /// デストラクタ
         /// </summary>
         ~AssetManager();
 
-        // AZbg}l[W̗B̃CX^X
+        // アセットマネージャの唯一のインスタンス
         static AssetManager* instance;
 
-        // bṼ}bvi{j
+        // メッシュのマップ（原本）
         unordered_map<string, int>meshMap;
 
-        // bV
+        // 複製したメッシュ
         vector<int> duplicateMesh;
 
-        // Aj[Ṽ}bv
+        // アニメーションのマップ
         unordered_map<string, int>animationMap;
 
-        // SẼ}bv
+        // SEのマップ
         unordered_map<string, int>soundEffectMap;
 
     public:
         /// <summary>
-        /// CX^X̐
+        /// インスタンスの生成
         /// </summary>
         static void CreateInstance();
 
         /// <summary>
-        /// CX^X̍폜
+        /// インスタンスの削除
         /// </summary>
         static void DeleteInstance();
 
         /// <summary>
-        /// SE̒ǉ
+        /// SEの追加
         /// </summary>
         /// <param name="fileName"></param>
         /// <param name="key"></param>
         static void AddSoundEffect(string fileName, string key);
 
         /// <summary>
-        /// SE̍Đ
+        /// SEの再生
         /// </summary>
         /// <param name="key"></param>
         static void PlaySoundEffect(string key);
 
         /// <summary>
-        /// SE̒~
+        /// SEの停止
         /// </summary>
         /// <param name="key"></param>
         static void StopSoundEffect(string key);
 
         /// <summary>
-        /// ׂĂSE̒~
+        /// すべてのSEの停止
         /// </summary>
         static void StopAllSE();
 
         /// <summary>
-        /// bV̎擾
+        /// メッシュの取得
         /// </summary>
-        /// <param name="fileName">擾bṼt@C</param>
-        /// <returns>bṼnh</returns>
+        /// <param name="fileName">取得したいメッシュのファイル名</param>
+        /// <returns>メッシュのハンドル</returns>
         static int GetMesh(string fileName);
 
         /// <summary>
-        /// bV̉
+        /// メッシュの解放
         /// </summary>
         /// <param name="meshID"></param>
         static void ReleaseMesh(int meshID);
 
         /// <summary>
-        /// Aj[V̎擾
+        /// アニメーションの取得
         /// </summary>
         /// <param name="fileName"></param>
         /// <returns></returns>
         static int GetAnimation(string fileName);
 
         /// <summary>
-        /// ׂẴAZbg̉
+        /// すべてのアセットの解放
         /// </summary>
         static void ReleaseAll();
 
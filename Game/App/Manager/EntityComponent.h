@@ -0,0 +1,168 @@
+#pragma once
+
+#include <type_traits>
+#include "DxLib.h"
+#include "../Library/Collision.h"
+#include "../Library/VectorMath.h"
+
+namespace My3dApp
+{
+    /// <summary>
+    /// エンティティ（エンティティマネージャ内の添字と世代）
+    /// </summary>
+    struct Entity
+    {
+        // レコードの添字
+        unsigned int index;
+
+        // 世代（0は無効）
+        unsigned int generation;
+
+        /// <summary>
+        /// 有効なエンティティかどうか
+        /// </summary>
+        /// <returns>有効ならtrue 無効ならfalse</returns>
+        bool IsValid() const { return generation != 0; }
+    };
+
+    // 無効なエンティティ
+    constexpr Entity InvalidEntity = { 0, 0 };
+
+    // コンポーネントの種類（アーキタイプのビットフラグ）
+    enum ComponentBit : unsigned int
+    {
+        TransformBit = 1 << 0,  // 座標
+        VelocityBit  = 1 << 1,  // 速度
+        RotationBit  = 1 << 2,  // 向きと目標向き
+        ColliderBit  = 1 << 3,  // 当たり判定
+        ChaseBit     = 1 << 4,  // 目標への追跡
+        LodBit       = 1 << 5,  // 更新頻度の間引き
+
+        // 以下はデータを持たない目印（アーキタイプの区別にだけ使う）
+        DormantBit   = 1 << 6,  // 休眠中（システムの処理対象から外れる）
+    };
+
+    // データを持つコンポーネントの種類数
+    constexpr int ComponentNum = 6;
+
+    /// <summary>
+    /// 座標コンポーネント
+    /// </summary>
+    struct TransformComponent
+    {
+        // 座標
+        VECTOR pos;
+    };
+
+    /// <summary>
+    /// 速度コンポーネント
+    /// </summary>
+    struct VelocityComponent
+    {
+        // 1フレームあたりの移動量
+        VECTOR speed;
+    };
+
+    /// <summary>
+    /// 回転コンポーネント
+    /// </summary>
+    struct RotationComponent
+    {
+        // 向き
+        Yaw dir;
+
+        // 目標向き
+        Yaw aimDir;
+
+        // 回転中か
+        bool isRotate;
+    };
+
+    /// <summary>
+    /// 当たり判定コンポーネント
+    /// </summary>
+    struct ColliderComponent
+    {
+        // 球体当たり判定
+        Sphere sphere;
+
+        // 足元の線分当たり判定
+        LineSegment line;
+    };
+
+    /// <summary>
+    /// 追跡コンポーネント
+    /// </summary>
+    struct ChaseComponent
+    {
+        // 加速量
+        float accel;
+
+        // 索敵範囲（X、Z軸それぞれの距離）
+        float searchRange;
+    };
+
+    /// <summary>
+    /// 更新頻度の間引きコンポーネント（intervalフレームに1回だけシステムで更新し、表示位置は補間する）
+    /// </summary>
+    struct LodComponent
+    {
+        // 前回の更新時の表示位置
+        VECTOR prevPos;
+
+        // 補間した表示位置
+        VECTOR renderPos;
+
+        // 前回の更新からの経過時間
+        float elapsedTime;
+
+        // 今回の更新でまとめて進める時間
+        float tickTime;
+
+        // 更新間隔（1, 2, 4, 8フレーム）
+        int interval;
+
+        // 更新するフレームをずらす量
+        int phase;
+
+        // 前回の更新からの経過フレーム数
+        int elapsedFrames;
+
+        // 今回の更新でまとめて進めるフレーム数
+        int tickFrames;
+
+        // このフレームで更新するか
+        bool isTick;
+    };
+
+    /// <summary>
+    /// コンポーネントの型から添字とビットを引くための特性
+    /// </summary>
+    template<class T> struct ComponentTraits;
+
+    template<> struct ComponentTraits<TransformComponent> { static constexpr int index = 0; };
+    template<> struct ComponentTraits<VelocityComponent>  { static constexpr int index = 1; };
+    template<> struct ComponentTraits<RotationComponent>  { static constexpr int index = 2; };
+    template<> struct ComponentTraits<ColliderComponent>  { static constexpr int index = 3; };
+    template<> struct ComponentTraits<ChaseComponent>     { static constexpr int index = 4; };
+    template<> struct ComponentTraits<LodComponent>       { static constexpr int index = 5; };
+
+    // 添字順のコンポーネントサイズ
+    constexpr size_t ComponentSize[ComponentNum] =
+    {
+        sizeof(TransformComponent),
+        sizeof(VelocityComponent),
+        sizeof(RotationComponent),
+        sizeof(ColliderComponent),
+        sizeof(ChaseComponent),
+        sizeof(LodComponent),
+    };
+
+    // チャンクへはmemcpyで詰めるため、コンポーネントは単純コピー可能であること
+    static_assert(std::is_trivially_copyable<TransformComponent>::value, "component must be trivially copyable");
+    static_assert(std::is_trivially_copyable<VelocityComponent>::value, "component must be trivially copyable");
+    static_assert(std::is_trivially_copyable<RotationComponent>::value, "component must be trivially copyable");
+    static_assert(std::is_trivially_copyable<ColliderComponent>::value, "component must be trivially copyable");
+    static_assert(std::is_trivially_copyable<ChaseComponent>::value, "component must be trivially copyable");
+    static_assert(std::is_trivially_copyable<LodComponent>::value, "component must be trivially copyable");
+}// namespace My3dApp
\ No newline at end of file
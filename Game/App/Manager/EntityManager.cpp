@@ -0,0 +1,622 @@
+#include "EntityManager.h"
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include "../Library/Calc3D.h"
+#include "../Library/VectorMath.h"
+#include "../Library/MemoryArena.h"
+
+namespace My3dApp
+{
+    // エンティティマネージャインスタンスへのポインタ定義
+    EntityManager* EntityManager::instance = nullptr;
+
+    EntityManager::EntityManager()
+        : archetypes()
+        , records()
+        , freeIndices()
+        , chunkScratch()
+        , arena(nullptr)
+    {
+        instance = nullptr;
+
+        // 添字0は無効なエンティティとして予約
+        records.push_back({ 0, -1, -1, -1 });
+    }
+
+    EntityManager::~EntityManager()
+    {
+        for (auto& archetype : archetypes)
+        {
+            ReleaseChunks(archetype);
+        }
+    }
+
+    void EntityManager::CreateInstance()
+    {
+        if (!instance)
+        {
+            instance = new EntityManager();
+        }
+    }
+
+    void EntityManager::DeleteInstance()
+    {
+        if (instance)
+        {
+            delete instance;
+            instance = nullptr;
+        }
+    }
+
+    int EntityManager::FindOrCreateArchetype(unsigned int mask)
+    {
+        for (int i = 0; i < static_cast<int>(instance->archetypes.size()); ++i)
+        {
+            if (instance->archetypes[i].mask == mask)
+            {
+                return i;
+            }
+        }
+
+        Archetype archetype;
+        archetype.mask = mask;
+
+        // 持っているコンポーネントの配列を16バイト境界で並べる
+        size_t offset = 0;
+        for (int i = 0; i < ComponentNum; ++i)
+        {
+            archetype.offset[i] = offset;
+
+            if (mask & (1u << i))
+            {
+                offset += (ComponentSize[i] * chunkCapacity + 15) & ~static_cast<size_t>(15);
+            }
+        }
+
+        // 末尾に行ごとのエンティティ配列を置く
+        archetype.chunkSize = offset + sizeof(Entity) * chunkCapacity;
+
+        instance->archetypes.push_back(archetype);
+
+        return static_cast<int>(instance->archetypes.size()) - 1;
+    }
+
+    void EntityManager::ReleaseChunks(Archetype& archetype)
+    {
+        for (auto& chunk : archetype.chunks)
+        {
+            FreeChunk(instance->arena, chunk.data);
+        }
+        archetype.chunks.clear();
+
+        for (auto data : archetype.freeChunks)
+        {
+            FreeChunk(instance->arena, data);
+        }
+        archetype.freeChunks.clear();
+    }
+
+    unsigned char* EntityManager::AllocateChunk(MemoryArena* source, size_t size)
+    {
+        if (source)
+        {
+            return static_cast<unsigned char*>(source->Allocate(size, 16));
+        }
+        return new unsigned char[size];
+    }
+
+    void EntityManager::FreeChunk(MemoryArena* source, unsigned char* data)
+    {
+        if (!source)
+        {
+            delete[] data;
+        }
+    }
+
+    int EntityManager::PushRow(int archetypeIndex, int& chunkIndex)
+    {
+        Archetype& archetype = instance->archetypes[archetypeIndex];
+
+        // 末尾のチャンクが満杯なら新しいチャンクを追加
+        if (archetype.chunks.empty() || archetype.chunks.back().count == chunkCapacity)
+        {
+            Chunk chunk;
+            if (archetype.freeChunks.empty())
+            {
+                chunk.data = AllocateChunk(instance->arena, archetype.chunkSize);
+            }
+            else
+            {
+                chunk.data = archetype.freeChunks.back();
+                archetype.freeChunks.pop_back();
+            }
+            chunk.entities = reinterpret_cast<Entity*>(chunk.data + archetype.chunkSize - sizeof(Entity) * chunkCapacity);
+            chunk.count = 0;
+            archetype.chunks.push_back(chunk);
+        }
+
+        chunkIndex = static_cast<int>(archetype.chunks.size()) - 1;
+        Chunk& chunk = archetype.chunks[chunkIndex];
+        int row = chunk.count++;
+
+        // コンポーネントのゼロ初期化
+        for (int i = 0; i < ComponentNum; ++i)
+        {
+            if (archetype.mask & (1u << i))
+            {
+                memset(chunk.data + archetype.offset[i] + ComponentSize[i] * row, 0, ComponentSize[i]);
+            }
+        }
+
+        return row;
+    }
+
+    void EntityManager::EraseRow(int archetypeIndex, int chunkIndex, int row)
+    {
+        Archetype& archetype = instance->archetypes[archetypeIndex];
+        Chunk& chunk = archetype.chunks[chunkIndex];
+        Chunk& lastChunk = archetype.chunks.back();
+        int lastRow = lastChunk.count - 1;
+
+        // アーキタイプ末尾の行で穴を埋めて、チャンクを詰めたままにする
+        if (&chunk != &lastChunk || row != lastRow)
+        {
+            for (int i = 0; i < ComponentNum; ++i)
+            {
+                if (archetype.mask & (1u << i))
+                {
+                    memcpy(chunk.data + archetype.offset[i] + ComponentSize[i] * row,
+                        lastChunk.data + archetype.offset[i] + ComponentSize[i] * lastRow,
+                        ComponentSize[i]);
+                }
+            }
+
+            Entity moved = lastChunk.entities[lastRow];
+            chunk.entities[row] = moved;
+
+            EntityRecord& movedRecord = instance->records[moved.index];
+            movedRecord.chunk = chunkIndex;
+            movedRecord.row = row;
+        }
+
+        // 末尾のチャンクが空になったら空きに戻す
+        if (--lastChunk.count == 0)
+        {
+            archetype.freeChunks.push_back(lastChunk.data);
+            archetype.chunks.pop_back();
+        }
+    }
+
+    Entity EntityManager::Create(unsigned int mask)
+    {
+        int archetypeIndex = FindOrCreateArchetype(mask);
+
+        int chunkIndex;
+        int row = PushRow(archetypeIndex, chunkIndex);
+
+        // レコードの確保
+        unsigned int index;
+        if (!instance->freeIndices.empty())
+        {
+            index = instance->freeIndices.back();
+            instance->freeIndices.pop_back();
+        }
+        else
+        {
+            index = static_cast<unsigned int>(instance->records.size());
+            instance->records.push_back({ 1, -1, -1, -1 });
+        }
+
+        EntityRecord& record = instance->records[index];
+        record.archetype = archetypeIndex;
+        record.chunk = chunkIndex;
+        record.row = row;
+
+        Entity entity = { index, record.generation };
+        instance->archetypes[archetypeIndex].chunks[chunkIndex].entities[row] = entity;
+
+        return entity;
+    }
+
+    void EntityManager::Destroy(Entity entity)
+    {
+        if (!IsAlive(entity))
+        {
+            return;
+        }
+
+        EntityRecord& record = instance->records[entity.index];
+        EraseRow(record.archetype, record.chunk, record.row);
+
+        // 世代を進めて古いエンティティを無効にする（0は無効値なので飛ばす）
+        if (++record.generation == 0)
+        {
+            record.generation = 1;
+        }
+        record.archetype = -1;
+        record.chunk = -1;
+        record.row = -1;
+
+        instance->freeIndices.push_back(entity.index);
+    }
+
+    void EntityManager::ChangeArchetype(Entity entity, unsigned int mask)
+    {
+        if (!IsAlive(entity))
+        {
+            return;
+        }
+
+        EntityRecord& record = instance->records[entity.index];
+        if (instance->archetypes[record.archetype].mask == mask)
+        {
+            return;
+        }
+
+        // 作成でアーキタイプ配列が伸びることがあるので先に添字を確定させる
+        int newArchetypeIndex = FindOrCreateArchetype(mask);
+
+        int newChunkIndex;
+        int newRow = PushRow(newArchetypeIndex, newChunkIndex);
+
+        const Archetype& oldArchetype = instance->archetypes[record.archetype];
+        const Archetype& newArchetype = instance->archetypes[newArchetypeIndex];
+        const Chunk& oldChunk = oldArchetype.chunks[record.chunk];
+        Chunk& newChunk = instance->archetypes[newArchetypeIndex].chunks[newChunkIndex];
+
+        // 両方が持つコンポーネントを引き継ぐ
+        for (int i = 0; i < ComponentNum; ++i)
+        {
+            if (oldArchetype.mask & newArchetype.mask & (1u << i))
+            {
+                memcpy(newChunk.data + newArchetype.offset[i] + ComponentSize[i] * newRow,
+                    oldChunk.data + oldArchetype.offset[i] + ComponentSize[i] * record.row,
+                    ComponentSize[i]);
+            }
+        }
+        newChunk.entities[newRow] = entity;
+
+        EraseRow(record.archetype, record.chunk, record.row);
+
+        record.archetype = newArchetypeIndex;
+        record.chunk = newChunkIndex;
+        record.row = newRow;
+    }
+
+    void EntityManager::AddComponent(Entity entity, unsigned int mask)
+    {
+        if (IsAlive(entity))
+        {
+            ChangeArchetype(entity, instance->archetypes[instance->records[entity.index].archetype].mask | mask);
+        }
+    }
+
+    void EntityManager::RemoveComponent(Entity entity, unsigned int mask)
+    {
+        if (IsAlive(entity))
+        {
+            ChangeArchetype(entity, instance->archetypes[instance->records[entity.index].archetype].mask & ~mask);
+        }
+    }
+
+    bool EntityManager::IsAlive(Entity entity)
+    {
+        if (!entity.IsValid() || instance->records.size() <= entity.index)
+        {
+            return false;
+        }
+
+        const EntityRecord& record = instance->records[entity.index];
+        return record.generation == entity.generation && record.archetype != -1;
+    }
+
+    bool EntityManager::HasComponent(Entity entity, unsigned int mask)
+    {
+        const EntityRecord& record = instance->records[entity.index];
+        return (instance->archetypes[record.archetype].mask & mask) == mask;
+    }
+
+    void EntityManager::Update(float deltaTime, const VECTOR* chaseTarget, unsigned int frame)
+    {
+        LodBeginSystem(deltaTime, frame);
+
+        if (chaseTarget)
+        {
+            ChaseSystem(deltaTime, *chaseTarget);
+        }
+
+        RotateSystem();
+
+        MoveSystem();
+
+        LodEndSystem();
+
+        ColliderSystem();
+    }
+
+    bool EntityManager::IsLodTick(Entity entity, float deltaTime, unsigned int frame, float& tickTime)
+    {
+        tickTime = deltaTime;
+
+        if (!IsAlive(entity) || !HasComponent(entity, LodBit))
+        {
+            return true;
+        }
+
+        // LodBeginSystemと同じ判定（経過時間はまだこのフレームの分を足していない）
+        const LodComponent& lod = Get<LodComponent>(entity);
+        if (((frame + lod.phase) & (lod.interval - 1)) != 0)
+        {
+            return false;
+        }
+
+        tickTime = lod.elapsedTime + deltaTime;
+        return true;
+    }
+
+    void EntityManager::ReleaseAllEntity()
+    {
+        // 行を詰め直さず、チャンクごと空きに戻す
+        for (auto& archetype : instance->archetypes)
+        {
+            for (auto& chunk : archetype.chunks)
+            {
+                archetype.freeChunks.push_back(chunk.data);
+            }
+            archetype.chunks.clear();
+        }
+
+        // 生きていたエンティティの世代を進めて、すべて空きにする
+        instance->freeIndices.clear();
+        for (unsigned int i = 1; i < instance->records.size(); ++i)
+        {
+            EntityRecord& record = instance->records[i];
+            if (record.archetype != -1 && ++record.generation == 0)
+            {
+                record.generation = 1;
+            }
+            record.archetype = -1;
+            record.chunk = -1;
+            record.row = -1;
+
+            instance->freeIndices.push_back(i);
+        }
+    }
+
+    void EntityManager::SetArena(MemoryArena* set)
+    {
+        MemoryArena* old = instance->arena;
+        if (old == set)
+        {
+            return;
+        }
+
+        for (auto& archetype : instance->archetypes)
+        {
+            // 使用中のチャンクは中身ごと新しい確保元に写す（レコードはチャンクの添字で持つので変わらない）
+            for (auto& chunk : archetype.chunks)
+            {
+                unsigned char* data = AllocateChunk(set, archetype.chunkSize);
+                memcpy(data, chunk.data, archetype.chunkSize);
+                FreeChunk(old, chunk.data);
+
+                chunk.data = data;
+                chunk.entities = reinterpret_cast<Entity*>(data + archetype.chunkSize - sizeof(Entity) * chunkCapacity);
+            }
+
+            for (auto data : archetype.freeChunks)
+            {
+                FreeChunk(old, data);
+            }
+            archetype.freeChunks.clear();
+        }
+
+        instance->arena = set;
+    }
+
+    void EntityManager::LodBeginSystem(float deltaTime, unsigned int frame)
+    {
+        ForEachChunk(LodBit, [=](const Archetype& archetype, const Chunk& chunk)
+        {
+            LodComponent* lod = GetArray<LodComponent>(archetype, chunk);
+
+            for (int i = 0; i < chunk.count; ++i)
+            {
+                ++lod[i].elapsedFrames;
+                lod[i].elapsedTime += deltaTime;
+
+                // フレーム番号をずらして、同じ間隔のエンティティの更新が同じフレームに集中しないようにする
+                lod[i].isTick = ((frame + lod[i].phase) & (lod[i].interval - 1)) == 0;
+
+                if (!lod[i].isTick)
+                {
+                    continue;
+                }
+
+                // 前回の更新からの分をまとめて進める
+                lod[i].tickFrames = lod[i].elapsedFrames;
+                lod[i].tickTime = lod[i].elapsedTime;
+                lod[i].elapsedFrames = 0;
+                lod[i].elapsedTime = 0.0f;
+
+                // 補間は今の表示位置から始めて、間隔が変わっても表示位置が飛ばないようにする
+                lod[i].prevPos = lod[i].renderPos;
+            }
+        });
+    }
+
+    void EntityManager::LodEndSystem()
+    {
+        ForEachChunk(TransformBit | LodBit, [](const Archetype& archetype, const Chunk& chunk)
+        {
+            const TransformComponent* transform = GetArray<TransformComponent>(archetype, chunk);
+            LodComponent* lod = GetArray<LodComponent>(archetype, chunk);
+
+            for (int i = 0; i < chunk.count; ++i)
+            {
+                // 次の更新までのフレームで前回の位置から今回の位置まで進める
+                float t = static_cast<float>(lod[i].elapsedFrames + 1) / static_cast<float>(lod[i].interval);
+                if (1.0f < t)
+                {
+                    t = 1.0f;
+                }
+
+                lod[i].renderPos = lod[i].prevPos + (transform[i].pos - lod[i].prevPos) * t;
+            }
+        });
+    }
+
+    void EntityManager::ChaseSystem(float deltaTime, const VECTOR& target)
+    {
+        ForEachChunk(TransformBit | VelocityBit | RotationBit | ChaseBit, [&](const Archetype& archetype, const Chunk& chunk)
+        {
+            const TransformComponent* transform = GetArray<TransformComponent>(archetype, chunk);
+            VelocityComponent* velocity = GetArray<VelocityComponent>(archetype, chunk);
+            RotationComponent* rotation = GetArray<RotationComponent>(archetype, chunk);
+            const ChaseComponent* chase = GetArray<ChaseComponent>(archetype, chunk);
+            const LodComponent* lod = FindArray<LodComponent>(archetype, chunk);
+
+            for (int i = 0; i < chunk.count; ++i)
+            {
+                // 間引き中は飛ばし、更新するフレームでは1フレームあたりの時間に直して使う
+                float frameTime = deltaTime;
+                int frames = 1;
+                if (lod)
+                {
+                    if (!lod[i].isTick)
+                    {
+                        continue;
+                    }
+                    frames = lod[i].tickFrames;
+                    frameTime = lod[i].tickTime / frames;
+                }
+
+                // 目標の座標から自身の座標を引いて向きベクトルを計算する
+                VECTOR tmp = target - transform[i].pos;
+
+                // 高さベクトルの無効化
+                tmp.y = 0;
+
+                // 索敵範囲外なら減速
+                if (chase[i].searchRange <= fabsf(tmp.x) && chase[i].searchRange <= fabsf(tmp.z))
+                {
+                    velocity[i].speed *= powf(0.9f, static_cast<float>(frames));
+                    continue;
+                }
+
+                // 目標と重なっていて向きが決まらないときは止まる
+                if (VSquareSize(tmp) < 0.5f)
+                {
+                    velocity[i].speed = VGet(0, 0, 0);
+                    continue;
+                }
+
+                // 方向を正規化
+                VECTOR inputVec = VNorm(tmp);
+
+                // 目標方向は現在向いている方向と異なるか
+                if (IsNearAngle(inputVec, rotation[i].dir.ToDirection()))
+                {
+                    rotation[i].dir = Yaw::FromDirection(inputVec);
+                }
+                else
+                {
+                    rotation[i].isRotate = true;
+                    rotation[i].aimDir = Yaw::FromDirection(inputVec);
+                }
+
+                velocity[i].speed = inputVec + (inputVec * frameTime * chase[i].accel);
+            }
+        });
+    }
+
+    void EntityManager::RotateSystem()
+    {
+        // 1フレームあたりに回す量（10度）は三角関数を1回だけ使って作り、各エンティティは数回の積和だけで回す
+        const float frameRadian = 10.0f * DX_PI_F / 180.0f;
+        const Yaw frameStep = Yaw::FromAngle(frameRadian);
+
+        ForEachChunk(RotationBit, [&](const Archetype& archetype, const Chunk& chunk)
+        {
+            RotationComponent* rotation = GetArray<RotationComponent>(archetype, chunk);
+            const LodComponent* lod = FindArray<LodComponent>(archetype, chunk);
+
+            // 間引かないアーキタイプは同じ量だけまとめて回す
+            if (!lod)
+            {
+                for (int i = 0; i < chunk.count; ++i)
+                {
+                    if (rotation[i].isRotate)
+                    {
+                        rotation[i].isRotate = !RotateToward(rotation[i].dir, rotation[i].aimDir, frameStep);
+                    }
+                }
+                return;
+            }
+
+            // 間引き中のフレームの分もまとめて回す（半周を超える量は目標にそろえるのと同じ）
+            int prevFrames = 1;
+            Yaw step = frameStep;
+
+            for (int i = 0; i < chunk.count; ++i)
+            {
+                if (!rotation[i].isRotate || !lod[i].isTick)
+                {
+                    continue;
+                }
+
+                if (lod[i].tickFrames != prevFrames)
+                {
+                    prevFrames = lod[i].tickFrames;
+                    step = Yaw::FromAngle(min(frameRadian * prevFrames, DX_PI_F));
+                }
+
+                rotation[i].isRotate = !RotateToward(rotation[i].dir, rotation[i].aimDir, step);
+            }
+        });
+    }
+
+    void EntityManager::MoveSystem()
+    {
+        ForEachChunk(TransformBit | VelocityBit, [](const Archetype& archetype, const Chunk& chunk)
+        {
+            TransformComponent* transform = GetArray<TransformComponent>(archetype, chunk);
+            const VelocityComponent* velocity = GetArray<VelocityComponent>(archetype, chunk);
+            const LodComponent* lod = FindArray<LodComponent>(archetype, chunk);
+
+            // 間引かないアーキタイプは毎フレーム進める（座標と速度はVECTORだけの並びなので、まとめて加算する）
+            if (!lod)
+            {
+                static_assert(sizeof(TransformComponent) == sizeof(VECTOR) && sizeof(VelocityComponent) == sizeof(VECTOR),
+                    "TransformComponent and VelocityComponent must be tightly packed VECTOR arrays");
+                AddVectors(&transform->pos, &velocity->speed, chunk.count);
+                return;
+            }
+
+            // 間引き中のフレームの分もまとめて進める
+            for (int i = 0; i < chunk.count; ++i)
+            {
+                if (lod[i].isTick)
+                {
+                    transform[i].pos += velocity[i].speed * static_cast<float>(lod[i].tickFrames);
+                }
+            }
+        });
+    }
+
+    void EntityManager::ColliderSystem()
+    {
+        ForEachChunk(TransformBit | ColliderBit, [](const Archetype& archetype, const Chunk& chunk)
+        {
+            const TransformComponent* transform = GetArray<TransformComponent>(archetype, chunk);
+            ColliderComponent* collider = GetArray<ColliderComponent>(archetype, chunk);
+
+            for (int i = 0; i < chunk.count; ++i)
+            {
+                collider[i].sphere.Move(transform[i].pos);
+                collider[i].line.Move(transform[i].pos);
+            }
+        });
+    }
+}// namespace My3dApp
\ No newline at end of file
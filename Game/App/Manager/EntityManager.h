@@ -0,0 +1,348 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include "EntityComponent.h"
+#include "../Library/JobSystem.h"
+
+using namespace std;
+
+namespace My3dApp
+{
+    /// <summary>
+    /// エンティティマネージャ（アーキタイプ単位でコンポーネントを構造体配列として保持する）
+    /// </summary>
+    class EntityManager final
+    {
+    private:
+        /// <summary>
+        /// コンストラクタ（シングルトン）
+        /// </summary>
+        EntityManager();
+
+        /// <summary>
+        /// デストラクタ
+        /// </summary>
+        ~EntityManager();
+
+        // チャンク1つに格納するエンティティ数
+        static constexpr int chunkCapacity = 256;
+
+        /// <summary>
+        /// チャンク（コンポーネントごとの配列を1つの領域にまとめたもの）
+        /// </summary>
+        struct Chunk
+        {
+            // コンポーネント配列の領域
+            unsigned char* data;
+
+            // 行ごとのエンティティ
+            Entity* entities;
+
+            // 格納しているエンティティ数
+            int count;
+        };
+
+        /// <summary>
+        /// アーキタイプ（同じコンポーネントの組み合わせを持つエンティティの集まり）
+        /// </summary>
+        struct Archetype
+        {
+            // 持っているコンポーネントのビット
+            unsigned int mask;
+
+            // チャンク内の各コンポーネント配列の開始位置
+            size_t offset[ComponentNum];
+
+            // チャンク1つ分の領域サイズ
+            size_t chunkSize;
+
+            // チャンク（末尾以外は常に満杯）
+            vector<Chunk> chunks;
+
+            // 空になったチャンクの領域（アリーナからは個別に解放できないので、次に追加するときに使い回す）
+            vector<unsigned char*> freeChunks;
+        };
+
+        /// <summary>
+        /// エンティティの格納位置
+        /// </summary>
+        struct EntityRecord
+        {
+            // 現在の世代
+            unsigned int generation;
+
+            // アーキタイプの添字
+            int archetype;
+
+            // チャンクの添字
+            int chunk;
+
+            // チャンク内の行
+            int row;
+        };
+
+        // エンティティマネージャの唯一のインスタンス
+        static EntityManager* instance;
+
+        // アーキタイプ
+        vector<Archetype> archetypes;
+
+        // エンティティの格納位置
+        vector<EntityRecord> records;
+
+        // 空いているレコードの添字
+        vector<unsigned int> freeIndices;
+
+        // システム実行時に対象チャンクを集める作業領域
+        vector<pair<const Archetype*, const Chunk*>> chunkScratch;
+
+        // チャンクの領域の確保元（nullptrならヒープから確保する）
+        class MemoryArena* arena;
+
+        /// <summary>
+        /// アーキタイプの検索、無ければ作成
+        /// </summary>
+        /// <param name="mask">コンポーネントのビット</param>
+        /// <returns>アーキタイプの添字</returns>
+        static int FindOrCreateArchetype(unsigned int mask);
+
+        /// <summary>
+        /// アーキタイプの末尾に行を1つ追加する（コンポーネントはゼロ初期化される）
+        /// </summary>
+        /// <param name="archetypeIndex">追加先のアーキタイプの添字</param>
+        /// <param name="chunkIndex">追加したチャンクの添字</param>
+        /// <returns>追加した行</returns>
+        static int PushRow(int archetypeIndex, int& chunkIndex);
+
+        /// <summary>
+        /// 行の削除（アーキタイプ末尾の行で穴を埋め、移動したエンティティの格納位置を更新する）
+        /// </summary>
+        /// <param name="archetypeIndex">アーキタイプの添字</param>
+        /// <param name="chunkIndex">チャンクの添字</param>
+        /// <param name="row">削除する行</param>
+        static void EraseRow(int archetypeIndex, int chunkIndex, int row);
+
+        /// <summary>
+        /// エンティティを別のアーキタイプに移す（共通のコンポーネントは引き継ぐ）
+        /// </summary>
+        /// <param name="entity">移すエンティティ</param>
+        /// <param name="mask">移動先のコンポーネントのビット</param>
+        static void ChangeArchetype(Entity entity, unsigned int mask);
+
+        /// <summary>
+        /// アーキタイプのチャンクすべての解放
+        /// </summary>
+        /// <param name="archetype">解放するアーキタイプ</param>
+        static void ReleaseChunks(Archetype& archetype);
+
+        /// <summary>
+        /// チャンクの領域の確保
+        /// </summary>
+        /// <param name="source">確保元のアリーナ（nullptrならヒープ）</param>
+        /// <param name="size">領域のサイズ</param>
+        /// <returns>確保した領域の先頭</returns>
+        static unsigned char* AllocateChunk(class MemoryArena* source, size_t size);
+
+        /// <summary>
+        /// チャンクの領域の解放（アリーナから確保したものはアリーナでまとめて解放するため何もしない）
+        /// </summary>
+        /// <param name="source">確保元のアリーナ（nullptrならヒープ）</param>
+        /// <param name="data">解放する領域の先頭</param>
+        static void FreeChunk(class MemoryArena* source, unsigned char* data);
+
+        /// <summary>
+        /// チャンク内のコンポーネント配列の取得
+        /// </summary>
+        /// <param name="archetype">チャンクが属するアーキタイプ</param>
+        /// <param name="chunk">チャンク</param>
+        /// <returns>コンポーネント配列の先頭</returns>
+        template<class T>
+        static T* GetArray(const Archetype& archetype, const Chunk& chunk)
+        {
+            return reinterpret_cast<T*>(chunk.data + archetype.offset[ComponentTraits<T>::index]);
+        }
+
+        /// <summary>
+        /// チャンク内のコンポーネント配列の取得（アーキタイプが持っていなければnullptr）
+        /// </summary>
+        /// <param name="archetype">チャンクが属するアーキタイプ</param>
+        /// <param name="chunk">チャンク</param>
+        /// <returns>コンポーネント配列の先頭、無ければnullptr</returns>
+        template<class T>
+        static T* FindArray(const Archetype& archetype, const Chunk& chunk)
+        {
+            if (!(archetype.mask & (1u << ComponentTraits<T>::index)))
+            {
+                return nullptr;
+            }
+            return GetArray<T>(archetype, chunk);
+        }
+
+        /// <summary>
+        /// 必要なコンポーネントをすべて持つチャンクに対する処理（チャンク単位で並列に行う）
+        /// </summary>
+        /// <param name="required">必要なコンポーネントのビット</param>
+        /// <param name="func">チャンクごとに呼ぶ処理</param>
+        /// <param name="excluded">持っていたら対象外にするビット（既定では休眠中を除く）</param>
+        template<class Func>
+        static void ForEachChunk(unsigned int required, Func func, unsigned int excluded = DormantBit)
+        {
+            vector<pair<const Archetype*, const Chunk*>>& targets = instance->chunkScratch;
+            targets.clear();
+
+            for (const auto& archetype : instance->archetypes)
+            {
+                if ((archetype.mask & required) != required || (archetype.mask & excluded))
+                {
+                    continue;
+                }
+
+                for (const auto& chunk : archetype.chunks)
+                {
+                    targets.emplace_back(&archetype, &chunk);
+                }
+            }
+
+            // チャンク同士は別の領域なのでそのまま分けて処理できる
+            JobSystem::ParallelFor(static_cast<int>(targets.size()), 1, [&](int begin, int end, int threadIndex)
+            {
+                for (int i = begin; i < end; ++i)
+                {
+                    func(*targets[i].first, *targets[i].second);
+                }
+            });
+        }
+
+        /// <summary>
+        /// 間引き更新するエンティティの、このフレームで更新するかどうかの判定
+        /// 間引き中のエンティティは以降のシステムで飛ばされ、更新時にまとめて進む
+        /// </summary>
+        /// <param name="deltaTime">1フレームの経過時間</param>
+        /// <param name="frame">フレーム番号</param>
+        static void LodBeginSystem(float deltaTime, unsigned int frame);
+
+        /// <summary>
+        /// 間引き更新するエンティティの表示位置を、前回と今回の更新位置の間で補間する
+        /// </summary>
+        static void LodEndSystem();
+
+        /// <summary>
+        /// 目標に向かって追跡する（エネミーの移動）
+        /// </summary>
+        /// <param name="deltaTime">1フレームの経過時間</param>
+        /// <param name="target">追跡目標の座標</param>
+        static void ChaseSystem(float deltaTime, const VECTOR& target);
+
+        /// <summary>
+        /// 目標向きへの回転
+        /// </summary>
+        static void RotateSystem();
+
+        /// <summary>
+        /// 速度による移動
+        /// </summary>
+        static void MoveSystem();
+
+        /// <summary>
+        /// 当たり判定位置の更新
+        /// </summary>
+        static void ColliderSystem();
+
+    public:
+        /// <summary>
+        /// インスタンスの生成
+        /// </summary>
+        static void CreateInstance();
+
+        /// <summary>
+        /// インスタンスの削除
+        /// </summary>
+        static void DeleteInstance();
+
+        /// <summary>
+        /// エンティティの生成（コンポーネントはゼロ初期化される）
+        /// </summary>
+        /// <param name="mask">持たせるコンポーネントのビット</param>
+        /// <returns>生成したエンティティ</returns>
+        static Entity Create(unsigned int mask);
+
+        /// <summary>
+        /// エンティティの削除
+        /// </summary>
+        /// <param name="entity">削除するエンティティ</param>
+        static void Destroy(Entity entity);
+
+        /// <summary>
+        /// エンティティが生きているかどうか
+        /// </summary>
+        /// <param name="entity">調べるエンティティ</param>
+        /// <returns>生きていればtrue そうでなければfalse</returns>
+        static bool IsAlive(Entity entity);
+
+        /// <summary>
+        /// エンティティがコンポーネントを持っているかどうか
+        /// </summary>
+        /// <param name="entity">調べるエンティティ</param>
+        /// <param name="mask">調べるコンポーネントのビット</param>
+        /// <returns>すべて持っていればtrue そうでなければfalse</returns>
+        static bool HasComponent(Entity entity, unsigned int mask);
+
+        /// <summary>
+        /// コンポーネントの追加（アーキタイプを移す、目印のビットにも使える）
+        /// </summary>
+        /// <param name="entity">エンティティ</param>
+        /// <param name="mask">追加するビット</param>
+        static void AddComponent(Entity entity, unsigned int mask);
+
+        /// <summary>
+        /// コンポーネントの削除（アーキタイプを移す、目印のビットにも使える）
+        /// </summary>
+        /// <param name="entity">エンティティ</param>
+        /// <param name="mask">削除するビット</param>
+        static void RemoveComponent(Entity entity, unsigned int mask);
+
+        /// <summary>
+        /// エンティティのコンポーネントの取得
+        /// </summary>
+        /// <param name="entity">エンティティ</param>
+        /// <returns>コンポーネントへの参照</returns>
+        template<class T>
+        static T& Get(Entity entity)
+        {
+            const EntityRecord& record = instance->records[entity.index];
+            const Archetype& archetype = instance->archetypes[record.archetype];
+            return GetArray<T>(archetype, archetype.chunks[record.chunk])[record.row];
+        }
+
+        /// <summary>
+        /// すべてのシステムの更新
+        /// </summary>
+        /// <param name="deltaTime">1フレームの経過時間</param>
+        /// <param name="chaseTarget">追跡目標の座標（無ければnullptr）</param>
+        /// <param name="frame">フレーム番号（間引き更新の判定に使う）</param>
+        static void Update(float deltaTime, const VECTOR* chaseTarget, unsigned int frame);
+
+        /// <summary>
+        /// 間引き更新するエンティティが、このフレームで更新されるかどうか（システムの更新前に呼ぶ）
+        /// </summary>
+        /// <param name="entity">エンティティ</param>
+        /// <param name="deltaTime">1フレームの経過時間</param>
+        /// <param name="frame">フレーム番号</param>
+        /// <param name="tickTime">更新されるときにまとめて進める時間</param>
+        /// <returns>更新されるならtrue 間引かれるならfalse</returns>
+        static bool IsLodTick(Entity entity, float deltaTime, unsigned int frame, float& tickTime);
+
+        /// <summary>
+        /// 全エンティティの削除（チャンクは1つずつ解放せず、まとめて空きに戻す）
+        /// </summary>
+        static void ReleaseAllEntity();
+
+        /// <summary>
+        /// チャンクの確保元の変更（使用中のチャンクは新しい確保元に写し、空きのチャンクは手放す）
+        /// 前のアリーナが残っているうちに呼ぶ
+        /// </summary>
+        /// <param name="set">確保元のアリーナ（nullptrならヒープ）</param>
+        static void SetArena(class MemoryArena* set);
+    };
+}// namespace My3dApp
\ No newline at end of file
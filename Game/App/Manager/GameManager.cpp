@@ -9,7 +9,7 @@
 
 namespace My3dApp
 {
-    // Q[}l[WCX^Xւ̃|C^`
+    // ゲームマネージャインスタンスへのポインタ定義
     GameManager* GameManager::instance = nullptr;
 
     SceneBase* GameManager::nowScene = nullptr;
@@ -24,7 +24,7 @@ namespace My3dApp
 
     GameManager::~GameManager()
     {
-        // Ȃ
+        // 処理なし
     }
 
     void GameManager::CreateInstance()
@@ -46,17 +46,17 @@ namespace My3dApp
 
     bool GameManager::ProcessInput()
     {
-        // G[łA̓EBhEꂽ
+        // エラーがでた、もしくはウィンドウが閉じられたら
         if (ProcessMessage() != 0)
         {
-            // [ṽtO|
+            // ループのフラグを倒す
             return false;
         }
 
-        // ESCL[ꂽ
+        // ESCキーが押されたら
         if (CheckHitKey(KEY_INPUT_ESCAPE))
         {
-            // [ṽtO|
+            // ループのフラグを倒す
             return false;
         }
 
@@ -65,35 +65,35 @@ namespace My3dApp
 
     void GameManager::Init()
     {
-        // ʂ̉1920ɐݒ
+        // 画面の横幅を1920に設定
         screenWidth = 1920;
 
-        // ʂ̏c1080ɐݒ
+        // 画面の縦幅を1080に設定
         screenHeight = 1080;
 
-        // Sʂɂ
+        // 全画面にする
         fullScreen = true;
 
-        // Sʂ̃tOĂȂ
+        // 全画面のフラグが立っていなければ
         if (!fullScreen)
         {
-            // EBhE[hɂ
+            // ウィンドウモードにする
             ChangeWindowMode(TRUE);
         }
 
-        // ʃ[h̐ݒ
+        // 画面モードの設定
         SetGraphMode(screenWidth, screenHeight, 32);
 
-        // DxLib̏
+        // DxLibの初期化処理
         DxLib_Init();
 
-        // }EXJ[\\Ȃ
+        // マウスカーソルを表示しない
         SetMouseDispFlag(false);
 
-        // Zobt@Lɂ
+        // Zバッファを有効にする
         SetUseZBuffer3D(true);
 
-        // Zobt@ւ݂̏Lɂ
+        // Zバッファへの書き込みを有効にする
         SetWriteZBuffer3D(true);
 
         // 
@@ -105,76 +105,76 @@ namespace My3dApp
 
     void GameManager::Loop()
     {
-        // [vtO
+        // ループフラグ
         bool gameLoop = true;
 
-        // t[̃JEg
+        // 現フレームのカウント
         LONGLONG nowCount = GetNowHiPerformanceCount();
 
-        // Ot[̃JEg
+        // 前フレームのカウント
         LONGLONG prevCount = nowCount;
 
-        // ҋ@t[ԁi60fpszj
+        // 待機フレーム時間（60fps想定）
         // 1/60 = 1.66666...
-        // 16000}CNb = 16~b = 0.016b
+        // 16000マイクロ秒 = 16ミリ秒 = 0.016秒
         float waitFrameTime = 15900;
 
         SetBackgroundColor(128, 128, 128);
 
-        // [v{
+        // ループ本体
         while (gameLoop)
         {
-            // t[ƑOt[Ƃ̍
+            // 現フレームと前フレームとの差分
             float deltaTime;
 
-            // t[JEg̍XV
+            // 現フレームカウントの更新
             nowCount = GetNowHiPerformanceCount();
 
-            // 1001ɂĕۑi}CNbZj
+            // 差分を100万分の1にして保存する（マイクロ秒換算）
             deltaTime = (nowCount - prevCount) / 1000000.0f;
 
-            // Q[pbh̍XV
+            // ゲームパッドの更新
             GamePad::Update();
 
-            // [vp̊mF
+            // ループ継続の確認
             gameLoop = ProcessInput();
 
-            // V[
+            // 仮シーン
             SceneBase* tmpScene;
 
-            // V[̍XVƌ݂̃V[̕ۑ
+            // シーンの更新と現在のシーンの保存
             tmpScene = nowScene->Update(deltaTime);
 
-            // ʂ̏
+            // 画面の初期化
             ClearDrawScreen();
 
-            // V[̕`
+            // シーンの描画
             nowScene->Draw();
 
-            // fpsmFpiŏj
+            // fps確認用（後で消す）
             DrawFormatString(100, 100, GetColor(255, 255, 255), "fps:%f", deltaTime);
 
-            // ʂ̓e\ʂɔf
+            // 裏画面の内容を表画面に反映させる
             ScreenFlip();
 
-            // XVÕV[ƍXṼV[قȂ
+            // 更新前のシーンと更新後のシーンが異なったら
             if (nowScene != tmpScene)
             {
-                // V[
+                // シーンを解放
                 delete nowScene;
 
-                // VV[
+                // 新しいシーンを入れる
                 nowScene = tmpScene;
             }
 
-            // 60fpsp[v
+            // 60fps制御用ループ
             while (GetNowHiPerformanceCount() - nowCount < waitFrameTime);
 
-            // ݂̃JEgۑ
+            // 現在のカウントを保存する
             prevCount = nowCount;
         }
 
-        // DxLib̎gpI
+        // DxLibの使用終了処理
         DxLib_End();
     }
 }// namespace My3dApp
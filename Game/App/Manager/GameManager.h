@@ -3,66 +3,66 @@
 namespace My3dApp
 {
     /// <summary>
-    /// Q[}l[W
+    /// ゲームマネージャ
     /// </summary>
     class GameManager final
     {
     private:
         /// <summary>
-        /// RXgN^iVOgj
+        /// コンストラクタ（シングルトン）
         /// </summary>
         GameManager();
 
         /// <summary>
-        /// fXgN^
+        /// デストラクタ
         /// </summary>
         ~GameManager();
 
         /// <summary>
-        /// 
+        /// 初期化処理
         /// </summary>
         void Init();
 
         /// <summary>
-        /// [v𔲂ۂɎg͏֐
+        /// ループを抜ける際に使う入力処理関数
         /// </summary>
-        /// <returns>[vpȂtrue łȂfalse</returns>
+        /// <returns>ループ継続ならtrue そうでなければfalse</returns>
         static bool ProcessInput();
 
-        // Q[}l[W̗B̃CX^X
+        // ゲームマネージャの唯一のインスタンス
         static GameManager* instance;
 
-        // ݂̃V[
+        // 現在のシーン
         static class SceneBase* nowScene;
 
-        // ʉ
+        // 画面横幅
         int screenWidth;
 
-        // ʏc
+        // 画面縦幅
         int screenHeight;
 
-        // SʃtO
+        // 全画面フラグ
         bool fullScreen;
 
     public:
         /// <summary>
-        /// CX^X̐
+        /// インスタンスの生成
         /// </summary>
         static void CreateInstance();
 
         /// <summary>
-        /// CX^X̍폜
+        /// インスタンスの削除
         /// </summary>
         static void DeleteInstance();
 
         /// <summary>
-        /// ŏ̃V[̐ݒ
+        /// 最初のシーンの設定
         /// </summary>
-        /// <param name="scene">ŏɕ\V[</param>
+        /// <param name="scene">最初に表示したいシーン</param>
         static void SetFirstScene(SceneBase* scene) { nowScene = scene; }
 
         /// <summary>
-        /// Q[[v
+        /// ゲームループ
         /// </summary>
         static void Loop();
 
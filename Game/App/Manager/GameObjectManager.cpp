@@ -1,21 +1,115 @@
 #include "GameObjectManager.h"
+#include "EntityManager.h"
+#include "../Library/MemoryArena.h"
+#include "../Library/Calc3D.h"
+#include "../Library/SpatialHash.h"
+#include "../Library/AABBTree.h"
+#include "../Library/HeightField.h"
+#include "../GameObject/Player.h"
+#include "../GameObject/Enemy.h"
+#include "../GameObject/Bullet.h"
+#include "../GameObject/Map.h"
+#include "../GameObject/Camera.h"
+#include <algorithm>
+#include <cassert>
 
 namespace My3dApp
 {
+    // この距離より遠く、止まっているオブジェクトは休眠させる
+    const float sleepDistance = 3000.0f;
 
-    // Q[IuWFNg}l[WCX^Xւ̃|C^`
+    // この距離より近づいた休眠オブジェクトは起こす（休眠距離より短くして切り替えが往復しないようにする）
+    const float wakeDistance = 2500.0f;
+
+    // 止まっているとみなす1フレームあたりの移動量
+    const float sleepSpeed = 0.05f;
+
+    // 1フレームに起床判定する休眠オブジェクトの数（タグごと）
+    const int dormantCheckNum = 64;
+
+    // この距離より遠いと更新間隔を2倍にしていく（1/2、1/4、1/8フレームに1回）
+    const float lodDistance[] = { 800.0f, 1600.0f, 2400.0f };
+
+    // ブロードフェーズのセル1辺の長さ（キャラクターの境界球の直径程度）
+    const float broadphaseCellSize = 200.0f;
+
+    // 境界箱の木の葉に持たせる余裕（数フレーム分の移動量程度）
+    const float broadphaseFatMargin = 20.0f;
+
+    // タグ特性を持つオブジェクトの型の一覧（この順に更新・描画する）
+    using RegisteredObjectTypes = ObjectTypeList<Player, Bullet, Enemy, Map, Camera>;
+
+    // ゲームオブジェクトマネージャインスタンスへのポインタ定義
     GameObjectManager* GameObjectManager::instance = nullptr;
 
     GameObjectManager::GameObjectManager()
         : pendingObjects()
         , objects()
+        , activeNum()
+        , tagActivity()
+        , tagTypeCheckFunc()
+        , tagTypeID()
+        , tagUseLod()
+        , frameCount(0)
+        , tagCollisionFunc()
+        , tagCollisionStayFunc()
+        , tagCollisionExitFunc()
+        , tagGroundHitFunc()
+        , tagPushBackFunc()
+        , tagSweepHitFunc()
+        , collisionMatrix()
+        , broadphase(new SpatialHash(broadphaseCellSize))
+        , broadphaseType(BroadphaseType::SpatialHash)
+        , collisionPairs()
+        , queryIDs()
+        , contactCache()
+        , narrowTasks()
+        , narrowOrder()
+        , narrowGroupStarts()
+        , narrowResults(JobSystem::GetThreadNum())
+        , mergedResults()
+        , groundPairs()
+        , groundRays()
+        , groundRayObjects()
+        , sweepContacts()
+        , dormantCursor()
+        , pools()
+        , handleSlots()
+        , freeHandles()
+        , releaseQueue()
+        , sceneArena(nullptr)
+        , isParallelUpdate(false)
+        , commandBuffers(JobSystem::GetThreadNum())
     {
         instance = nullptr;
+
+        // 添字0は無効ハンドル用に予約
+        handleSlots.push_back({ nullptr, 0, -1, -1, false, false });
+
+        for (int i = 0; i < ObjectTagNum; ++i)
+        {
+            tagActivity[i] = ObjectActivity::Always;
+            tagTypeCheckFunc[i] = nullptr;
+            tagTypeID[i] = -1;
+            tagUseLod[i] = false;
+            tagCollisionFunc[i] = nullptr;
+            tagCollisionStayFunc[i] = nullptr;
+            tagCollisionExitFunc[i] = nullptr;
+            tagGroundHitFunc[i] = nullptr;
+            tagPushBackFunc[i] = nullptr;
+            tagSweepHitFunc[i] = nullptr;
+        }
     }
 
     GameObjectManager::~GameObjectManager()
     {
-        ReleaseAllObject();
+        delete broadphase;
+
+        for (auto pool : pools)
+        {
+            delete pool;
+        }
+        pools.clear();
     }
 
     void GameObjectManager::CreateInstance()
@@ -23,6 +117,9 @@ namespace My3dApp
         if (!instance)
         {
             instance = new GameObjectManager();
+
+            // タグごとの休眠の扱いを型の特性から引く
+            RegisterTypes(RegisteredObjectTypes());
         }
     }
 
@@ -39,52 +136,188 @@ namespace My3dApp
 
     void GameObjectManager::Update(float deltaTime)
     {
+        ++instance->frameCount;
 
-        for (auto& tag : ObjectTagAll)
+        // 型ごとに更新（更新中に登録されたオブジェクトは保留に積まれる）
+        UpdateTypes(RegisteredObjectTypes(), deltaTime, false);
+        UpdateUntypedObjects(deltaTime);
+
+        // エンティティのシステムで移動・回転・当たり判定位置をまとめて更新
+        GameObject* player = GetFirstGameObject(ObjectTag::Player);
+        VECTOR chaseTarget = player ? player->GetPos() : VGet(0, 0, 0);
+
+        EntityManager::Update(deltaTime, player ? &chaseTarget : nullptr, instance->frameCount);
+
+        // システムの結果を活動中のオブジェクトに反映
+        for (int tagIndex = 0; tagIndex < ObjectTagNum; ++tagIndex)
         {
-            // Y^Oɂ邷ׂẴIuWFNg̍XV
-            for (int i = 0; i < instance->objects[tag].size(); ++i)
+            const ArenaVector<GameObject*>& objects = instance->objects[tagIndex];
+            const int objectNum = instance->activeNum[tagIndex];
+
+            if (instance->isParallelUpdate)
+            {
+                ParallelForObjects(objects, objectNum, [](GameObject* object)
+                {
+                    if (object->GetEntity().IsValid())
+                    {
+                        object->SyncFromEntity();
+                    }
+                });
+                continue;
+            }
+
+            for (int i = 0; i < objectNum; ++i)
             {
-                instance->objects[tag][i]->Update(deltaTime);
+                if (objects[i]->GetEntity().IsValid())
+                {
+                    objects[i]->SyncFromEntity();
+                }
             }
         }
 
-        for (auto pending : instance->pendingObjects)
+        // カメラなどはシステムで進めたこのフレームのプレイヤーの位置を追う
+        UpdateTypes(RegisteredObjectTypes(), deltaTime, true);
+
+        // プレイヤーから遠く止まっているものは休眠させ、近づいたものは起こす
+        // 遠いものは更新間隔を間引く
+        if (player)
         {
-            ObjectTag tag = pending->GetTag();
-            instance->objects[tag].emplace_back(pending);
+            UpdateActivity(chaseTarget);
+
+            UpdateLod(chaseTarget);
         }
 
-        instance->pendingObjects.clear();
+        // 更新中に積まれた生成・削除をまとめて適用
+        ApplyCommands();
+    }
 
-        vector<GameObject*> deadObjects;
-        for (auto& tag : ObjectTagAll)
+    void GameObjectManager::ApplyCommands()
+    {
+        // 生成コマンド：保留オブジェクトを実行オブジェクトに移す
+        // エンティティ生成時の処理から積まれた分は並びの後ろに増えるので、ここでは移さず次のフレームに回す
+        ArenaVector<GameObject*>& pendingObjects = instance->pendingObjects;
+        const size_t pendingNum = pendingObjects.size();
+        for (size_t i = 0; i < pendingNum; ++i)
         {
-            for (int i = 0; i < instance->objects[tag].size(); ++i)
+            GameObject* pending = pendingObjects[i];
+
+            // エンティティの追加はチャンクを動かすので、読み手のいないここでまとめて行う
+            if (pending->entityMask)
+            {
+                pending->BuildEntity();
+            }
+
+            const int tagIndex = TagIndex(pending->GetTag());
+            ArenaVector<GameObject*>& objects = instance->objects[tagIndex];
+            objects.emplace_back(pending);
+
+            HandleSlot& slot = instance->handleSlots[pending->handle.index];
+            slot.position = static_cast<int>(objects.size()) - 1;
+            slot.isPending = false;
+
+            // 更新不要なオブジェクトは最初から休眠させておく
+            if (instance->tagActivity[tagIndex] == ObjectActivity::Static)
             {
-                if (!instance->objects[tag][i]->GetAlive())
+                if (pending->entity.IsValid())
                 {
-                    deadObjects.emplace_back(instance->objects[tag][i]);
+                    EntityManager::AddComponent(pending->entity, DormantBit);
                 }
+                continue;
             }
+
+            // 活動中の並びの末尾に入れる
+            SwapAt(objects, instance->activeNum[tagIndex]++, slot.position);
+        }
+
+        pendingObjects.erase(pendingObjects.begin(), pendingObjects.begin() + pendingNum);
+
+        // 次のフレームに回した分の保留配列の中での位置を詰め直す
+        for (size_t i = 0; i < pendingObjects.size(); ++i)
+        {
+            instance->handleSlots[pendingObjects[i]->handle.index].position = static_cast<int>(i);
+        }
+
+        // 削除するオブジェクトとの接触は、オブジェクトが残っているうちに相手へ離れたことを伝えて消す
+        // 離れたときの処理で削除が積まれたら、その接触も残さないよう積まれなくなるまで繰り返す
+        size_t purgedNum = 0;
+        while (purgedNum != instance->releaseQueue.size())
+        {
+            purgedNum = instance->releaseQueue.size();
+            instance->contactCache.RemoveIf([](const ContactCache::Contact& contact)
+            {
+                if (!instance->handleSlots[contact.idA].isReleaseQueued && !instance->handleSlots[contact.idB].isReleaseQueued)
+                {
+                    return false;
+                }
+
+                if (contact.isTouching)
+                {
+                    DispatchCollision(GetProxyObject(contact.idA), GetProxyObject(contact.idB), ContactEvent::Exit);
+                }
+                return true;
+            });
         }
 
-        for (auto deadobj : deadObjects)
+        // 削除コマンド：ハンドルから位置を引いて末尾と入れ替えて削除する（1件あたりO(1)）
+        for (auto handle : instance->releaseQueue)
         {
-            delete deadobj;
+            GameObject* releaseObject = Get(handle);
+
+            if (!releaseObject)
+            {
+                continue;
+            }
+
+            RemoveAt(TagIndex(releaseObject->GetTag()), instance->handleSlots[handle.index].position);
+
+            DestroyObject(releaseObject);
         }
-        deadObjects.clear();
+
+        instance->releaseQueue.clear();
     }
 
     void GameObjectManager::Draw()
     {
-        for (auto& tag : ObjectTagAll)
+        DrawTypes(RegisteredObjectTypes());
+        DrawUntypedObjects();
+    }
+
+    void GameObjectManager::UpdateUntypedObjects(float deltaTime)
+    {
+        for (int tagIndex = 0; tagIndex < ObjectTagNum; ++tagIndex)
         {
-            for (int i = 0; i < instance->objects[tag].size(); ++i)
+            if (instance->tagTypeCheckFunc[tagIndex])
             {
-                if (instance->objects[tag][i]->GetVisible())
+                continue;
+            }
+
+            const ArenaVector<GameObject*>& objects = instance->objects[tagIndex];
+            const int objectNum = instance->activeNum[tagIndex];
+
+            for (int i = 0; i < objectNum; ++i)
+            {
+                if (objects[i]->GetAlive())
+                {
+                    objects[i]->Update(deltaTime);
+                }
+            }
+        }
+    }
+
+    void GameObjectManager::DrawUntypedObjects()
+    {
+        for (int tagIndex = 0; tagIndex < ObjectTagNum; ++tagIndex)
+        {
+            if (instance->tagTypeCheckFunc[tagIndex])
+            {
+                continue;
+            }
+
+            for (auto object : instance->objects[tagIndex])
+            {
+                if (object->GetAlive() && object->GetVisible())
                 {
-                    instance->objects[tag][i]->Draw();
+                    object->Draw();
                 }
             }
         }
@@ -92,78 +325,1145 @@ namespace My3dApp
 
     void GameObjectManager::Entry(GameObject* newObject)
     {
-        // ۗIuWFNgɈꎞۑ
+        lock_guard<mutex> lock(instance->entryMutex);
+
+        EntryWithType(newObject, -1);
+    }
+
+    bool GameObjectManager::EntryWithType(GameObject* newObject, int typeID)
+    {
+        // 型を決め打ちして呼ぶタグに違う型が入ると呼び出しが壊れるので、登録せずに破棄する
+        const int tagIndex = TagIndex(newObject->GetTag());
+        const TypeCheckFunc typeCheck = instance->tagTypeCheckFunc[tagIndex];
+        if (typeCheck && typeID != instance->tagTypeID[tagIndex] && !typeCheck(newObject))
+        {
+            assert(!"object type does not match the ObjectTagTraits of its tag");
+            DestroyObject(newObject);
+            return false;
+        }
+
+        // ハンドルの割り当て
+        unsigned int index;
+        if (!instance->freeHandles.empty())
+        {
+            index = instance->freeHandles.back();
+            instance->freeHandles.pop_back();
+        }
+        else
+        {
+            index = static_cast<unsigned int>(instance->handleSlots.size());
+            instance->handleSlots.push_back({ nullptr, 1, -1, -1, false, false });
+        }
+
+        // 保留オブジェクトに一時保存
         instance->pendingObjects.push_back(newObject);
+
+        HandleSlot& slot = instance->handleSlots[index];
+        slot.object = newObject;
+        slot.typeID = typeID;
+        slot.position = static_cast<int>(instance->pendingObjects.size()) - 1;
+        slot.isPending = true;
+        slot.isReleaseQueued = false;
+
+        newObject->handle = { index, slot.generation };
+        return true;
     }
 
     void GameObjectManager::Release(GameObject* releaseObject)
     {
-        auto pending = instance->pendingObjects;
-        auto itr = find(pending.begin(), pending.end(), releaseObject);
-        if (itr != pending.end())
+        lock_guard<mutex> lock(instance->entryMutex);
+
+        if (!releaseObject || !IsAlive(releaseObject->handle))
+        {
+            return;
+        }
+
+        // 同じオブジェクトに2回積まないようにする
+        HandleSlot& slot = instance->handleSlots[releaseObject->handle.index];
+        if (slot.isReleaseQueued)
         {
-            iter_swap(itr, pending.end() - 1);
-            pending.pop_back();
+            return;
+        }
+        slot.isReleaseQueued = true;
+
+        releaseObject->isAlive = false;
+
+        instance->releaseQueue.push_back(releaseObject->handle);
+    }
 
+    void GameObjectManager::SwapAt(ArenaVector<GameObject*>& array, int a, int b)
+    {
+        if (a == b)
+        {
             return;
         }
 
-        auto object = instance->objects[releaseObject->GetTag()];
-        itr = find(object.begin(), object.end(), releaseObject);
-        if (itr != object.end())
+        swap(array[a], array[b]);
+
+        instance->handleSlots[array[a]->handle.index].position = a;
+        instance->handleSlots[array[b]->handle.index].position = b;
+    }
+
+    void GameObjectManager::RemoveAt(int tagIndex, int position)
+    {
+        ArenaVector<GameObject*>& array = instance->objects[tagIndex];
+        int& active = instance->activeNum[tagIndex];
+
+        // 活動中なら活動中の末尾と入れ替えて、休眠中の並びの先頭に寄せる
+        if (position < active)
+        {
+            SwapAt(array, position, active - 1);
+            position = --active;
+        }
+
+        // 配列の末尾と入れ替えて取り外す
+        SwapAt(array, position, static_cast<int>(array.size()) - 1);
+        array.pop_back();
+    }
+
+    void GameObjectManager::SleepAt(int tagIndex, int position)
+    {
+        ArenaVector<GameObject*>& objects = instance->objects[tagIndex];
+        const int last = --instance->activeNum[tagIndex];
+
+        SwapAt(objects, position, last);
+
+        // エンティティのシステムからも外す
+        GameObject* object = objects[last];
+        if (object->entity.IsValid())
         {
-            iter_swap(itr, object.end() - 1);
-            delete object.back();
+            EntityManager::AddComponent(object->entity, DormantBit);
         }
     }
 
-    void GameObjectManager::ReleaseAllObject()
+    void GameObjectManager::WakeAt(int tagIndex, int position)
     {
-        while (!instance->pendingObjects.empty())
+        ArenaVector<GameObject*>& objects = instance->objects[tagIndex];
+        const int first = instance->activeNum[tagIndex]++;
+
+        SwapAt(objects, position, first);
+
+        GameObject* object = objects[first];
+        if (object->entity.IsValid())
         {
-            delete instance->pendingObjects.back();
+            EntityManager::RemoveComponent(object->entity, DormantBit);
         }
+    }
 
-        for (auto& tag : ObjectTagAll)
+    void GameObjectManager::UpdateActivity(const VECTOR& center)
+    {
+        for (int tagIndex = 0; tagIndex < ObjectTagNum; ++tagIndex)
+        {
+            if (instance->tagActivity[tagIndex] != ObjectActivity::Sleepable)
+            {
+                continue;
+            }
+
+            ArenaVector<GameObject*>& objects = instance->objects[tagIndex];
+            int& active = instance->activeNum[tagIndex];
+
+            // 活動中：遠くて止まっているものを休眠させる
+            for (int i = 0; i < active;)
+            {
+                GameObject* object = objects[i];
+
+                bool isStop = true;
+                if (object->entity.IsValid() && EntityManager::HasComponent(object->entity, VelocityBit))
+                {
+                    isStop = VSquareSize(EntityManager::Get<VelocityComponent>(object->entity).speed) < sleepSpeed * sleepSpeed;
+                }
+
+                if (isStop && sleepDistance * sleepDistance < VSquareSize(object->GetPos() - center))
+                {
+                    // 末尾の活動中オブジェクトがこの位置に来るので添字は進めない
+                    SleepAt(tagIndex, i);
+                    continue;
+                }
+
+                ++i;
+            }
+
+            // 休眠中：数フレームかけて一巡し、近づいたものを起こす
+            const int dormantNum = static_cast<int>(objects.size()) - active;
+            const int checkNum = dormantNum < dormantCheckNum ? dormantNum : dormantCheckNum;
+            int& cursor = instance->dormantCursor[tagIndex];
+
+            for (int i = 0; i < checkNum; ++i)
+            {
+                if (cursor < active || static_cast<int>(objects.size()) <= cursor)
+                {
+                    cursor = active;
+                }
+
+                if (VSquareSize(objects[cursor]->GetPos() - center) < wakeDistance * wakeDistance)
+                {
+                    WakeAt(tagIndex, cursor);
+                }
+
+                ++cursor;
+            }
+        }
+    }
+
+    void GameObjectManager::UpdateLod(const VECTOR& center)
+    {
+        for (int tagIndex = 0; tagIndex < ObjectTagNum; ++tagIndex)
         {
-            while (!instance->objects[tag].empty())
+            if (!instance->tagUseLod[tagIndex])
+            {
+                continue;
+            }
+
+            const ArenaVector<GameObject*>& objects = instance->objects[tagIndex];
+            const int objectNum = instance->activeNum[tagIndex];
+
+            for (int i = 0; i < objectNum; ++i)
             {
-                delete instance->objects[tag].back();
-                instance->objects[tag].pop_back();
+                GameObject* object = objects[i];
+                if (!object->entity.IsValid() || !EntityManager::HasComponent(object->entity, LodBit))
+                {
+                    continue;
+                }
+
+                const float distance = VSquareSize(object->GetPos() - center);
+
+                int interval = 1;
+                for (auto lod : lodDistance)
+                {
+                    if (lod * lod < distance)
+                    {
+                        interval *= 2;
+                    }
+                }
+
+                EntityManager::Get<LodComponent>(object->entity).interval = interval;
             }
         }
     }
 
-    void GameObjectManager::Collision()
+    void GameObjectManager::Wake(GameObjectHandle handle)
+    {
+        if (!IsDormant(handle))
+        {
+            return;
+        }
+
+        GameObject* object = Get(handle);
+        const int tagIndex = TagIndex(object->GetTag());
+
+        // 更新不要なオブジェクトは起こさない
+        if (instance->tagActivity[tagIndex] == ObjectActivity::Static)
+        {
+            return;
+        }
+
+        WakeAt(tagIndex, instance->handleSlots[handle.index].position);
+    }
+
+    bool GameObjectManager::IsDormant(GameObjectHandle handle)
+    {
+        if (!IsAlive(handle))
+        {
+            return false;
+        }
+
+        const HandleSlot& slot = instance->handleSlots[handle.index];
+        if (slot.isPending)
+        {
+            return false;
+        }
+
+        return instance->activeNum[TagIndex(slot.object->GetTag())] <= slot.position;
+    }
+
+    void GameObjectManager::ReleaseAllObject()
     {
-        for (int playerNum = 0; playerNum < instance->objects[ObjectTag::Player].size(); ++playerNum)
+        // 積まれていた削除コマンドは下でまとめて消すので不要
+        instance->releaseQueue.clear();
+
+        // エンティティは1件ずつ詰め直さずにまとめて削除する（デストラクタからの削除は何もしなくなる）
+        EntityManager::ReleaseAllEntity();
+
+        // デストラクタだけ呼び、スロットの返却はプール単位でまとめて行う
+        auto destruct = [](GameObject* object)
+        {
+            if (object->pool)
+            {
+                object->~GameObject();
+            }
+            else
+            {
+                delete object;
+            }
+        };
+
+        for (auto pending : instance->pendingObjects)
+        {
+            destruct(pending);
+        }
+        instance->pendingObjects.clear();
+
+        for (auto& tag : ObjectTagAll)
         {
-            for (int mapNum = 0; mapNum < instance->objects[ObjectTag::Map].size(); ++mapNum)
+            ArenaVector<GameObject*>& objects = GetObjects(tag);
+
+            for (auto object : objects)
             {
-                instance->objects[ObjectTag::Player][playerNum]->OnCollisionEnter(instance->objects[ObjectTag::Map][mapNum]);
+                destruct(object);
             }
 
-            for (int enemyNum = 0; enemyNum < instance->objects[ObjectTag::Enemy].size(); ++enemyNum)
+            // 容量は残して次のシーンで再確保しないようにする（アリーナを差し替えたときは新しい確保元で取り直す）
+            objects.clear();
+        }
+
+        for (int i = 0; i < ObjectTagNum; ++i)
+        {
+            instance->activeNum[i] = 0;
+            instance->dormantCursor[i] = 0;
+        }
+
+        // ハンドル管理表をまとめて空きに戻す（使われていたものは世代を進めて古いハンドルを無効にする）
+        vector<HandleSlot>& handleSlots = instance->handleSlots;
+        instance->freeHandles.clear();
+
+        for (unsigned int i = static_cast<unsigned int>(handleSlots.size()) - 1; 0 < i; --i)
+        {
+            HandleSlot& slot = handleSlots[i];
+            if (slot.object && ++slot.generation == 0)
             {
-                instance->objects[ObjectTag::Player][playerNum]->OnCollisionEnter(instance->objects[ObjectTag::Enemy][enemyNum]);
+                slot.generation = 1;
             }
+            slot.object = nullptr;
+            slot.typeID = -1;
+            slot.position = -1;
+            slot.isPending = false;
+            slot.isReleaseQueued = false;
+
+            instance->freeHandles.push_back(i);
         }
 
-        for (int enemyNum = 0; enemyNum < instance->objects[ObjectTag::Enemy].size(); ++enemyNum)
+        // 登録番号がすべて無効になるのでブロードフェーズと接触状態も空にする（離れたときの処理は呼ばない）
+        instance->broadphase->Clear();
+        instance->contactCache.Clear();
+
+        // シーンを抜けるときはプールのブロックをまとめて解放する
+        for (auto pool : instance->pools)
         {
-            for (int mapNum = 0; mapNum < instance->objects[ObjectTag::Map].size(); ++mapNum)
+            if (pool)
             {
-                instance->objects[ObjectTag::Enemy][enemyNum]->OnCollisionEnter(instance->objects[ObjectTag::Map][mapNum]);
+                pool->ReleaseAll();
             }
         }
     }
 
-    GameObject* GameObjectManager::GetFirstGameObject(ObjectTag tag)
+    void GameObjectManager::SetSceneArena(MemoryArena* arena)
     {
-        if (instance->objects[tag].size() == 0)
+        instance->sceneArena = arena;
+
+        // 以降のブロックは新しい確保元から取る
+        for (auto pool : instance->pools)
         {
-            return nullptr;
+            if (pool)
+            {
+                pool->SetArena(arena);
+            }
+        }
+
+        // シーンの間だけ使う配列も新しい確保元に移す（前のシーンのアリーナが残っているうちに呼ばれる）
+        RebindArena(instance->pendingObjects, arena);
+        for (auto& objects : instance->objects)
+        {
+            RebindArena(objects, arena);
+        }
+        RebindArena(instance->releaseQueue, arena);
+        RebindArena(instance->collisionPairs, arena);
+        RebindArena(instance->queryIDs, arena);
+        RebindArena(instance->narrowTasks, arena);
+        RebindArena(instance->narrowOrder, arena);
+        RebindArena(instance->narrowGroupStarts, arena);
+        RebindArena(instance->mergedResults, arena);
+        RebindArena(instance->groundPairs, arena);
+        RebindArena(instance->groundRayObjects, arena);
+        RebindArena(instance->sweepContacts, arena);
+
+        instance->contactCache.SetArena(arena);
+        instance->broadphase->SetArena(arena);
+
+        // エンティティのチャンクも同じ確保元から取る
+        EntityManager::SetArena(arena);
+    }
+
+    void GameObjectManager::Collision()
+    {
+        // 相手として求められているタグも含めて、当たり判定に関わるタグだけを登録する
+        const CollisionMatrix& matrix = instance->collisionMatrix;
+        const unsigned int involvedTags = matrix.GetInvolvedTags();
+
+        // 現在の境界箱をブロードフェーズに登録する（休眠中のものとメッシュは動かないものとして扱う）
+        Broadphase& broadphase = *instance->broadphase;
+        broadphase.BeginFrame();
+
+        for (int tagIndex = 0; tagIndex < ObjectTagNum; ++tagIndex)
+        {
+            if (!(involvedTags & (1u << tagIndex)))
+            {
+                continue;
+            }
+
+            const ArenaVector<GameObject*>& objects = instance->objects[tagIndex];
+            const int activeObjectNum = instance->activeNum[tagIndex];
+
+            for (int i = 0; i < static_cast<int>(objects.size()); ++i)
+            {
+                GameObject* object = objects[i];
+                const bool isStatic = activeObjectNum <= i || object->GetCollisionType() == CollisionType::Model;
+
+                broadphase.SetProxy(static_cast<int>(object->handle.index), object->GetCollisionBounds(),
+                    1u << tagIndex, matrix.GetMask(tagIndex), isStatic);
+            }
+        }
+
+        broadphase.EndFrame();
+
+        ArenaVector<pair<int, int>>& pairs = instance->collisionPairs;
+        pairs.clear();
+        broadphase.FindPairs(pairs);
+
+        instance->contactCache.BeginFrame();
+
+        // メッシュとの組み合わせで先に押し戻しておき、残りの組み合わせはそのあとに判定する
+        // 移動する球の組み合わせは、押し戻しと地面合わせが済んだ位置に対して別にまとめて調べる
+        ResolvePairs(pairs, true);
+
+        // 押し戻した後の足元で地面に合わせる
+        SnapToGround(pairs);
+
+        // 移動する球は最初に触れた相手とだけ当てる
+        ResolveSweeps(pairs);
+
+        ResolvePairs(pairs, false);
+
+        // 境界箱が離れたか、削除されて組み合わせに現れなかったものは離れたときの処理を呼んで忘れる
+        instance->contactCache.EndFrame([](const ContactCache::Contact& contact)
+        {
+            DispatchCollision(GetProxyObject(contact.idA), GetProxyObject(contact.idB), ContactEvent::Exit);
+        });
+    }
+
+    GameObject* GameObjectManager::GetProxyObject(int id)
+    {
+        return instance->handleSlots[id].object;
+    }
+
+    void GameObjectManager::SetBroadphase(BroadphaseType type)
+    {
+        if (instance->broadphaseType == type)
+        {
+            return;
+        }
+
+        delete instance->broadphase;
+
+        if (type == BroadphaseType::AABBTree)
+        {
+            instance->broadphase = new AABBTree(broadphaseFatMargin);
+        }
+        else
+        {
+            instance->broadphase = new SpatialHash(broadphaseCellSize);
+        }
+
+        instance->broadphase->SetArena(instance->sceneArena);
+        instance->broadphaseType = type;
+    }
+
+    void GameObjectManager::QueryOverlap(const AABB& box, unsigned int tagMask, vector<GameObject*>& results)
+    {
+        ArenaVector<int>& ids = instance->queryIDs;
+        ids.clear();
+        instance->broadphase->QueryOverlap(box, tagMask, ids);
+
+        for (int id : ids)
+        {
+            GameObject* object = GetProxyObject(id);
+            if (object && object->GetAlive())
+            {
+                results.push_back(object);
+            }
+        }
+    }
+
+    void GameObjectManager::Raycast(const VECTOR& start, const VECTOR& end, unsigned int tagMask, vector<GameObject*>& results)
+    {
+        ArenaVector<int>& ids = instance->queryIDs;
+        ids.clear();
+        instance->broadphase->QueryRay(start, end, tagMask, ids);
+
+        for (int id : ids)
+        {
+            GameObject* object = GetProxyObject(id);
+            if (object && object->GetAlive())
+            {
+                results.push_back(object);
+            }
+        }
+    }
+
+    void GameObjectManager::DispatchCollision(GameObject* a, GameObject* b, ContactEvent event)
+    {
+        const CollisionFunc* funcs = event == ContactEvent::Enter ? instance->tagCollisionFunc
+            : event == ContactEvent::Stay ? instance->tagCollisionStayFunc : instance->tagCollisionExitFunc;
+
+        // 先の処理で削除されたものは相手にしない（離れたときは削除される相手にも伝える）
+        auto canReceive = [event](const GameObject* self, const GameObject* other)
+        {
+            return self->GetAlive() && (event == ContactEvent::Exit || other->GetAlive());
+        };
+
+        // 削除済みの番号は伝える相手がいないので何もしない
+        if (!a || !b)
+        {
+            return;
+        }
+
+        const int tagA = TagIndex(a->GetTag());
+        const int tagB = TagIndex(b->GetTag());
+
+        if (instance->collisionMatrix.IsEnabled(tagA, tagB) && funcs[tagA] && canReceive(a, b))
+        {
+            funcs[tagA](a, b);
+        }
+
+        if (instance->collisionMatrix.IsEnabled(tagB, tagA) && funcs[tagB] && canReceive(b, a))
+        {
+            funcs[tagB](b, a);
+        }
+    }
+
+    bool GameObjectManager::TestContact(const GameObject* a, const GameObject* b)
+    {
+        CollisionType typeA = a->GetCollisionType();
+        CollisionType typeB = b->GetCollisionType();
+
+        // 種類の順に並べて組み合わせを半分にする
+        if (typeB < typeA)
+        {
+            swap(a, b);
+            swap(typeA, typeB);
+        }
+
+        switch (typeA)
+        {
+        case CollisionType::Line:
+            if (typeB == CollisionType::Sphere)
+            {
+                return CollisionPair(a->GetCollisionLine(), b->GetCollisionSphere());
+            }
+            if (typeB == CollisionType::Capsule)
+            {
+                return CollisionPair(a->GetCollisionLine(), b->GetCollisionCapsule());
+            }
+            break;
+
+        case CollisionType::Sphere:
+            if (typeB == CollisionType::Sphere)
+            {
+                return CollisionPair(a->GetCollisionSphere(), b->GetCollisionSphere());
+            }
+            if (typeB == CollisionType::Capsule)
+            {
+                return CollisionPair(a->GetCollisionSphere(), b->GetCollisionCapsule());
+            }
+            break;
+
+        case CollisionType::Capsule:
+            if (typeB == CollisionType::Capsule)
+            {
+                return CollisionPair(a->GetCollisionCapsule(), b->GetCollisionCapsule());
+            }
+            break;
+
+        default:
+            break;
+        }
+
+        // 判定の無い組み合わせは境界箱の重なりで触れているとみなす
+        return true;
+    }
+
+    void GameObjectManager::CalcContact(const GameObject* a, const GameObject* b, const VECTOR& bodyOffset, NarrowResult& result)
+    {
+        result.isPushBack = false;
+        result.pushBackVec = VGet(0, 0, 0);
+
+        const bool isMeshA = a->GetCollisionType() == CollisionType::Model;
+        if (!isMeshA && b->GetCollisionType() != CollisionType::Model)
+        {
+            result.isTouching = TestContact(a, b);
+            return;
+        }
+
+        const GameObject* mesh = isMeshA ? a : b;
+        const GameObject* body = isMeshA ? b : a;
+        const MeshCollider& collMesh = mesh->GetCollisionMesh();
+
+        // 三角形を持たないメッシュは境界箱の重なりで触れているとみなす
+        result.isTouching = true;
+        if (!collMesh.bvh)
+        {
+            return;
+        }
+
+        const int bodyTag = TagIndex(body->GetTag());
+        const bool isPushBack = body->IsMeshPushBack() && instance->tagPushBackFunc[bodyTag]
+            && instance->collisionMatrix.IsEnabled(bodyTag, TagIndex(mesh->GetTag()));
+
+        // 当たった三角形はスタック上のバッファに受け取る
+        MeshHitList hitList;
+
+        switch (body->GetCollisionType())
+        {
+        case CollisionType::Sphere:
+        {
+            Sphere sphere = body->GetCollisionSphere();
+            sphere.worldCenter += bodyOffset;
+            result.isTouching = CollisionPair(sphere, collMesh, hitList);
+            if (result.isTouching && isPushBack)
+            {
+                result.isPushBack = true;
+                result.pushBackVec = CalcSpherePushBackVecFromMesh(sphere, collMesh, hitList);
+            }
+            break;
+        }
+
+        case CollisionType::Capsule:
+        {
+            Capsule capsule = body->GetCollisionCapsule();
+            capsule.worldStart += bodyOffset;
+            capsule.worldEnd += bodyOffset;
+            result.isTouching = CollisionPair(capsule, collMesh, hitList);
+            if (result.isTouching && isPushBack)
+            {
+                result.isPushBack = true;
+                result.pushBackVec = CalcCapsulePushBackVecFromMesh(capsule, collMesh, hitList);
+            }
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+
+    void GameObjectManager::ResolvePairs(const ArenaVector<pair<int, int>>& pairs, bool isMeshRound)
+    {
+        auto isSweepPair = [](const pair<int, int>& collisionPair)
+        {
+            return GetProxyObject(collisionPair.first)->GetCollisionType() == CollisionType::SweptSphere
+                || GetProxyObject(collisionPair.second)->GetCollisionType() == CollisionType::SweptSphere;
+        };
+        auto isMeshPair = [](const pair<int, int>& collisionPair)
+        {
+            return GetProxyObject(collisionPair.first)->GetCollisionType() == CollisionType::Model
+                || GetProxyObject(collisionPair.second)->GetCollisionType() == CollisionType::Model;
+        };
+
+        // 接触状態を引き、前回の判定から動いた組み合わせに判定の印をつける（接触状態の表はメインスレッドだけで触る）
+        ContactCache& cache = instance->contactCache;
+        ArenaVector<NarrowTask>& tasks = instance->narrowTasks;
+        tasks.clear();
+
+        for (auto& collisionPair : pairs)
+        {
+            if (isMeshPair(collisionPair) != isMeshRound || isSweepPair(collisionPair))
+            {
+                continue;
+            }
+
+            // 先の処理で削除されたものは記録を更新せず、フレームの終わりに離れたものとして扱う
+            const GameObject* a = GetProxyObject(collisionPair.first);
+            const GameObject* b = GetProxyObject(collisionPair.second);
+            if (!a->GetAlive() || !b->GetAlive())
+            {
+                continue;
+            }
+
+            // 接触状態は登録番号の小さい順に並べて持つ
+            if (b->handle.index < a->handle.index)
+            {
+                swap(a, b);
+            }
+
+            NarrowTask task;
+            task.idA = static_cast<int>(a->handle.index);
+            task.idB = static_cast<int>(b->handle.index);
+            task.contactIndex = cache.Touch(task.idA, a->handle.generation, task.idB, b->handle.generation);
+            task.body = a->GetCollisionType() == CollisionType::Model ? task.idB : task.idA;
+            task.versionA = a->collisionVersion;
+            task.versionB = b->collisionVersion;
+
+            const ContactCache::Contact& contact = cache.GetContact(task.contactIndex);
+            task.isMoved = !contact.isTested || contact.versionA != task.versionA || contact.versionB != task.versionB;
+
+            tasks.push_back(task);
+        }
+
+        // メッシュとの組み合わせは押し戻される側ごとにまとめる（まとまりの中は組み合わせの順）
+        const int taskNum = static_cast<int>(tasks.size());
+        ArenaVector<int>& order = instance->narrowOrder;
+        ArenaVector<int>& groupStarts = instance->narrowGroupStarts;
+        order.clear();
+        groupStarts.clear();
+
+        for (int i = 0; i < taskNum; ++i)
+        {
+            order.push_back(i);
+        }
+
+        if (isMeshRound)
+        {
+            sort(order.begin(), order.end(), [&tasks](int a, int b)
+            {
+                return tasks[a].body != tasks[b].body ? tasks[a].body < tasks[b].body : a < b;
+            });
+        }
+
+        for (int i = 0; i < taskNum; ++i)
+        {
+            if (!isMeshRound || i == 0 || tasks[order[i]].body != tasks[order[i - 1]].body)
+            {
+                groupStarts.push_back(i);
+            }
+        }
+        groupStarts.push_back(taskNum);
+
+        // 動いた組み合わせだけワーカースレッドで判定し、スレッドごとのバッファに結果を積む
+        for (auto& results : instance->narrowResults)
+        {
+            results.clear();
+        }
+
+        const int groupNum = static_cast<int>(groupStarts.size()) - 1;
+        JobSystem::ParallelFor(groupNum, narrowphaseGrainSize, [&tasks, &order, &groupStarts](int begin, int end, int threadIndex)
+        {
+            vector<NarrowResult>& results = instance->narrowResults[threadIndex];
+
+            for (int group = begin; group < end; ++group)
+            {
+                // 同じオブジェクトへの押し戻しは、先に求めた分を足した位置で次のメッシュを調べる
+                VECTOR pushBackSum = VGet(0, 0, 0);
+
+                for (int k = groupStarts[group]; k < groupStarts[group + 1]; ++k)
+                {
+                    const int i = order[k];
+                    if (!tasks[i].isMoved)
+                    {
+                        continue;
+                    }
+
+                    NarrowResult result;
+                    result.task = i;
+                    CalcContact(GetProxyObject(tasks[i].idA), GetProxyObject(tasks[i].idB), pushBackSum, result);
+                    results.push_back(result);
+
+                    if (result.isPushBack)
+                    {
+                        pushBackSum += result.pushBackVec;
+                    }
+                }
+            }
+        });
+
+        // どのスレッドが判定したかによらないように、組み合わせの順に並べ直す
+        ArenaVector<NarrowResult>& merged = instance->mergedResults;
+        merged.clear();
+        for (auto& results : instance->narrowResults)
+        {
+            merged.insert(merged.end(), results.begin(), results.end());
+        }
+
+        sort(merged.begin(), merged.end(), [](const NarrowResult& a, const NarrowResult& b)
+        {
+            return a.task < b.task;
+        });
+
+        // 組み合わせの順に1回で反映する
+        size_t resultIndex = 0;
+        for (int i = 0; i < static_cast<int>(tasks.size()); ++i)
+        {
+            const NarrowTask& task = tasks[i];
+            const NarrowResult* result = nullptr;
+            if (resultIndex < merged.size() && merged[resultIndex].task == i)
+            {
+                result = &merged[resultIndex++];
+            }
+
+            GameObject* a = GetProxyObject(task.idA);
+            GameObject* b = GetProxyObject(task.idB);
+            ContactCache::Contact& contact = cache.GetContact(task.contactIndex);
+
+            // 反映の途中で削除されたものは、ここで離れたことにする
+            if (!a->GetAlive() || !b->GetAlive())
+            {
+                if (contact.isTouching)
+                {
+                    contact.isTouching = false;
+                    DispatchCollision(a, b, ContactEvent::Exit);
+                }
+                continue;
+            }
+
+            const bool wasTouching = contact.isTouching;
+            const bool isTouching = result ? result->isTouching : wasTouching;
+            contact.isTouching = isTouching;
+
+            // 判定した位置の版を残す（押し戻しで動いた分は次のフレームで判定し直す）
+            if (result)
+            {
+                contact.versionA = task.versionA;
+                contact.versionB = task.versionB;
+                contact.isTested = true;
+            }
+
+            // 押し戻しは接触の処理より先に反映する
+            if (result && result->isPushBack)
+            {
+                GameObject* body = a->GetCollisionType() == CollisionType::Model ? b : a;
+                instance->tagPushBackFunc[TagIndex(body->GetTag())](body, result->pushBackVec);
+            }
+
+            if (isTouching || wasTouching)
+            {
+                DispatchCollision(a, b, !isTouching ? ContactEvent::Exit : wasTouching ? ContactEvent::Stay : ContactEvent::Enter);
+            }
+        }
+    }
+
+    void GameObjectManager::SnapToGround(const ArenaVector<pair<int, int>>& pairs)
+    {
+        // メッシュと、それを当たりの対象にしている地面合わせのオブジェクトの組み合わせを集める
+        auto isGroundSnapTarget = [](const GameObject* object, const GameObject* mesh)
+        {
+            return object->IsGroundSnap() && object->GetAlive()
+                && instance->collisionMatrix.IsEnabled(TagIndex(object->GetTag()), TagIndex(mesh->GetTag()))
+                && instance->tagGroundHitFunc[TagIndex(object->GetTag())];
+        };
+
+        ArenaVector<pair<int, int>>& groundPairs = instance->groundPairs;
+        groundPairs.clear();
+
+        for (auto& collisionPair : pairs)
+        {
+            const GameObject* a = GetProxyObject(collisionPair.first);
+            const GameObject* b = GetProxyObject(collisionPair.second);
+
+            if (a->GetCollisionType() == CollisionType::Model && a->GetCollisionMesh().bvh && isGroundSnapTarget(b, a))
+            {
+                groundPairs.emplace_back(collisionPair.first, collisionPair.second);
+            }
+            else if (b->GetCollisionType() == CollisionType::Model && b->GetCollisionMesh().bvh && isGroundSnapTarget(a, b))
+            {
+                groundPairs.emplace_back(collisionPair.second, collisionPair.first);
+            }
+        }
+
+        // メッシュごとにまとめる
+        sort(groundPairs.begin(), groundPairs.end());
+
+        MeshRayBatch& batch = instance->groundRays;
+        ArenaVector<int>& rayObjects = instance->groundRayObjects;
+        const int pairNum = static_cast<int>(groundPairs.size());
+
+        for (int first = 0; first < pairNum;)
+        {
+            int last = first + 1;
+            while (last < pairNum && groundPairs[last].first == groundPairs[first].first)
+            {
+                ++last;
+            }
+
+            // メッシュのローカル座標に直した足元の線分のうち、高さの格子で答えられるものはその場で合わせ、
+            // 残りを束ねて木を1回でたどる
+            const MeshCollider& mesh = GetProxyObject(groundPairs[first].first)->GetCollisionMesh();
+            batch.Clear();
+            rayObjects.clear();
+
+            for (int i = first; i < last; ++i)
+            {
+                GameObject* object = GetProxyObject(groundPairs[i].second);
+                const LineSegment line = object->GetCollisionLine();
+                const VECTOR start = line.worldStart - mesh.worldOrigin;
+                const VECTOR end = line.worldEnd - mesh.worldOrigin;
+
+                bool isHit;
+                MeshRayHit hit;
+                if (mesh.heightField && mesh.heightField->RaycastDown(start, end, isHit, hit))
+                {
+                    if (isHit)
+                    {
+                        hit.position += mesh.worldOrigin;
+                        instance->tagGroundHitFunc[TagIndex(object->GetTag())](object, hit);
+                    }
+                    continue;
+                }
+
+                batch.Add(start, end);
+                rayObjects.push_back(groundPairs[i].second);
+            }
+
+            if (rayObjects.empty())
+            {
+                first = last;
+                continue;
+            }
+
+            mesh.bvh->RaycastBatch(batch);
+
+            for (size_t i = 0; i < rayObjects.size(); ++i)
+            {
+                MeshRayHit& hit = batch.hits[i];
+                GameObject* object = GetProxyObject(rayObjects[i]);
+
+                if (hit.triangle == -1 || !object->GetAlive())
+                {
+                    continue;
+                }
+
+                hit.position += mesh.worldOrigin;
+                instance->tagGroundHitFunc[TagIndex(object->GetTag())](object, hit);
+            }
+
+            first = last;
+        }
+    }
+
+    bool GameObjectManager::CalcSweepHit(const GameObject* sweeper, const GameObject* other, MeshRayHit& hit)
+    {
+        const SweptSphere& sweep = sweeper->GetCollisionSweep();
+
+        if (other->GetCollisionType() == CollisionType::Model)
+        {
+            return other->GetCollisionMesh().bvh && CollisionPair(sweep, other->GetCollisionMesh(), hit);
+        }
+
+        // 相手の形状ごとに時刻を求め、触れたときの中心と相手の芯の最近点から押し返す向きを求める
+        float hitTime;
+        VECTOR axisStart;
+        VECTOR axisEnd;
+
+        switch (other->GetCollisionType())
+        {
+        case CollisionType::Sphere:
+        {
+            const Sphere sphere = other->GetCollisionSphere();
+            if (!CollisionPair(sweep, sphere, hitTime))
+            {
+                return false;
+            }
+            axisStart = sphere.worldCenter;
+            axisEnd = sphere.worldCenter;
+            break;
+        }
+
+        case CollisionType::Capsule:
+        {
+            const Capsule capsule = other->GetCollisionCapsule();
+            if (!CollisionPair(sweep, capsule, hitTime))
+            {
+                return false;
+            }
+            axisStart = capsule.worldStart;
+            axisEnd = capsule.worldEnd;
+            break;
+        }
+
+        default:
+            // 線分や移動する球同士は調べない
+            return false;
+        }
+
+        hit.triangle = -1;
+        hit.hitRate = hitTime;
+        hit.position = sweep.worldStart + (sweep.worldEnd - sweep.worldStart) * hitTime;
+
+        const VECTOR toCenter = hit.position - CalcClosestPointOnSegment(hit.position, axisStart, axisEnd);
+        const float distance = VSize(toCenter);
+        hit.normal = 1.0e-6f < distance ? VScale(toCenter, 1.0f / distance) : VGet(0.0f, 1.0f, 0.0f);
+        return true;
+    }
+
+    void GameObjectManager::ResolveSweeps(const ArenaVector<pair<int, int>>& pairs)
+    {
+        // 移動する球が当たりの対象にしている相手との衝突時刻を求める
+        ArenaVector<SweepContact>& contacts = instance->sweepContacts;
+        contacts.clear();
+
+        for (auto& collisionPair : pairs)
+        {
+            int sweeperID = collisionPair.first;
+            int otherID = collisionPair.second;
+
+            if (GetProxyObject(sweeperID)->GetCollisionType() != CollisionType::SweptSphere)
+            {
+                swap(sweeperID, otherID);
+            }
+
+            const GameObject* sweeper = GetProxyObject(sweeperID);
+            const GameObject* other = GetProxyObject(otherID);
+            const int sweeperTag = TagIndex(sweeper->GetTag());
+
+            if (!sweeper->GetAlive() || !other->GetAlive() || !instance->tagSweepHitFunc[sweeperTag]
+                || !instance->collisionMatrix.IsEnabled(sweeperTag, TagIndex(other->GetTag())))
+            {
+                continue;
+            }
+
+            SweepContact contact;
+            if (CalcSweepHit(sweeper, other, contact.hit))
+            {
+                contact.sweeper = sweeperID;
+                contact.other = otherID;
+                contacts.push_back(contact);
+            }
+        }
+
+        // 移動する球ごとに時刻の早い順に並べ、先頭の相手とだけ当てる（壁の向こうの敵には当たらない）
+        sort(contacts.begin(), contacts.end(), [](const SweepContact& a, const SweepContact& b)
+        {
+            return a.sweeper != b.sweeper ? a.sweeper < b.sweeper : a.hit.hitRate < b.hit.hitRate;
+        });
+
+        for (size_t i = 0; i < contacts.size(); ++i)
+        {
+            GameObject* sweeper = GetProxyObject(contacts[i].sweeper);
+            GameObject* other = GetProxyObject(contacts[i].other);
+
+            // 先の処理で消えた相手は飛ばし、次に早い相手に当てる
+            if (!sweeper->GetAlive() || !other->GetAlive())
+            {
+                continue;
+            }
+
+            const int sweeperTag = TagIndex(sweeper->GetTag());
+
+            // 当たった組み合わせだけ触れていたものとして記録する（外れた組み合わせはフレームの終わりに離れる）
+            ContactCache& cache = instance->contactCache;
+            const int contactIndex = cache.Touch(contacts[i].sweeper, sweeper->handle.generation, contacts[i].other, other->handle.generation);
+            ContactCache::Contact& contact = cache.GetContact(contactIndex);
+            const ContactEvent event = contact.isTouching ? ContactEvent::Stay : ContactEvent::Enter;
+            contact.isTouching = true;
+
+            // 移動する球は当たると消えることが多いので、相手の処理を先に呼ぶ
+            DispatchCollision(other, sweeper, event);
+
+            if (sweeper->GetAlive())
+            {
+                instance->tagSweepHitFunc[sweeperTag](sweeper, other, contacts[i].hit);
+            }
+
+            // 同じ球の残りの候補は当たった相手より遠いので調べない
+            while (i + 1 < contacts.size() && contacts[i + 1].sweeper == contacts[i].sweeper)
+            {
+                ++i;
+            }
+        }
+    }
+
+    int GameObjectManager::NextPoolTypeID()
+    {
+        static int nextID = 0;
+        return nextID++;
+    }
+
+    ObjectPool* GameObjectManager::GetPool(int typeID, size_t objectSize)
+    {
+        if (static_cast<int>(instance->pools.size()) <= typeID)
+        {
+            instance->pools.resize(typeID + 1, nullptr);
+        }
+
+        if (!instance->pools[typeID])
+        {
+            instance->pools[typeID] = new ObjectPool(objectSize);
+            instance->pools[typeID]->SetArena(instance->sceneArena);
+        }
+
+        return instance->pools[typeID];
+    }
+
+    void GameObjectManager::DestroyObject(GameObject* object)
+    {
+        // ハンドルの世代を進めて、古いハンドルからは引けないようにする（0は無効値なので飛ばす）
+        if (object->handle.IsValid())
+        {
+            HandleSlot& slot = instance->handleSlots[object->handle.index];
+            slot.object = nullptr;
+            slot.typeID = -1;
+            slot.position = -1;
+            if (++slot.generation == 0)
+            {
+                slot.generation = 1;
+            }
+            instance->freeHandles.push_back(object->handle.index);
+        }
+
+        ObjectPool* pool = object->pool;
+
+        if (!pool)
+        {
+            delete object;
+            return;
+        }
+
+        // デストラクタだけ呼んでスロットはプールに戻す
+        object->~GameObject();
+        pool->Free(object);
+    }
+
+    bool GameObjectManager::IsAlive(GameObjectHandle handle)
+    {
+        if (!handle.IsValid() || instance->handleSlots.size() <= handle.index)
+        {
+            return false;
+        }
+
+        const HandleSlot& slot = instance->handleSlots[handle.index];
+        return slot.generation == handle.generation && slot.object != nullptr;
+    }
+
+    GameObject* GameObjectManager::Get(GameObjectHandle handle)
+    {
+        if (!IsAlive(handle))
+        {
+            return nullptr;
+        }
+        return instance->handleSlots[handle.index].object;
+    }
+
+    GameObjectHandle GameObjectManager::GetFirstHandle(ObjectTag tag)
+    {
+        GameObject* object = GetFirstGameObject(tag);
+
+        if (!object)
+        {
+            return InvalidHandle;
+        }
+        return object->handle;
+    }
+
+    GameObject* GameObjectManager::GetFirstGameObject(ObjectTag tag)
+    {
+        // 休眠中のものと削除コマンドが積まれたものは返さない（活動中のものがタグ配列の先頭に並んでいる）
+        const int tagIndex = TagIndex(tag);
+        const ArenaVector<GameObject*>& objects = instance->objects[tagIndex];
+
+        for (int i = 0; i < instance->activeNum[tagIndex]; ++i)
+        {
+            if (objects[i]->GetAlive())
+            {
+                return objects[i];
+            }
         }
-        return instance->objects[tag][0];
+        return nullptr;
     }
 }// namespace My3dApp
\ No newline at end of file
@@ -1,88 +1,928 @@
 #pragma once
 
 #include <vector>
-#include <unordered_map>
+#include <new>
+#include <utility>
+#include <mutex>
+#include <type_traits>
 #include "../GameObject/GameObject.h"
 #include "../GameObject/ObjectTag.h"
+#include "../GameObject/CollisionMatrix.h"
+#include "../Library/ObjectPool.h"
+#include "../Library/MemoryArena.h"
+#include "../Library/ModelCommandBuffer.h"
+#include "../Library/JobSystem.h"
+#include "../Library/Broadphase.h"
+#include "../Library/TriangleBVH.h"
+#include "../Library/ContactCache.h"
+#include "EntityManager.h"
 
 using namespace std;
 
 namespace My3dApp
 {
     /// <summary>
-    /// Q[IuWFNg}l[W
+    /// ゲームオブジェクトマネージャ
     /// </summary>
     class GameObjectManager final
     {
     private:
-        /** RXgN^iVOgj*/
+        /** コンストラクタ（シングルトン）*/
 
         /// <summary>
-        /// RXgN^iVOgj
+        /// コンストラクタ（シングルトン）
         /// </summary>
         GameObjectManager();
 
         /// <summary>
-        /// fXgN^
+        /// デストラクタ
         /// </summary>
         ~GameObjectManager();
 
-        // Q[IuWFNg}l[W̗B̃CX^X
+        // ゲームオブジェクトマネージャの唯一のインスタンス
         static GameObjectManager* instance;
 
-        // ۗIuWFNg
-        vector<GameObject*> pendingObjects;
+        // 保留オブジェクト
+        ArenaVector<GameObject*> pendingObjects;
 
-        // sIuWFNg
-        unordered_map<ObjectTag, vector<GameObject*>> objects;
+        // 実行オブジェクト（タグを添字としたタグごとの連続配列、先頭から活動中、以降は休眠中）
+        ArenaVector<GameObject*> objects[ObjectTagNum];
+
+        // タグごとの活動中のオブジェクト数
+        int activeNum[ObjectTagNum];
+
+        // タグごとの休眠の扱い
+        ObjectActivity tagActivity[ObjectTagNum];
+
+        // オブジェクトが指定の型かどうかの確認（型ごとに直接呼ぶ関数）
+        using TypeCheckFunc = bool(*)(const GameObject* object);
+
+        // タグごとの登録できる型の確認（型の一覧に無いタグはnullptrで、仮想呼び出しで更新・描画する）
+        TypeCheckFunc tagTypeCheckFunc[ObjectTagNum];
+
+        // タグごとの登録できる型のプール番号
+        int tagTypeID[ObjectTagNum];
+
+        // タグごとの更新頻度を間引くか
+        bool tagUseLod[ObjectTagNum];
+
+        // フレーム番号（間引き更新するフレームの判定に使う）
+        unsigned int frameCount;
+
+        // 衝突時の処理の呼び出し（型ごとに直接呼ぶ関数）
+        using CollisionFunc = void(*)(GameObject* self, const GameObject* other);
+
+        // タグごとの触れ始めたときの処理
+        CollisionFunc tagCollisionFunc[ObjectTagNum];
+
+        // タグごとの触れ続けているときの処理
+        CollisionFunc tagCollisionStayFunc[ObjectTagNum];
+
+        // タグごとの離れたときの処理
+        CollisionFunc tagCollisionExitFunc[ObjectTagNum];
+
+        // 地面に当たったときの処理の呼び出し（型ごとに直接呼ぶ関数）
+        using GroundHitFunc = void(*)(GameObject* self, const MeshRayHit& hit);
+
+        // タグごとの地面に当たったときの処理
+        GroundHitFunc tagGroundHitFunc[ObjectTagNum];
+
+        // メッシュから押し戻されるときの処理の呼び出し（型ごとに直接呼ぶ関数）
+        using PushBackFunc = void(*)(GameObject* self, const VECTOR& pushBackVec);
+
+        // タグごとのメッシュから押し戻されるときの処理
+        PushBackFunc tagPushBackFunc[ObjectTagNum];
+
+        // 移動する球が最初に触れたときの処理の呼び出し（型ごとに直接呼ぶ関数）
+        using SweepHitFunc = void(*)(GameObject* self, const GameObject* other, const MeshRayHit& hit);
+
+        // タグごとの移動する球が最初に触れたときの処理
+        SweepHitFunc tagSweepHitFunc[ObjectTagNum];
+
+        // タグごとに当たりを取りたい相手のタグの表（シーンが設定する）
+        CollisionMatrix collisionMatrix;
+
+        // 境界箱のブロードフェーズ（登録番号はハンドルの管理表の添字）
+        Broadphase* broadphase;
+
+        // ブロードフェーズの実装の種類
+        BroadphaseType broadphaseType;
+
+        // ブロードフェーズが返した組み合わせ
+        ArenaVector<pair<int, int>> collisionPairs;
+
+        // ブロードフェーズの検索結果の作業領域
+        ArenaVector<int> queryIDs;
+
+        // 前のフレームまでの組み合わせの接触状態（登録番号はハンドルの管理表の添字）
+        ContactCache contactCache;
+
+        /// <summary>
+        /// 狭域判定に回す組み合わせ
+        /// </summary>
+        struct NarrowTask
+        {
+            // 登録番号（idA < idB）
+            int idA;
+            int idB;
+
+            // 接触状態の添字
+            int contactIndex;
+
+            // メッシュとの組み合わせで押し戻される側の登録番号（メッシュを含まない組み合わせはidA）
+            int body;
+
+            // 判定したときの当たり判定位置の版
+            unsigned int versionA;
+            unsigned int versionB;
+
+            // 前回の判定から動いたか（動いていなければ判定せず前回の結果を使う）
+            bool isMoved;
+        };
+
+        /// <summary>
+        /// 狭域判定の結果（ワーカースレッドが書き込み、メインスレッドでまとめて反映する）
+        /// </summary>
+        struct NarrowResult
+        {
+            // 組み合わせの添字（並べ替えのキー）
+            int task;
+
+            // 触れているか
+            bool isTouching;
+
+            // メッシュでない側を押し戻すか
+            bool isPushBack;
+
+            // メッシュでない側の押し戻し量
+            VECTOR pushBackVec;
+        };
+
+        // 狭域判定に回す組み合わせ（ブロードフェーズの組み合わせの順）
+        ArenaVector<NarrowTask> narrowTasks;
+
+        // 判定する順に並べた組み合わせの添字（メッシュとの組み合わせは押し戻される側ごとにまとめる）
+        ArenaVector<int> narrowOrder;
+
+        // 1つのジョブで順に判定する組み合わせのまとまりの開始位置（末尾に終端を置く）
+        ArenaVector<int> narrowGroupStarts;
+
+        // スレッドごとの狭域判定の結果（ワーカースレッドが同時に積むので、アリーナではなくヒープから確保する）
+        vector<vector<NarrowResult>> narrowResults;
+
+        // 組み合わせの順に並べ直した狭域判定の結果
+        ArenaVector<NarrowResult> mergedResults;
+
+        // 並列の狭域判定でジョブ1つに割り当てる組み合わせの数
+        static constexpr int narrowphaseGrainSize = 16;
+
+        // 地面合わせの組み合わせ（メッシュの登録番号、オブジェクトの登録番号）
+        ArenaVector<pair<int, int>> groundPairs;
+
+        // 地面合わせの足元の線分の束（メッシュごとに詰め直して使い回す）
+        MeshRayBatch groundRays;
+
+        // 足元の線分の束に詰めたオブジェクトの登録番号（高さの格子で答えたものは除く）
+        ArenaVector<int> groundRayObjects;
+
+        /// <summary>
+        /// 移動する球が触れる相手の候補
+        /// </summary>
+        struct SweepContact
+        {
+            // 移動する球の登録番号
+            int sweeper;
+
+            // 相手の登録番号
+            int other;
+
+            // 触れた時刻と位置
+            MeshRayHit hit;
+        };
+
+        // 移動する球が触れる相手の候補（移動する球ごとに時刻順に並べる）
+        ArenaVector<SweepContact> sweepContacts;
+
+        /// <summary>
+        /// ブロードフェーズの登録番号からオブジェクトを引く
+        /// </summary>
+        /// <param name="id">登録番号</param>
+        /// <returns>登録番号のオブジェクト</returns>
+        static GameObject* GetProxyObject(int id);
+
+        /// <summary>
+        /// オブジェクトが型Tかどうか
+        /// </summary>
+        /// <param name="object">調べるオブジェクト</param>
+        /// <returns>型Tならtrue</returns>
+        template<class T>
+        static bool IsObjectType(const GameObject* object)
+        {
+            return dynamic_cast<const T*>(object) != nullptr;
+        }
+
+        /// <summary>
+        /// 型Tの衝突時の処理を仮想呼び出しを経由せずに呼ぶ
+        /// </summary>
+        /// <param name="self">衝突したオブジェクト</param>
+        /// <param name="other">相手のオブジェクト</param>
+        template<class T>
+        static void CallOnCollisionEnter(GameObject* self, const GameObject* other)
+        {
+            static_cast<T*>(self)->T::OnCollisionEnter(other);
+        }
+
+        /// <summary>
+        /// 型Tの触れ続けているときの処理を仮想呼び出しを経由せずに呼ぶ
+        /// </summary>
+        /// <param name="self">触れているオブジェクト</param>
+        /// <param name="other">相手のオブジェクト</param>
+        template<class T>
+        static void CallOnCollisionStay(GameObject* self, const GameObject* other)
+        {
+            static_cast<T*>(self)->T::OnCollisionStay(other);
+        }
+
+        /// <summary>
+        /// 型Tの離れたときの処理を仮想呼び出しを経由せずに呼ぶ
+        /// </summary>
+        /// <param name="self">離れたオブジェクト</param>
+        /// <param name="other">相手のオブジェクト</param>
+        template<class T>
+        static void CallOnCollisionExit(GameObject* self, const GameObject* other)
+        {
+            static_cast<T*>(self)->T::OnCollisionExit(other);
+        }
+
+        /// <summary>
+        /// 型Tの地面に当たったときの処理を仮想呼び出しを経由せずに呼ぶ
+        /// </summary>
+        /// <param name="self">地面に当たったオブジェクト</param>
+        /// <param name="hit">ワールド座標の交点の情報</param>
+        template<class T>
+        static void CallOnGroundHit(GameObject* self, const MeshRayHit& hit)
+        {
+            static_cast<T*>(self)->T::OnGroundHit(hit);
+        }
+
+        /// <summary>
+        /// 型Tのメッシュから押し戻されるときの処理を仮想呼び出しを経由せずに呼ぶ
+        /// </summary>
+        /// <param name="self">押し戻されるオブジェクト</param>
+        /// <param name="pushBackVec">押し戻し量</param>
+        template<class T>
+        static void CallOnPushBack(GameObject* self, const VECTOR& pushBackVec)
+        {
+            static_cast<T*>(self)->T::OnPushBack(pushBackVec);
+        }
+
+        /// <summary>
+        /// 型Tの移動する球が最初に触れたときの処理を仮想呼び出しを経由せずに呼ぶ
+        /// </summary>
+        /// <param name="self">移動する球を持つオブジェクト</param>
+        /// <param name="other">最初に触れたオブジェクト</param>
+        /// <param name="hit">触れた時刻と位置</param>
+        template<class T>
+        static void CallOnSweepHit(GameObject* self, const GameObject* other, const MeshRayHit& hit)
+        {
+            static_cast<T*>(self)->T::OnSweepHit(other, hit);
+        }
+
+        /// <summary>
+        /// 組み合わせの接触の変化に応じた処理の呼び出し（相手を当たりの対象にしている側だけ呼ぶ）
+        /// どちらかが削除済み（nullptr）なら何もしない
+        /// </summary>
+        /// <param name="a">オブジェクトA（先に呼ぶ）</param>
+        /// <param name="b">オブジェクトB</param>
+        /// <param name="event">接触の変化の種類</param>
+        static void DispatchCollision(GameObject* a, GameObject* b, ContactEvent event);
+
+        /// <summary>
+        /// メッシュを含まない形状どうしの接触判定（判定の無い組み合わせは境界箱の重なりで触れているとみなす）
+        /// </summary>
+        /// <param name="a">オブジェクトA</param>
+        /// <param name="b">オブジェクトB</param>
+        /// <returns>触れている場合はtrueを返す</returns>
+        static bool TestContact(const GameObject* a, const GameObject* b);
+
+        /// <summary>
+        /// 組み合わせの狭域判定（オブジェクトを書き換えないのでワーカースレッドから呼べる）
+        /// メッシュとの組み合わせは、押し戻す側なら押し戻し量も求める
+        /// </summary>
+        /// <param name="a">オブジェクトA</param>
+        /// <param name="b">オブジェクトB</param>
+        /// <param name="bodyOffset">メッシュでない側の当たり判定をずらして調べる量（同じフレームで先に求めた押し戻しの合計）</param>
+        /// <param name="result">判定の結果</param>
+        static void CalcContact(const GameObject* a, const GameObject* b, const VECTOR& bodyOffset, NarrowResult& result);
+
+        /// <summary>
+        /// 組み合わせの狭域判定をワーカースレッドで行い、組み合わせの順に並べ直した結果を1回でまとめて反映する
+        /// 押し戻しを反映してから、前のフレームの接触状態と比べて触れ始め・触れ続け・離れたときの処理を呼ぶ
+        /// メッシュとの組み合わせは押し戻される側ごとに1つのジョブで順に判定し、先の押し戻しを足した位置で次のメッシュを調べる
+        /// （重なったメッシュや継ぎ目で二重に押し戻さない）、それ以外は反映前の位置で判定するので、スレッド数によらず同じ結果になる
+        /// </summary>
+        /// <param name="pairs">ブロードフェーズが返した組み合わせ</param>
+        /// <param name="isMeshRound">メッシュとの組み合わせを処理するか（falseならメッシュを含まない組み合わせ）</param>
+        static void ResolvePairs(const ArenaVector<pair<int, int>>& pairs, bool isMeshRound);
+
+        /// <summary>
+        /// メッシュと重なっている地面合わせのオブジェクトの足元の線分を、メッシュごとにまとめて判定する
+        /// </summary>
+        /// <param name="pairs">ブロードフェーズが返した組み合わせ</param>
+        static void SnapToGround(const ArenaVector<pair<int, int>>& pairs);
+
+        /// <summary>
+        /// 移動する球と相手の衝突時刻の計算（相手は止まっているものとして扱う）
+        /// </summary>
+        /// <param name="sweeper">移動する球を持つオブジェクト</param>
+        /// <param name="other">相手のオブジェクト</param>
+        /// <param name="hit">触れた時刻と、そのときの球の中心・押し返す向き</param>
+        /// <returns>移動中に触れる場合はtrueを返す</returns>
+        static bool CalcSweepHit(const GameObject* sweeper, const GameObject* other, MeshRayHit& hit);
+
+        /// <summary>
+        /// 移動する球ごとに、ブロードフェーズの組み合わせの中から最も早く触れる相手だけに衝突時の処理を呼ぶ
+        /// </summary>
+        /// <param name="pairs">ブロードフェーズが返した組み合わせ</param>
+        static void ResolveSweeps(const ArenaVector<pair<int, int>>& pairs);
+
+        // タグごとの次に起床判定する休眠オブジェクトの位置（数フレームかけて一巡する）
+        int dormantCursor[ObjectTagNum];
+
+        /// <summary>
+        /// 型Tのタグに休眠の扱い、更新頻度の間引き、衝突時の処理を登録する
+        /// </summary>
+        template<class T>
+        static void RegisterTagTraits()
+        {
+            for (int tagIndex = 0; tagIndex < ObjectTagNum; ++tagIndex)
+            {
+                if (ObjectTagTraits<T>::tagMask & (1u << tagIndex))
+                {
+                    instance->tagTypeCheckFunc[tagIndex] = &IsObjectType<T>;
+                    instance->tagTypeID[tagIndex] = PoolTypeID<T>();
+                    instance->tagActivity[tagIndex] = ObjectTagTraits<T>::activity;
+                    instance->tagUseLod[tagIndex] = ObjectTagTraits<T>::useLod;
+                    instance->tagCollisionFunc[tagIndex] = &CallOnCollisionEnter<T>;
+                    instance->tagCollisionStayFunc[tagIndex] = &CallOnCollisionStay<T>;
+                    instance->tagCollisionExitFunc[tagIndex] = &CallOnCollisionExit<T>;
+                    instance->tagGroundHitFunc[tagIndex] = &CallOnGroundHit<T>;
+                    instance->tagPushBackFunc[tagIndex] = &CallOnPushBack<T>;
+                    instance->tagSweepHitFunc[tagIndex] = &CallOnSweepHit<T>;
+                }
+            }
+        }
+
+        /// <summary>
+        /// タグに対応する実行オブジェクト配列の取得
+        /// </summary>
+        /// <param name="tag">オブジェクトのタグ</param>
+        /// <returns>タグに属するオブジェクトの配列</returns>
+        static ArenaVector<GameObject*>& GetObjects(ObjectTag tag) { return instance->objects[TagIndex(tag)]; }
+
+        // オブジェクトの型ごとのプール（添字はPoolTypeIDで振る）
+        vector<ObjectPool*> pools;
+
+        /// <summary>
+        /// プールを使う型に振る番号の発行
+        /// </summary>
+        /// <returns>新しい番号</returns>
+        static int NextPoolTypeID();
+
+        /// <summary>
+        /// 型ごとのプール番号の取得
+        /// </summary>
+        /// <returns>型Tのプール番号</returns>
+        template<class T>
+        static int PoolTypeID()
+        {
+            static const int id = NextPoolTypeID();
+            return id;
+        }
+
+        /// <summary>
+        /// プールの取得、無ければ作成
+        /// </summary>
+        /// <param name="typeID">型ごとのプール番号</param>
+        /// <param name="objectSize">オブジェクトのサイズ</param>
+        /// <returns>型に対応するプール</returns>
+        static ObjectPool* GetPool(int typeID, size_t objectSize);
+
+        /// <summary>
+        /// オブジェクトの破棄（プールから生成されたものはスロットを返却する）
+        /// </summary>
+        /// <param name="object">破棄するオブジェクト</param>
+        static void DestroyObject(GameObject* object);
+
+        /// <summary>
+        /// ハンドル管理表の要素
+        /// </summary>
+        struct HandleSlot
+        {
+            // 指しているオブジェクト（空きならnullptr）
+            GameObject* object;
+
+            // 現在の世代
+            unsigned int generation;
+
+            // 生成時の型番号（newで生成されたものは-1）
+            int typeID;
+
+            // 保留配列またはタグ配列の中での位置
+            int position;
+
+            // 保留中か
+            bool isPending;
+
+            // 削除コマンドを積んだか
+            bool isReleaseQueued;
+        };
+
+        // ハンドル管理表（添字0は無効ハンドル用に予約、シーンをまたいで古いハンドルを見分けるのでヒープに置く）
+        vector<HandleSlot> handleSlots;
+
+        // 空いている管理表の添字
+        vector<unsigned int> freeHandles;
+
+        // 削除コマンド（同期点でまとめて適用する）
+        ArenaVector<GameObjectHandle> releaseQueue;
+
+        /// <summary>
+        /// 積まれた生成・削除コマンドの適用（1フレームに1回の同期点）
+        /// </summary>
+        static void ApplyCommands();
+
+        /// <summary>
+        /// オブジェクトの登録（型番号つき）
+        /// </summary>
+        /// <param name="newObject">登録するオブジェクト</param>
+        /// <param name="typeID">生成時の型番号</param>
+        /// <returns>登録できたらtrue タグの型と合わずに破棄したらfalse</returns>
+        static bool EntryWithType(GameObject* newObject, int typeID);
+
+        /// <summary>
+        /// タグ配列内の2つのオブジェクトを入れ替えて、それぞれの位置を更新する
+        /// </summary>
+        /// <param name="array">タグ配列</param>
+        /// <param name="a">入れ替える位置</param>
+        /// <param name="b">入れ替える位置</param>
+        static void SwapAt(ArenaVector<GameObject*>& array, int a, int b);
+
+        /// <summary>
+        /// タグ配列からの取り外し（活動中と休眠中の並びを保ったまま末尾と入れ替えて詰める）
+        /// </summary>
+        /// <param name="tagIndex">タグの添字</param>
+        /// <param name="position">取り外す位置</param>
+        static void RemoveAt(int tagIndex, int position);
+
+        /// <summary>
+        /// 活動中のオブジェクトを休眠させる
+        /// </summary>
+        /// <param name="tagIndex">タグの添字</param>
+        /// <param name="position">休眠させるオブジェクトの位置</param>
+        static void SleepAt(int tagIndex, int position);
+
+        /// <summary>
+        /// 休眠中のオブジェクトを起こす
+        /// </summary>
+        /// <param name="tagIndex">タグの添字</param>
+        /// <param name="position">起こすオブジェクトの位置</param>
+        static void WakeAt(int tagIndex, int position);
+
+        /// <summary>
+        /// プレイヤーとの距離と速度による休眠・起床の切り替え
+        /// </summary>
+        /// <param name="center">基準の座標（プレイヤーの位置）</param>
+        static void UpdateActivity(const VECTOR& center);
+
+        /// <summary>
+        /// プレイヤーとの距離による更新間隔の切り替え
+        /// </summary>
+        /// <param name="center">基準の座標（プレイヤーの位置）</param>
+        static void UpdateLod(const VECTOR& center);
+
+        // 現在のシーンのアリーナ（プールのブロックの確保元）
+        class MemoryArena* sceneArena;
+
+        // 並列更新を行うか
+        bool isParallelUpdate;
+
+        // スレッドごとのモデル操作コマンドバッファ
+        vector<ModelCommandBuffer> commandBuffers;
+
+        // 登録・削除の排他用
+        mutex entryMutex;
+
+        // 並列更新でジョブ1つに割り当てるオブジェクト数
+        static constexpr int parallelGrainSize = 64;
+
+        /// <summary>
+        /// オブジェクト配列を分割して並列に処理し、記録したモデル操作を合流後に再生する
+        /// </summary>
+        /// <param name="objects">処理するオブジェクト配列</param>
+        /// <param name="objectNum">処理する数（先頭から）</param>
+        /// <param name="func">オブジェクトごとの処理</param>
+        template<class Func>
+        static void ParallelForObjects(const ArenaVector<GameObject*>& objects, int objectNum, Func func)
+        {
+            JobSystem::ParallelFor(objectNum, parallelGrainSize, [&](int begin, int end, int threadIndex)
+            {
+                // メインスレッドでしか呼べないモデル操作はスレッドごとのバッファに記録する
+                ModelCommandBuffer::SetRecording(&instance->commandBuffers[threadIndex]);
+
+                for (int i = begin; i < end; ++i)
+                {
+                    func(objects[i]);
+                }
+
+                ModelCommandBuffer::SetRecording(nullptr);
+            });
+
+            // 合流後にメインスレッドでまとめて再生
+            for (auto& buffer : instance->commandBuffers)
+            {
+                buffer.Execute();
+            }
+        }
+
+        /// <summary>
+        /// 活動中の型Tのオブジェクトの更新（型が確定しているため仮想呼び出しを経由しない）
+        /// </summary>
+        /// <param name="deltaTime">1フレームの経過時間</param>
+        template<class T>
+        static void UpdateObjects(float deltaTime)
+        {
+            auto update = [deltaTime](T* object)
+            {
+                // 当たり判定などで削除コマンドが積まれたものは、同期点で消えるまで更新しない
+                if (!object->GetAlive())
+                {
+                    return;
+                }
+
+                // 間引き中は飛ばし、更新するフレームで間引いた分の時間をまとめて進める
+                float updateTime = deltaTime;
+                if (ObjectTagTraits<T>::useLod && !EntityManager::IsLodTick(object->GetEntity(), deltaTime, instance->frameCount, updateTime))
+                {
+                    return;
+                }
+
+                object->T::Update(updateTime);
+            };
+
+            if (ObjectTagTraits<T>::isParallel && instance->isParallelUpdate)
+            {
+                ParallelForEach<T>(update);
+                return;
+            }
+
+            ForEach<T>(update);
+        }
+
+        /// <summary>
+        /// 型Tのオブジェクトの描画（型が確定しているため仮想呼び出しを経由しない）
+        /// </summary>
+        template<class T>
+        static void DrawObjects()
+        {
+            ForEachAll<T>([](T* object)
+            {
+                // 削除コマンドが積まれたものは描画しない
+                if (object->GetAlive() && object->GetVisible())
+                {
+                    object->T::Draw();
+                }
+            });
+        }
+
+        /// <summary>
+        /// 型の一覧の各型にタグの特性を登録する
+        /// </summary>
+        template<class... Types>
+        static void RegisterTypes(ObjectTypeList<Types...>)
+        {
+            const int expand[] = { 0, (RegisterTagTraits<Types>(), 0)... };
+            (void)expand;
+        }
+
+        /// <summary>
+        /// 型の一覧の順に、エンティティのシステムの前か後に更新する型のオブジェクトを更新する
+        /// </summary>
+        /// <param name="deltaTime">1フレームの経過時間</param>
+        /// <param name="isLate">システムの後に更新する型ならtrue</param>
+        template<class... Types>
+        static void UpdateTypes(ObjectTypeList<Types...>, float deltaTime, bool isLate)
+        {
+            const int expand[] = { 0, (ObjectTagTraits<Types>::isLateUpdate == isLate ? UpdateObjects<Types>(deltaTime) : void(), 0)... };
+            (void)expand;
+        }
+
+        /// <summary>
+        /// 型の一覧の順にオブジェクトを描画する
+        /// </summary>
+        template<class... Types>
+        static void DrawTypes(ObjectTypeList<Types...>)
+        {
+            const int expand[] = { 0, (DrawObjects<Types>(), 0)... };
+            (void)expand;
+        }
+
+        /// <summary>
+        /// 型の一覧に無いタグのオブジェクトの更新（仮想呼び出しで更新する）
+        /// </summary>
+        /// <param name="deltaTime">1フレームの経過時間</param>
+        static void UpdateUntypedObjects(float deltaTime);
+
+        /// <summary>
+        /// 型の一覧に無いタグのオブジェクトの描画（仮想呼び出しで描画する）
+        /// </summary>
+        static void DrawUntypedObjects();
 
     public:
         /// <summary>
-        /// CX^X̐
+        /// インスタンスの生成
         /// </summary>
         static void CreateInstance();
 
         /// <summary>
-        /// CX^X̍폜
+        /// インスタンスの削除
         /// </summary>
         static void DeleteInstance();
 
         /// <summary>
-        /// Q[IuWFNg}l[W̍XV
+        /// ゲームオブジェクトマネージャの更新
         /// </summary>
-        /// <param name="deltaTime">1t[̌oߎ</param>
+        /// <param name="deltaTime">1フレームの経過時間</param>
         static void Update(float deltaTime);
 
         /// <summary>
-        /// Q[IuWFNg}l[W̕`
+        /// ゲームオブジェクトマネージャの描画
         /// </summary>
         static void Draw();
 
         /// <summary>
-        /// IuWFNg̓o^
+        /// オブジェクトの登録（生成コマンドとして保留し、Updateの同期点で実行オブジェクトに加える）
+        /// 型の一覧にあるタグには、そのタグ特性の型のオブジェクトしか登録できない（違う型は登録せずに破棄する）
         /// </summary>
-        /// <param name="newObject">o^IuWFNg</param>
+        /// <param name="newObject">登録するオブジェクト</param>
         static void Entry(GameObject* newObject);
 
         /// <summary>
-        /// IuWFNg̍폜
+        /// オブジェクトを型ごとのプールから生成して登録
+        /// ワーカースレッドからも呼べる（エンティティはUpdateの同期点で作られるので、それまでGetEntityは無効）
         /// </summary>
-        /// <param name="releaseObject">폜IuWFNg
+        /// <param name="args">コンストラクタに渡す引数</param>
+        /// <returns>生成したオブジェクト、タグの型と合わなければnullptr</returns>
+        template<class T, class... Args>
+        static T* Entry(Args&&... args)
+        {
+            lock_guard<mutex> lock(instance->entryMutex);
+
+            ObjectPool* pool = GetPool(PoolTypeID<T>(), sizeof(T));
+
+            T* newObject = new(pool->Allocate()) T(std::forward<Args>(args)...);
+            newObject->pool = pool;
+
+            if (!EntryWithType(newObject, PoolTypeID<T>()))
+            {
+                return nullptr;
+            }
+            return newObject;
+        }
+
+        /// <summary>
+        /// オブジェクトの削除（削除コマンドを積み、Updateの同期点で実際に削除する）
+        /// </summary>
+        /// <param name="releaseObject">削除するオブジェクト
         /// </param>
         static void Release(GameObject* releaseObject);
 
         /// <summary>
-        /// SIuWFNg폜
+        /// 全オブジェクト削除（デストラクタだけ呼び、スロット・ハンドル・エンティティはまとめて解放する）
         /// </summary>
         static void ReleaseAllObject();
 
         /// <summary>
-        /// 蔻
+        /// シーンのアリーナの設定（オブジェクトが残っていないときに呼ぶ）
+        /// 以降プールのブロック、タグごとの配列、当たり判定の作業用の配列、接触状態、ブロードフェーズ、エンティティのチャンクはアリーナから確保され、
+        /// シーンの破棄でまとめて解放される
+        /// </summary>
+        /// <param name="arena">シーンのアリーナ（nullptrならヒープ）</param>
+        static void SetSceneArena(class MemoryArena* arena);
+
+        /// <summary>
+        /// シーンのアリーナの取得
+        /// </summary>
+        /// <returns>現在のシーンのアリーナ、無ければnullptr</returns>
+        static class MemoryArena* GetSceneArena() { return instance->sceneArena; }
+
+        /// <summary>
+        /// 当たり判定（境界箱が重なる組み合わせだけを判定し、メッシュとの組み合わせから先に接触の変化に応じた処理を呼ぶ）
         /// </summary>
         static void Collision();
 
         /// <summary>
-        /// IuWFNg^O̍ŏGameObjectԂ
+        /// 当たりを取る組み合わせの表の設定（シーンの開始時に呼ぶ、次の当たり判定から使われる）
+        /// 表で対象にしていない組み合わせはブロードフェーズが返さないので判定の手間がかからない
+        /// </summary>
+        /// <param name="matrix">タグごとに当たりを取りたい相手のタグの表</param>
+        static void SetCollisionMatrix(const CollisionMatrix& matrix) { instance->collisionMatrix = matrix; }
+
+        /// <summary>
+        /// 当たりを取る組み合わせの表の取得
+        /// </summary>
+        /// <returns>現在の表</returns>
+        static const CollisionMatrix& GetCollisionMatrix() { return instance->collisionMatrix; }
+
+        /// <summary>
+        /// ブロードフェーズの実装の切り替え（登録は次の当たり判定で作り直される）
+        /// </summary>
+        /// <param name="type">ブロードフェーズの実装の種類</param>
+        static void SetBroadphase(BroadphaseType type);
+
+        /// <summary>
+        /// ブロードフェーズの実装の種類の取得
+        /// </summary>
+        /// <returns>現在のブロードフェーズの実装の種類</returns>
+        static BroadphaseType GetBroadphaseType() { return instance->broadphaseType; }
+
+        /// <summary>
+        /// 範囲と境界箱が重なるオブジェクトの検索（直前の当たり判定時点の境界箱で調べる）
+        /// </summary>
+        /// <param name="box">調べる範囲</param>
+        /// <param name="tagMask">対象にするタグのビット</param>
+        /// <param name="results">見つかったオブジェクト（呼び出し側の配列に追加する）</param>
+        static void QueryOverlap(const AABB& box, unsigned int tagMask, vector<GameObject*>& results);
+
+        /// <summary>
+        /// 線分と境界箱が交差するオブジェクトの検索（直前の当たり判定時点の境界箱で調べる）
+        /// </summary>
+        /// <param name="start">線分の始点</param>
+        /// <param name="end">線分の終点</param>
+        /// <param name="tagMask">対象にするタグのビット</param>
+        /// <param name="results">見つかったオブジェクト（始点に近い順に、呼び出し側の配列に追加する）</param>
+        static void Raycast(const VECTOR& start, const VECTOR& end, unsigned int tagMask, vector<GameObject*>& results);
+
+        /// <summary>
+        /// 活動中の型Tのオブジェクトすべてに対する処理
+        /// 更新中に登録されたオブジェクトは保留に積まれるため対象にならない
+        /// </summary>
+        /// <param name="func">オブジェクトごとの処理 void(T*)</param>
+        template<class T, class Func>
+        static void ForEach(Func func)
+        {
+            // 型が確定していれば呼び出しをコンパイル時に解決できる
+            static_assert(is_final<T>::value, "ForEach target must be a final class");
+
+            for (int tagIndex = 0; tagIndex < ObjectTagNum; ++tagIndex)
+            {
+                if (!(ObjectTagTraits<T>::tagMask & (1u << tagIndex)))
+                {
+                    continue;
+                }
+
+                const ArenaVector<GameObject*>& objects = instance->objects[tagIndex];
+                const int objectNum = instance->activeNum[tagIndex];
+
+                for (int i = 0; i < objectNum; ++i)
+                {
+                    func(static_cast<T*>(objects[i]));
+                }
+            }
+        }
+
+        /// <summary>
+        /// 休眠中も含めた型Tのオブジェクトすべてに対する処理
+        /// </summary>
+        /// <param name="func">オブジェクトごとの処理 void(T*)</param>
+        template<class T, class Func>
+        static void ForEachAll(Func func)
+        {
+            static_assert(is_final<T>::value, "ForEachAll target must be a final class");
+
+            for (int tagIndex = 0; tagIndex < ObjectTagNum; ++tagIndex)
+            {
+                if (!(ObjectTagTraits<T>::tagMask & (1u << tagIndex)))
+                {
+                    continue;
+                }
+
+                const ArenaVector<GameObject*>& objects = instance->objects[tagIndex];
+                const int objectNum = static_cast<int>(objects.size());
+
+                for (int i = 0; i < objectNum; ++i)
+                {
+                    func(static_cast<T*>(objects[i]));
+                }
+            }
+        }
+
+        /// <summary>
+        /// 活動中の型Aと、休眠中も含めた型Bのオブジェクトのすべての組み合わせに対する処理
+        /// （休眠中のオブジェクトは動かないので、動く側にはならないが相手にはなる）
+        /// </summary>
+        /// <param name="func">組み合わせごとの処理 void(A*, B*)</param>
+        template<class A, class B, class Func>
+        static void ForEachPair(Func func)
+        {
+            ForEach<A>([&func](A* a)
+            {
+                ForEachAll<B>([&func, a](B* b)
+                {
+                    func(a, b);
+                });
+            });
+        }
+
+        /// <summary>
+        /// 活動中の型Tのオブジェクトすべてに対する処理をワーカースレッドに分けて行う
+        /// 処理中のモデル操作は記録され、合流後にメインスレッドで再生される
+        /// </summary>
+        /// <param name="func">オブジェクトごとの処理 void(T*)</param>
+        template<class T, class Func>
+        static void ParallelForEach(Func func)
+        {
+            static_assert(is_final<T>::value, "ParallelForEach target must be a final class");
+
+            for (int tagIndex = 0; tagIndex < ObjectTagNum; ++tagIndex)
+            {
+                if (!(ObjectTagTraits<T>::tagMask & (1u << tagIndex)))
+                {
+                    continue;
+                }
+
+                ParallelForObjects(instance->objects[tagIndex], instance->activeNum[tagIndex], [&func](GameObject* object)
+                {
+                    func(static_cast<T*>(object));
+                });
+            }
+        }
+
+        /// <summary>
+        /// 休眠中のオブジェクトを起こす（攻撃を受けたときなど、距離によらず起こしたいときに呼ぶ）
+        /// </summary>
+        /// <param name="handle">起こすオブジェクトのハンドル</param>
+        static void Wake(GameObjectHandle handle);
+
+        /// <summary>
+        /// オブジェクトが休眠中かどうか
+        /// </summary>
+        /// <param name="handle">調べるオブジェクトのハンドル</param>
+        /// <returns>休眠中ならtrue 活動中や削除済みならfalse</returns>
+        static bool IsDormant(GameObjectHandle handle);
+
+        /// <summary>
+        /// 並列更新の切り替え
+        /// </summary>
+        /// <param name="set">並列に更新するならtrue</param>
+        static void SetParallelUpdate(bool set) { instance->isParallelUpdate = set; }
+
+        /// <summary>
+        /// ハンドルの指すオブジェクトが生きているかどうか
+        /// </summary>
+        /// <param name="handle">調べるハンドル</param>
+        /// <returns>生きていればtrue 削除済みや無効ならfalse</returns>
+        static bool IsAlive(GameObjectHandle handle);
+
+        /// <summary>
+        /// ハンドルからオブジェクトの取得
+        /// </summary>
+        /// <param name="handle">オブジェクトのハンドル</param>
+        /// <returns>オブジェクト、削除済みならnullptr</returns>
+        static GameObject* Get(GameObjectHandle handle);
+
+        /// <summary>
+        /// ハンドルから型つきでオブジェクトの取得
+        /// </summary>
+        /// <param name="handle">オブジェクトのハンドル</param>
+        /// <returns>オブジェクト、削除済みや型違いならnullptr</returns>
+        template<class T>
+        static T* Get(GameObjectHandle handle)
+        {
+            if (!IsAlive(handle))
+            {
+                return nullptr;
+            }
+
+            const HandleSlot& slot = instance->handleSlots[handle.index];
+
+            // プールから生成したときの型と一致すればキャストだけで済む
+            if (slot.typeID == PoolTypeID<T>())
+            {
+                return static_cast<T*>(slot.object);
+            }
+            return dynamic_cast<T*>(slot.object);
+        }
+
+        /// <summary>
+        /// オブジェクトタグ種の最初の活動中のハンドルを返す
+        /// </summary>
+        /// <param name="tag">オブジェクトのタグ</param>
+        /// <returns>最初の活動中のオブジェクトのハンドル、いなければ無効ハンドル</returns>
+        static GameObjectHandle GetFirstHandle(ObjectTag tag);
+
+        /// <summary>
+        /// オブジェクトタグ種の最初の活動中のGameObjectを返す（休眠中のものは返さない）
         /// </summary>
         /// <param name="tag"></param>
         /// <returns></returns>
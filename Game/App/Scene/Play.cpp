@@ -13,18 +13,44 @@ namespace My3dApp
     {
         text = "3.Play";
 
-        GameObjectManager::Entry(new Player());
+        // オブジェクトはシーンのアリーナから確保し、シーンを抜けるときにまとめて解放する
+        GameObjectManager::SetSceneArena(&arena);
 
-        GameObjectManager::Entry(new Camera(750, -750));
+        // エネミーや弾はワーカースレッドに分けて更新する
+        GameObjectManager::SetParallelUpdate(true);
 
-        GameObjectManager::Entry(new Map(VGet(0, -255, 0)));
+        // このシーンで当たりを取る組み合わせ（弾は撃った側と同じ陣営には当たらない）
+        CollisionMatrix collisionMatrix;
+        collisionMatrix.Enable(ObjectTag::Player, ObjectTag::Map)
+            .Enable(ObjectTag::Player, ObjectTag::Enemy)
+            .Enable(ObjectTag::Enemy, ObjectTag::Map)
+            .Enable(ObjectTag::PlayerBullet, ObjectTag::Map)
+            .Enable(ObjectTag::EnemyBullet, ObjectTag::Map)
+            .EnableBoth(ObjectTag::PlayerBullet, ObjectTag::Enemy)
+            .EnableBoth(ObjectTag::EnemyBullet, ObjectTag::Player);
+        GameObjectManager::SetCollisionMatrix(collisionMatrix);
 
-        //GameObjectManager::Entry(new Enemy(VGet(0, 0, 0)));
+        // レベル全体を覆うマップと小さな敵・弾が混ざるので、大きさの差に強い木をブロードフェーズに使う
+        GameObjectManager::SetBroadphase(BroadphaseType::AABBTree);
+
+        GameObjectManager::Entry<Player>();
+
+        GameObjectManager::Entry<Camera>(750.0f, -750.0f);
+
+        GameObjectManager::Entry<Map>(VGet(0, -255, 0));
+
+        //GameObjectManager::Entry<Enemy>(VGet(0, 0, 0));
     }
 
     Play::~Play()
     {
         GameObjectManager::ReleaseAllObject();
+
+        // 次のシーンがアリーナを設定済みでなければヒープに戻す
+        if (GameObjectManager::GetSceneArena() == &arena)
+        {
+            GameObjectManager::SetSceneArena(nullptr);
+        }
     }
 
     SceneBase* Play::Update(float deltaTime)
@@ -5,30 +5,30 @@
 namespace My3dApp
 {
     /// <summary>
-    /// vCV[ihNXApFV[x[Xj
+    /// プレイシーン（派生クラス、継承元：シーンベース）
     /// </summary>
     class Play : public SceneBase
     {
     public:
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
         Play();
 
         /// <summary>
-        /// fXgN^
+        /// デストラクタ
         /// </summary>
         ~Play();
 
         /// <summary>
-        /// vCV[̍XV
+        /// プレイシーンの更新
         /// </summary>
-        /// <param name="deltaTime">1t[̌oߎ</param>
-        /// <returns>݂̃V[A܂͑Jڗ\̃V[</returns>
+        /// <param name="deltaTime">1フレームの経過時間</param>
+        /// <returns>現在のシーン、または遷移予定のシーン</returns>
         SceneBase* Update(float deltaTime) override;
 
         /// <summary>
-        /// vCV[̕`
+        /// プレイシーンの描画
         /// </summary>
         void Draw() override;
 
@@ -10,7 +10,7 @@ namespace My3dApp
 
     Result::~Result()
     {
-        // Ȃ
+        // 処理なし
     }
 
     SceneBase* Result::Update(float deltaTime)
@@ -5,30 +5,30 @@
 namespace My3dApp
 {
     /// <summary>
-    /// UgV[ihNXApFV[x[Xj
+    /// リザルトシーン（派生クラス、継承元：シーンベース）
     /// </summary>
     class Result : public SceneBase
     {
     public:
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
         Result();
 
         /// <summary>
-        /// fXgN^
+        /// デストラクタ
         /// </summary>
         ~Result();
 
         /// <summary>
-        /// UgV[̍XV
+        /// リザルトシーンの更新
         /// </summary>
-        /// <param name="deltaTime">1t[̌oߎ</param>
-        /// <returns>݂̃V[A܂͑Jڗ\̃V[</returns>
+        /// <param name="deltaTime">1フレームの経過時間</param>
+        /// <returns>現在のシーン、または遷移予定のシーン</returns>
         SceneBase* Update(float deltaTime) override;
 
         /// <summary>
-        /// UgV[̕`
+        /// リザルトシーンの描画
         /// </summary>
         void Draw() override;
 
@@ -9,13 +9,14 @@ namespace My3dApp
 {
     SceneBase::SceneBase()
         : text(nullptr)
+        , arena()
     {
-        // Ȃ
+        // 処理なし
     }
 
     SceneBase::~SceneBase()
     {
-        // Ȃ
+        // 処理なし
     }
 
     SceneBase* SceneBase::CheckRetScene(int sceneNum)
@@ -1,51 +1,56 @@
 #pragma once
 
+#include "../Library/MemoryArena.h"
+
 namespace My3dApp
 {
     /// <summary>
-    /// V[x[XiNXj
+    /// シーンベース（基底クラス）
     /// </summary>
     class SceneBase
     {
     protected:
-        // V[\p
+        // シーン表示用
         const char* text;
 
+        // シーン内で使う領域（オブジェクトのプールや作業用の配列、シーンの破棄でまとめて解放する）
+        MemoryArena arena;
+
     public:
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
         SceneBase();
 
         /// <summary>
-        /// zfXgN^
+        /// 仮想デストラクタ
         /// </summary>
         virtual ~SceneBase();
 
         /// <summary>
-        /// V[x[X̍XViz֐j
+        /// シーンベースの更新（純粋仮想関数）
         /// </summary>
-        /// <param name="deltaTime">1t[̌oߎ</param>
-        /// <returns>݂̃V[A܂͑Jڗ\̃V[</returns>
+        /// <param name="deltaTime">1フレームの経過時間</param>
+        /// <returns>現在のシーン、または遷移予定のシーン</returns>
         virtual SceneBase* Update(float deltaTime) = 0;
 
         /// <summary>
-        /// V[̕`iz֐j
+        /// シーンの描画（純粋仮想関数）
         /// </summary>
         virtual void Draw() = 0;
 
         /// <summary>
-        /// V[؂ւ̓
+        /// シーン切り替えの入力
         /// </summary>
-        /// <param name="sceneNum">JڂV[</param>
+        /// <param name="sceneNum">遷移したいシーン</param>
         /// <returns></returns>
         SceneBase* CheckRetScene(int sceneNum);
 
         
-        // ȉfobOp֐
+        // 以下デバッグ用関数
 
         /// <summary>
-        /// ݂̃V[̊mFp
+        /// 現在のシーンの確認用
         /// </summary>
         void CheckNowScene();
 
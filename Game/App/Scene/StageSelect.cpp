@@ -10,7 +10,7 @@ namespace My3dApp
 
     StageSelect::~StageSelect()
     {
-        // Ȃ
+        // 処理なし
     }
 
     SceneBase* StageSelect::Update(float deltaTime)
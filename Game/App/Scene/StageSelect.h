@@ -5,32 +5,32 @@
 namespace My3dApp
 {
     /// <summary>
-    /// Xe[WZNgV[ihNXApFV[x[Xj
+    /// ステージセレクトシーン（派生クラス、継承元：シーンベース）
     /// </summary>
     class StageSelect : public SceneBase
     {
     public:
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
         StageSelect();
 
         /// <summary>
-        /// fXgN^
+        /// デストラクタ
         /// </summary>
         ~StageSelect();
 
-        /** Xe[WZNg̍XV*/
+        /** ステージセレクトの更新*/
 
         /// <summary>
-        /// Xe[WZNgV[̍XV
+        /// ステージセレクトシーンの更新
         /// </summary>
-        /// <param name="deltaTime">1t[̌oߎ</param>
-        /// <returns>݂̃V[A܂͑Jڗ\̃V[</returns>
+        /// <param name="deltaTime">1フレームの経過時間</param>
+        /// <returns>現在のシーン、または遷移予定のシーン</returns>
         SceneBase* Update(float deltaTime) override;
 
         /// <summary>
-        /// Xe[WZNgV[̕`
+        /// ステージセレクトシーンの描画
         /// </summary>
         void Draw() override;
 
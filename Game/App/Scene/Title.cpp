@@ -10,7 +10,7 @@ namespace My3dApp
 
     Title::~Title()
     {
-        // Ȃ
+        // 処理なし
     }
 
     SceneBase* Title::Update(float deltaTime)
@@ -5,30 +5,30 @@
 namespace My3dApp
 {
     /// <summary>
-    /// ^CgV[ihNXApFV[x[Xj
+    /// タイトルシーン（派生クラス、継承元：シーンベース）
     /// </summary>
     class Title : public SceneBase
     {
     public:
         /// <summary>
-        /// RXgN^
+        /// コンストラクタ
         /// </summary>
         Title();
 
         /// <summary>
-        /// fXgN^
+        /// デストラクタ
         /// </summary>
         ~Title();
 
         /// <summary>
-        /// ^CgV[̍XV
+        /// タイトルシーンの更新
         /// </summary>
-        /// <param name="deltaTime">1t[̌oߎ</param>
-        /// <returns>݂̃V[A܂͑Jڗ\̃V[</returns>
+        /// <param name="deltaTime">1フレームの経過時間</param>
+        /// <returns>現在のシーン、または遷移予定のシーン</returns>
         SceneBase* Update(float deltaTime) override;
 
         /// <summary>
-        /// ^CgV[̕`
+        /// タイトルシーンの描画
         /// </summary>
         void Draw() override;
 
@@ -4,40 +4,54 @@
 #include "Manager/AssetManager.h"
 #include "Manager/GameManager.h"
 #include "Manager/GameObjectManager.h"
+#include "Manager/EntityManager.h"
 #include "Library/GamePad.h"
+#include "Library/JobSystem.h"
 #include "Scene/Title.h"
 #include "Scene/Play.h"
 
 int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int)
 {
-    // AZbg}l[W̐
+    // アセットマネージャの生成
     My3dApp::AssetManager::CreateInstance();
 
-    // Q[}l[W̐
+    // ゲームマネージャの生成
     My3dApp::GameManager::CreateInstance();
 
-    // Q[IuWFNg}l[W̐
+    // ジョブシステムの生成
+    My3dApp::JobSystem::CreateInstance();
+
+    // エンティティマネージャの生成
+    My3dApp::EntityManager::CreateInstance();
+
+    // ゲームオブジェクトマネージャの生成
     My3dApp::GameObjectManager::CreateInstance();
 
-    // Q[pbh̐
+    // ゲームパッドの生成
     My3dApp::GamePad::CreateInstance();
 
-    // ŏ̃V[Zbg
+    // 最初のシーンをセット
     My3dApp::GameManager::SetFirstScene(new My3dApp::Play());
 
-    // Q[[v
+    // ゲームループ
     My3dApp::GameManager::Loop();
 
-    // Q[pbh̍폜
+    // ゲームパッドの削除
     My3dApp::GamePad::DeleteInstance();
 
-    // Q[IuWFNg}l[W̍폜
+    // ゲームオブジェクトマネージャの削除
     My3dApp::GameObjectManager::DeleteInstance();
 
-    // Q[}l[W̍폜
+    // エンティティマネージャの削除（オブジェクトが持つエンティティより後に消す）
+    My3dApp::EntityManager::DeleteInstance();
+
+    // ジョブシステムの削除
+    My3dApp::JobSystem::DeleteInstance();
+
+    // ゲームマネージャの削除
     My3dApp::GameManager::DeleteInstance();
 
-    // AZbg}l[W̍폜
+    // アセットマネージャの削除
     My3dApp::AssetManager::DeleteInstance();
 
     return 0;
@@ -0,0 +1,74 @@
+#pragma warning(disable:28251)
+#include <windows.h>
+#include <cstdio>
+#include <cstdlib>
+#include "DxLib.h"
+#include "../../App/Library/TriangleBVH.h"
+#include "../../App/Library/HeightField.h"
+#include "../../App/Library/CollisionMeshFile.h"
+
+// 当たり判定メッシュの調理ツール
+// モデル（.mv1 / .fbx）の三角形からBVHと地面の高さの格子を作り、ゲームが割り当ててそのまま使えるファイルに書き出す
+// 使い方：CollisionCooker 入力モデル 出力ファイル [セル1辺の長さ]
+// 例：CollisionCooker ../Assets/Model/Map/map.mv1 ../Assets/Model/Map/map.mcol
+// モデルを作り直したときは調理し直す（古いファイルはそのまま読み込まれる）
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        printf("usage: CollisionCooker <input.mv1|.fbx> <output.mcol> [cellSize]\n");
+        return 1;
+    }
+
+    // 地面の高さの格子のセル1辺の長さ（マップが実行時に作る場合と同じ値）
+    const float cellSize = 4 <= argc ? static_cast<float>(atof(argv[3])) : 25.0f;
+    if (cellSize <= 0.0f)
+    {
+        printf("invalid cell size: %s\n", argv[3]);
+        return 1;
+    }
+
+    // モデルを読み込むためだけに初期化する（ウインドウは出さない）
+    SetOutApplicationLogValidFlag(FALSE);
+    ChangeWindowMode(TRUE);
+    SetWindowVisibleFlag(FALSE);
+
+    if (DxLib_Init() == -1)
+    {
+        printf("DxLib_Init failed\n");
+        return 1;
+    }
+
+    const int modelHandle = MV1LoadModel(argv[1]);
+    if (modelHandle == -1)
+    {
+        printf("failed to load model: %s\n", argv[1]);
+        DxLib_End();
+        return 1;
+    }
+
+    // ゲームと同じく、原点に等倍で置いたローカル座標で作る
+    MV1SetScale(modelHandle, VGet(1.0f, 1.0f, 1.0f));
+    MV1SetPosition(modelHandle, VGet(0.0f, 0.0f, 0.0f));
+
+    My3dApp::TriangleBVH bvh;
+    bvh.BuildFromModel(modelHandle);
+    MV1DeleteModel(modelHandle);
+
+    My3dApp::HeightField heightField;
+    heightField.Build(bvh, cellSize);
+
+    DxLib_End();
+
+    if (!My3dApp::CollisionMeshFile::Write(argv[2], bvh, heightField))
+    {
+        printf("failed to write: %s\n", argv[2]);
+        return 1;
+    }
+
+    printf("%s -> %s\n", argv[1], argv[2]);
+    printf("  triangles %d, nodes %d, packets %d\n", bvh.GetTriangleNum(), bvh.GetNodeNum(), bvh.GetPacketNum());
+    printf("  heightfield %d x %d cells (%d fall back to the mesh)\n", heightField.GetCellNumX(), heightField.GetCellNumZ(), heightField.GetFallbackCellNum());
+
+    return 0;
+}
\ No newline at end of file